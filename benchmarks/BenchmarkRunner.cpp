@@ -0,0 +1,174 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "BenchmarkRunner.h"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <ctime>
+
+#include "SDL.h"
+
+#include "AllocationTracker.h"
+
+namespace {
+  /// <summary>
+  /// The most that calibration multiplies the number of operations by between attempts.
+  /// </summary>
+  const double kMaxCalibrationGrowth = 100.0;
+
+  /// <summary>
+  /// Receives results passed to KeepResult. Writing to a volatile cannot be optimised away.
+  /// </summary>
+  volatile std::uint64_t result_sink = 0;
+
+  /// <summary>
+  /// Describes the compiler that built the benchmarks, so results from different toolchains are not compared.
+  /// </summary>
+  /// <returns>The name and version of the compiler.</returns>
+  std::string CompilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+    return "unknown";
+#endif
+  }
+}
+
+BenchmarkRunner::BenchmarkRunner(double min_millis, unsigned int repetitions, const std::string& filter)
+    : min_millis_(min_millis),
+      repetitions_(std::max(repetitions, 1u)),
+      filter_(filter) {}
+
+void BenchmarkRunner::Run(const std::string& name, const std::string& kind, const Body& body) {
+  if (!Selected(name)) {
+    return;
+  }
+
+  const double nanos_per_tick = 1000000000.0 / SDL_GetPerformanceFrequency();
+  std::uint64_t operations = 1;
+
+  // Grows the number of operations until a repetition takes at least the minimum time. Also warms caches.
+  while (true) {
+    const std::uint64_t start_counter = SDL_GetPerformanceCounter();
+    body(operations);
+    const double elapsed_millis = (SDL_GetPerformanceCounter() - start_counter) * nanos_per_tick / 1000000.0;
+
+    if (elapsed_millis >= min_millis_) {
+      break;
+    }
+
+    const double growth = elapsed_millis > 0 ? min_millis_ / elapsed_millis * 1.2 : kMaxCalibrationGrowth;
+    operations = static_cast<std::uint64_t>(operations * std::min(std::max(growth, 2.0), kMaxCalibrationGrowth));
+  }
+
+  Measure(name, kind, body, operations);
+}
+
+void BenchmarkRunner::RunFixed(const std::string& name, const std::string& kind, const Body& body,
+                               std::uint64_t operations) {
+  if (!Selected(name)) {
+    return;
+  }
+
+  // A single untimed repetition warms caches.
+  body(operations);
+
+  Measure(name, kind, body, operations);
+}
+
+bool BenchmarkRunner::Selected(const std::string& name) const {
+  return filter_.empty() || name.find(filter_) != std::string::npos;
+}
+
+void BenchmarkRunner::Measure(const std::string& name, const std::string& kind, const Body& body,
+                              std::uint64_t operations) {
+  const double nanos_per_tick = 1000000000.0 / SDL_GetPerformanceFrequency();
+  std::vector<double> nanos_per_operation;
+  std::uint64_t allocations = 0;
+
+  nanos_per_operation.reserve(repetitions_);
+
+  for (unsigned int i = 0; i < repetitions_; i++) {
+    const std::uint64_t start_allocations = AllocationTracker::allocation_count();
+    const std::uint64_t start_counter = SDL_GetPerformanceCounter();
+
+    body(operations);
+
+    const std::uint64_t end_counter = SDL_GetPerformanceCounter();
+    allocations += AllocationTracker::allocation_count() - start_allocations;
+    nanos_per_operation.push_back((end_counter - start_counter) * nanos_per_tick / operations);
+  }
+
+  std::sort(nanos_per_operation.begin(), nanos_per_operation.end());
+
+  const Result result {
+    name,
+    kind,
+    operations,
+    repetitions_,
+    nanos_per_operation[nanos_per_operation.size() / 2],
+    nanos_per_operation.front(),
+    nanos_per_operation.back(),
+    static_cast<double>(allocations) / (static_cast<double>(operations) * repetitions_)
+  };
+
+  std::cerr << std::left << std::setw(44) << name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(14) << result.median_nanos_ << " ns/op" << std::setw(10) << result.allocations_
+            << " allocs/op  (" << operations << " ops x " << repetitions_ << ")" << std::endl;
+
+  results_.push_back(result);
+}
+
+void BenchmarkRunner::WriteJson(std::ostream& stream) const {
+  char date[32] = "";
+  const std::time_t now = std::time(nullptr);
+
+  if (const std::tm* utc = std::gmtime(&now)) {
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", utc);
+  }
+
+#ifdef NDEBUG
+  const char* build_type = "release";
+#else
+  const char* build_type = "debug";
+#endif
+
+  // Names are written without escaping, as every benchmark name is a plain identifier path.
+  stream << std::fixed << std::setprecision(3)
+         << "{\n  \"context\": {\n"
+         << "    \"date\": \"" << date << "\",\n"
+         << "    \"compiler\": \"" << CompilerName() << "\",\n"
+         << "    \"build_type\": \"" << build_type << "\",\n"
+         << "    \"min_time_ms\": " << min_millis_ << ",\n"
+         << "    \"repetitions\": " << repetitions_ << "\n"
+         << "  },\n  \"benchmarks\": [";
+
+  for (size_t i = 0; i < results_.size(); i++) {
+    const Result& result = results_[i];
+
+    stream << (i == 0 ? "\n" : ",\n")
+           << "    {\"name\": \"" << result.name_ << "\", \"kind\": \"" << result.kind_
+           << "\", \"operations\": " << result.operations_ << ", \"repetitions\": " << result.repetitions_
+           << ", \"median_ns\": " << result.median_nanos_ << ", \"min_ns\": " << result.min_nanos_
+           << ", \"max_ns\": " << result.max_nanos_ << ", \"allocations_per_op\": " << result.allocations_ << "}";
+  }
+
+  stream << "\n  ]\n}\n";
+}
+
+const std::vector<BenchmarkRunner::Result>& BenchmarkRunner::results() const {
+  return results_;
+}
+
+void BenchmarkRunner::KeepResult(std::uint64_t value) {
+  result_sink = result_sink + value;
+}
\ No newline at end of file
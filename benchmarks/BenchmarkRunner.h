@@ -0,0 +1,139 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <functional>
+#include <cstdint>
+
+/// <summary>
+/// Times benchmarks and writes their results as JSON.
+/// Each benchmark is a function that performs a given number of operations. The runner calibrates the
+/// number of operations to fill a minimum time, then times several repetitions of that many operations,
+/// counting the heap allocations made by each.
+/// </summary>
+class BenchmarkRunner {
+ public:
+  /// <summary>
+  /// The timings of a benchmark.
+  /// </summary>
+  struct Result {
+    /// <summary>
+    /// The name of the benchmark, in the form "subsystem/operation".
+    /// </summary>
+    std::string name_;
+    /// <summary>
+    /// "micro" for a single function, "macro" for a whole frame or game, or "replay" for a recorded game.
+    /// </summary>
+    std::string kind_;
+    /// <summary>
+    /// The number of operations in each repetition.
+    /// </summary>
+    std::uint64_t operations_;
+    /// <summary>
+    /// The number of timed repetitions.
+    /// </summary>
+    unsigned int repetitions_;
+    /// <summary>
+    /// The median time per operation across the repetitions, in nanoseconds.
+    /// </summary>
+    double median_nanos_;
+    /// <summary>
+    /// The fastest time per operation across the repetitions, in nanoseconds.
+    /// </summary>
+    double min_nanos_;
+    /// <summary>
+    /// The slowest time per operation across the repetitions, in nanoseconds.
+    /// </summary>
+    double max_nanos_;
+    /// <summary>
+    /// The mean number of heap allocations per operation.
+    /// </summary>
+    double allocations_;
+  };
+  /// <summary>
+  /// A benchmark body. Performs the given number of operations. Called once per repetition,
+  /// so the cost of the call itself is not part of the timing of each operation.
+  /// </summary>
+  typedef std::function<void(std::uint64_t operations)> Body;
+  /// <summary>
+  /// Constructor for the BenchmarkRunner class.
+  /// </summary>
+  /// <param name="min_millis">The minimum time that each repetition of a calibrated benchmark runs for.</param>
+  /// <param name="repetitions">The number of timed repetitions of each benchmark.</param>
+  /// <param name="filter">Only benchmarks whose names contain the filter are run. Empty to run every benchmark.</param>
+  BenchmarkRunner(double min_millis, unsigned int repetitions, const std::string& filter);
+  /// <summary>
+  /// Runs a benchmark, calibrating the number of operations to fill the minimum time.
+  /// Prints a summary line to the standard error stream.
+  /// </summary>
+  /// <param name="name">The name of the benchmark.</param>
+  /// <param name="kind">"micro", "macro" or "replay".</param>
+  /// <param name="body">Performs the operations.</param>
+  void Run(const std::string& name, const std::string& kind, const Body& body);
+  /// <summary>
+  /// Runs a benchmark with a fixed number of operations per repetition, such as one per tile pair.
+  /// Prints a summary line to the standard error stream.
+  /// </summary>
+  /// <param name="name">The name of the benchmark.</param>
+  /// <param name="kind">"micro", "macro" or "replay".</param>
+  /// <param name="body">Performs the operations.</param>
+  /// <param name="operations">The number of operations in each repetition.</param>
+  void RunFixed(const std::string& name, const std::string& kind, const Body& body, std::uint64_t operations);
+  /// <summary>
+  /// Determines whether a benchmark passes the filter.
+  /// </summary>
+  /// <param name="name">The name of the benchmark.</param>
+  /// <returns>True if the benchmark should be run, else false.</returns>
+  bool Selected(const std::string& name) const;
+  /// <summary>
+  /// Writes the results of every benchmark run so far as a JSON document.
+  /// </summary>
+  /// <param name="stream">The stream to write to.</param>
+  void WriteJson(std::ostream& stream) const;
+  /// <summary>
+  /// Gets the results of every benchmark run so far.
+  /// </summary>
+  /// <returns>The results, in the order that the benchmarks were run.</returns>
+  const std::vector<Result>& results(void) const;
+  /// <summary>
+  /// Prevents the compiler from removing a computation whose result is otherwise unused.
+  /// </summary>
+  /// <param name="value">The result to keep.</param>
+  static void KeepResult(std::uint64_t value);
+
+ private:
+  /// <summary>
+  /// Copy constructor for the BenchmarkRunner class.
+  /// </summary>
+  /// <param name="reference">The BenchmarkRunner reference to copy.</param>
+  BenchmarkRunner(BenchmarkRunner const& reference);
+  /// <summary>
+  /// Times the repetitions of a benchmark and records the result.
+  /// </summary>
+  /// <param name="name">The name of the benchmark.</param>
+  /// <param name="kind">"micro", "macro" or "replay".</param>
+  /// <param name="body">Performs the operations.</param>
+  /// <param name="operations">The number of operations in each repetition.</param>
+  void Measure(const std::string& name, const std::string& kind, const Body& body, std::uint64_t operations);
+  /// <summary>
+  /// The minimum time that each repetition of a calibrated benchmark runs for, in milliseconds.
+  /// </summary>
+  const double min_millis_;
+  /// <summary>
+  /// The number of timed repetitions of each benchmark.
+  /// </summary>
+  const unsigned int repetitions_;
+  /// <summary>
+  /// Only benchmarks whose names contain the filter are run.
+  /// </summary>
+  const std::string filter_;
+  /// <summary>
+  /// The results of every benchmark run so far.
+  /// </summary>
+  std::vector<Result> results_;
+};
\ No newline at end of file
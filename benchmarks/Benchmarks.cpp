@@ -0,0 +1,964 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include <array>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <random>
+#include <iostream>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdlib>
+
+#include "SDL.h"
+
+#include "BenchmarkRunner.h"
+#include "ScriptedPlayer.h"
+#include "ReplayHarness.h"
+#include "ResourceManager.h"
+#include "PacMan.h"
+#include "World.h"
+#include "MazeGenerator.h"
+#include "LevelArena.h"
+#include "TilePath.h"
+#include "CollisionBroadphase.h"
+#include "Ghosts.h"
+#include "Avatar.h"
+#include "Tile.h"
+#include "Vector2.h"
+#include "DistanceGrid.h"
+#include "IncrementalPathfinder.h"
+#include "ThreadPool.h"
+#include "LaunchOptions.h"
+
+extern const unsigned char kXOffset = 177;
+extern const unsigned char kYOffset = 60;
+extern const unsigned short kWindowWidth = 1024;
+extern const unsigned short kWindowHeight = 768;
+
+namespace {
+  /// <summary>
+  /// The usage text listing the available options.
+  /// </summary>
+  const char* kUsage =
+    "Usage: Benchmarks [options]\n"
+    "  --out <file>             Writes the JSON results to <file> instead of the standard output.\n"
+    "  --filter <text>          Only runs benchmarks whose names contain <text>.\n"
+    "  --min-time <ms>          The minimum time of each repetition of a calibrated benchmark (default 200).\n"
+    "  --repetitions <count>    The number of timed repetitions of each benchmark (default 5).\n"
+    "  --replay <directory>     Replays the recorded games in <directory> instead of running the suite.\n"
+    "  --record-scripted <n>    Records <n> games of a scripted player into the --replay directory first.\n"
+    "  --baseline <file>        Compares the results against an earlier JSON results file.\n"
+    "  --threshold <percent>    The slowdown from the baseline that fails the run (default 10).\n";
+  /// <summary>
+  /// The frame time that the game is advanced by, matching headless runs of the game.
+  /// </summary>
+  const unsigned int kStepMillis = 17;
+  /// <summary>
+  /// The number of frames after which a scripted game is ended, if the player has neither won nor lost.
+  /// </summary>
+  const unsigned int kMaxScriptedGameFrames = 60 * 60 * 10;
+  /// <summary>
+  /// The number of Ghosts updated by the crowd benchmark.
+  /// </summary>
+  const unsigned int kCrowdGhostCount = 1024;
+  /// <summary>
+  /// The width and height of the generated mazes that the map benchmarks are repeated on.
+  /// </summary>
+  const std::array<unsigned int, 3> kMazeSizes {{64, 256, 1024}};
+  /// <summary>
+  /// The number of pairs of open tiles that paths are generated between in each generated maze.
+  /// </summary>
+  const unsigned int kMazePathPairCount = 256;
+  /// <summary>
+  /// The width and height of the generated mazes that hierarchical and flat path searches are compared on.
+  /// </summary>
+  const std::array<unsigned int, 3> kPathfindingMazeSizes {{256, 1024, 4096}};
+  /// <summary>
+  /// The width and height of the generated maze that the distance field searches are compared on.
+  /// </summary>
+  const unsigned int kDistanceFieldMazeSize = 2048;
+  /// <summary>
+  /// The width and height of the generated mazes that paths to a moving target are found on.
+  /// </summary>
+  const std::array<unsigned int, 2> kChaseMazeSizes {{256, 1024}};
+  /// <summary>
+  /// The number of paths between random tiles that the route of the chased target is joined from.
+  /// </summary>
+  const unsigned int kChaseRouteLegCount = 16;
+  /// <summary>
+  /// The tile that the Avatar starts on, which generated mazes always leave open.
+  /// </summary>
+  const Vector2<TileCoordinate> kAvatarStartTile(14, 22);
+  /// <summary>
+  /// Exposes the protected decision making of the Ghosts to the benchmarks.
+  /// </summary>
+  class BenchmarkGhosts : public Ghosts {
+   public:
+    using Ghosts::GenerateRandomDirection;
+  };
+  /// <summary>
+  /// Exposes the protected movement of an entity to the benchmarks.
+  /// </summary>
+  class BenchmarkEntity : public Avatar {
+   public:
+    /// <summary>
+    /// Constructor for the BenchmarkEntity class.
+    /// </summary>
+    /// <param name="tile">The tile that the entity starts on.</param>
+    BenchmarkEntity(Vector2<TileCoordinate> tile)
+        : Avatar(Vector2<float>(tile.x_, tile.y_)) {}
+    /// <summary>
+    /// Moves the entity towards one of two neighbouring tiles, turning back whenever it arrives at one.
+    /// </summary>
+    /// <param name="elapsed_millis">The time to move for.</param>
+    /// <param name="a">The first tile.</param>
+    /// <param name="b">The second tile.</param>
+    /// <param name="world">The World whose portals are passed through.</param>
+    void Shuttle(unsigned int elapsed_millis, Vector2<TileCoordinate> a, Vector2<TileCoordinate> b, const World* world) {
+      if (CheckIsAtDestination()) {
+        next_tile_ = current_tile_ == a ? b : a;
+      }
+
+      UpdatePosition(elapsed_millis, world);
+    }
+  };
+
+  /// <summary>
+  /// Plays a game from the start with a scripted player, until it ends.
+  /// </summary>
+  /// <param name="seed">The random seed of the game and the player.</param>
+  /// <returns>The number of frames played.</returns>
+  unsigned int PlayScriptedGame(unsigned int seed) {
+    srand(seed);
+
+    PacMan game(nullptr);
+    ScriptedPlayer player(seed);
+    unsigned int frame = 0;
+
+    while (!game.game_over() && frame < kMaxScriptedGameFrames) {
+      game.Update(kStepMillis, player.NextFrame());
+      frame++;
+    }
+
+    return frame;
+  }
+
+  /// <summary>
+  /// Finds the distance from a source tile to every tile of the map with a queue of tiles, one tile at a
+  /// time. The single-threaded search that the distance fields of the World are measured against.
+  /// </summary>
+  /// <param name="world">The World to search.</param>
+  /// <param name="source_tile">The tile to find the distances from.</param>
+  /// <param name="queue">The tiles waiting to be expanded, reserved for every tile of the map.</param>
+  /// <param name="grid">The grid that the distances are stored in.</param>
+  void FindDistancesBreadthFirst(const World& world, Vector2<TileCoordinate> source_tile,
+                                 std::vector<Vector2<TileCoordinate>>& queue, DistanceGrid& grid) {
+    grid.Reset(world.map_width(), world.map_height());
+    grid.GetRow(source_tile.y_)[source_tile.x_] = 0;
+    queue.assign(1, source_tile);
+
+    for (size_t front = 0; front < queue.size(); front++) {
+      const Vector2<TileCoordinate> tile = queue[front];
+      const unsigned char exits = world.GetExitMask(tile, Tile::block_type::partial_block);
+      const unsigned int distance = grid.Get(tile) + 1;
+
+      for (auto direction : {Vector2<char>::up, Vector2<char>::down, Vector2<char>::left, Vector2<char>::right}) {
+        const Vector2<TileCoordinate> neighbour = world.GetStepDestination(tile, direction);
+
+        if ((exits & World::GetDirectionBit(direction)) && grid.Get(neighbour) == DistanceGrid::kUnreachable) {
+          grid.GetRow(neighbour.y_)[neighbour.x_] = distance;
+          queue.push_back(neighbour);
+        }
+      }
+    }
+  }
+
+  /// <summary>
+  /// Takes the first step of a path, as an entity following it would.
+  /// </summary>
+  /// <param name="world">The World whose portals the path passes through.</param>
+  /// <param name="tile">The tile that the step leaves.</param>
+  /// <param name="path">The path to follow, which must not be empty.</param>
+  /// <returns>The tile that the step arrives on, which is past the exit of a portal that it passes through.</returns>
+  Vector2<TileCoordinate> TakeStep(const World& world, Vector2<TileCoordinate> tile, TilePath& path) {
+    const Vector2<TileCoordinate> neighbour = path.PopFront(world);
+
+    for (auto direction : {Vector2<char>::up, Vector2<char>::down, Vector2<char>::left, Vector2<char>::right}) {
+      if (World::GetTileInDirection(tile, direction) == neighbour) {
+        return world.GetStepDestination(tile, direction);
+      }
+    }
+
+    return neighbour;
+  }
+
+  /// <summary>
+  /// Generates a maze from the first seed and loads it into a World, as the map benchmarks do.
+  /// </summary>
+  /// <param name="size">The width and height of the maze.</param>
+  /// <param name="arena">The arena that the map is created in.</param>
+  /// <param name="world">The World that the maze is loaded into.</param>
+  /// <returns>The structure of the maze.</returns>
+  std::string LoadMaze(unsigned int size, LevelArena& arena, World& world) {
+    const std::string maze = MazeGenerator::Generate({size, size, 1, MazeGenerator::kDefaultLoopPercent, 100});
+
+    arena.Release();
+    world.set_map_structure(maze);
+    world.Init(arena);
+
+    return maze;
+  }
+
+  /// <summary>
+  /// Finds every tile of the map that a path can end on, row by row.
+  /// </summary>
+  /// <param name="world">The World to search.</param>
+  /// <param name="max_valid_block_type">The most blocking tile type that is collected.</param>
+  /// <returns>The tiles, which exclude the entrances of portals.</returns>
+  std::vector<Vector2<TileCoordinate>> CollectOpenTiles(const World& world, enum Tile::block_type max_valid_block_type) {
+    std::vector<Vector2<TileCoordinate>> tiles;
+
+    for (unsigned int y = 0; y < world.map_height(); y++) {
+      for (unsigned int x = 0; x < world.map_width(); x++) {
+        const Vector2<TileCoordinate> tile(x, y);
+
+        if (world.CheckTileValidity(tile, max_valid_block_type) && !world.CheckPortalEntrance(tile)) {
+          tiles.push_back(tile);
+        }
+      }
+    }
+
+    return tiles;
+  }
+
+  /// <summary>
+  /// Draws pairs of tiles to find paths between. The pairs are drawn from a fixed seed, so every run measures
+  /// the same paths.
+  /// </summary>
+  /// <param name="tiles">The tiles to draw from, which must not be empty.</param>
+  /// <param name="count">The number of pairs.</param>
+  /// <returns>The pairs, each starting tile first.</returns>
+  std::vector<std::array<Vector2<TileCoordinate>, 2>> MakePairs(const std::vector<Vector2<TileCoordinate>>& tiles,
+                                                                unsigned int count) {
+    std::mt19937 pair_random(1);
+    std::vector<std::array<Vector2<TileCoordinate>, 2>> pairs;
+
+    for (unsigned int i = 0; i < count; i++) {
+      pairs.push_back({{tiles[pair_random() % tiles.size()], tiles[pair_random() % tiles.size()]}});
+    }
+
+    return pairs;
+  }
+}
+
+/// <summary>
+/// Runs the micro and macro benchmarks of the game's subsystems.
+/// </summary>
+/// <param name="runner">Times the benchmarks.</param>
+/// <returns>True if the benchmarks ran, else false.</returns>
+static bool RunSuite(BenchmarkRunner& runner) {
+  LevelArena arena;
+  World world;
+
+  try {
+    world.Init(arena);
+  }
+  catch (const std::exception& e) {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return false;
+  }
+
+  // Finds every tile that can be walked on, and a junction for the Ghost benchmarks.
+  std::vector<Vector2<TileCoordinate>> all_tiles;
+  std::vector<Vector2<TileCoordinate>> open_tiles;
+  Vector2<TileCoordinate> junction;
+  Vector2<TileCoordinate> junction_neighbour;
+
+  for (unsigned int y = 0; y < world.map_height(); y++) {
+    for (unsigned int x = 0; x < world.map_width(); x++) {
+      const Vector2<TileCoordinate> tile(x, y);
+
+      if (world.CheckTileValidity(tile, Tile::block_type::block)) {
+        all_tiles.push_back(tile);
+      }
+
+      if (!world.CheckTileValidity(tile, Tile::block_type::no_block)) {
+        continue;
+      }
+
+      open_tiles.push_back(tile);
+
+      unsigned int open_neighbour_count = 0;
+
+      for (auto direction : {Vector2<char>::up, Vector2<char>::down, Vector2<char>::left, Vector2<char>::right}) {
+        if (world.CheckTileValidity(World::GetTileInDirection(tile, direction), Tile::block_type::no_block)) {
+          open_neighbour_count++;
+          junction_neighbour = World::GetTileInDirection(tile, direction);
+        }
+      }
+
+      if (open_neighbour_count >= 3 && junction == Vector2<TileCoordinate>::zero) {
+        junction = tile;
+      }
+    }
+  }
+
+  if (open_tiles.size() < 2) {
+    std::cerr << "The map has too few open tiles to benchmark" << std::endl;
+    return false;
+  }
+
+  // The neighbour of the junction found last belongs to the last open tile, so it is found again for the junction.
+  for (auto direction : {Vector2<char>::up, Vector2<char>::down, Vector2<char>::left, Vector2<char>::right}) {
+    if (world.CheckTileValidity(World::GetTileInDirection(junction, direction), Tile::block_type::no_block)) {
+      junction_neighbour = World::GetTileInDirection(junction, direction);
+    }
+  }
+
+  // Checks the validity of every tile in the map in turn, walls included.
+  runner.Run("world/check_tile_validity", "micro", [&](std::uint64_t operations) {
+    std::uint64_t valid_count = 0;
+
+    for (std::uint64_t i = 0; i < operations; i++) {
+      valid_count += world.CheckTileValidity(all_tiles[i % all_tiles.size()], Tile::block_type::no_block);
+    }
+
+    BenchmarkRunner::KeepResult(valid_count);
+  });
+
+  // Looks up the exits of every tile in the map in turn, walls included.
+  runner.Run("world/get_exit_mask", "micro", [&](std::uint64_t operations) {
+    std::uint64_t exit_bits = 0;
+
+    for (std::uint64_t i = 0; i < operations; i++) {
+      exit_bits += world.GetExitMask(all_tiles[i % all_tiles.size()], Tile::block_type::no_block);
+    }
+
+    BenchmarkRunner::KeepResult(exit_bits);
+  });
+
+  // Generates a path between every ordered pair of open tiles, once per repetition.
+  const std::uint64_t pair_count = static_cast<std::uint64_t>(open_tiles.size()) * (open_tiles.size() - 1);
+  TilePath path;
+
+  path.Reserve(arena, world.GetMaxPathLength());
+
+  // Checks that paths across the tunnels step through their portals, which is far shorter than going around.
+  std::vector<Vector2<TileCoordinate>> queue;
+  DistanceGrid distances;
+
+  queue.reserve(world.map_width() * world.map_height());
+
+  for (const World::Portal& portal : world.portals()) {
+    for (Vector2<char> direction : World::kStepDirections) {
+      const Vector2<TileCoordinate> from_tile =
+          World::GetTileInDirection(portal.entrance_, Vector2<char>(-direction.x_, -direction.y_));
+
+      if (!(world.GetExitMask(from_tile, Tile::block_type::partial_block) & World::GetDirectionBit(direction))) {
+        continue;
+      }
+
+      const Vector2<TileCoordinate> to_tile = world.GetStepDestination(from_tile, direction);
+
+      FindDistancesBreadthFirst(world, from_tile, queue, distances);
+      world.GetPath(from_tile, to_tile, path);
+
+      if (path.size() != distances.Get(to_tile)) {
+        std::cerr << "The path across the portal at (" << portal.entrance_.x_ << ", " << portal.entrance_.y_ << ") has "
+                  << path.size() << " steps rather than " << distances.Get(to_tile) << std::endl;
+        return false;
+      }
+    }
+  }
+
+  runner.RunFixed("world/get_path_all_pairs", "micro", [&](std::uint64_t) {
+    std::uint64_t path_length = 0;
+
+    for (auto from : open_tiles) {
+      for (auto to : open_tiles) {
+        if (from != to) {
+          world.GetPath(from, to, path);
+          path_length += path.size();
+        }
+      }
+    }
+
+    BenchmarkRunner::KeepResult(path_length);
+  }, pair_count);
+
+  // Tests points between tiles, which never touch a Dot, so none are eaten.
+  runner.Run("world/check_dot_intersection_miss", "micro", [&](std::uint64_t operations) {
+    std::uint64_t hit_count = 0;
+
+    for (std::uint64_t i = 0; i < operations; i++) {
+      const Vector2<TileCoordinate> tile = open_tiles[i % open_tiles.size()];
+      const float half_tile = PacMan::kTileSize / 2.f;
+
+      hit_count += world.CheckDotIntersection(
+        Vector2<float>(tile.x_ * PacMan::kTileSize + half_tile, tile.y_ * PacMan::kTileSize + half_tile));
+    }
+
+    BenchmarkRunner::KeepResult(hit_count);
+  });
+
+  // Files 256 entities across the open tiles and finds those near each open tile in turn, as the Avatar does.
+  const unsigned int kBroadphaseEntityCount = 256;
+  CollisionBroadphase broadphase;
+
+  broadphase.Reserve(arena, kBroadphaseEntityCount);
+
+  runner.Run("collision/broadphase_256", "micro", [&](std::uint64_t operations) {
+    std::uint64_t nearby_count = 0;
+
+    for (std::uint64_t i = 0; i < operations; i++) {
+      broadphase.Clear();
+
+      for (unsigned int j = 0; j < kBroadphaseEntityCount; j++) {
+        broadphase.Insert(j, open_tiles[(i + j * 7) % open_tiles.size()]);
+      }
+
+      broadphase.ForEachNear(open_tiles[i % open_tiles.size()], [&nearby_count](unsigned int) {
+        nearby_count++;
+      });
+    }
+
+    BenchmarkRunner::KeepResult(nearby_count);
+  });
+
+  // Chooses a direction at a junction, as a Ghost does at every tile without a path.
+  runner.Run("ghost/generate_random_direction", "micro", [&](std::uint64_t operations) {
+    std::uint64_t checksum = 0;
+
+    for (std::uint64_t i = 0; i < operations; i++) {
+      const Vector2<char> direction = BenchmarkGhosts::GenerateRandomDirection(junction, Vector2<char>::up, &world);
+      checksum += static_cast<unsigned char>(direction.x_ * 3 + direction.y_);
+    }
+
+    BenchmarkRunner::KeepResult(checksum);
+  });
+
+  Ghosts crowd;
+  crowd.Init(arena, kCrowdGhostCount, world.GetMaxPathLength());
+
+  // Updates a crowd of Ghosts by a frame, which scales with the number of Ghosts rather than with the map.
+  runner.Run("ghost/update_1024", "micro", [&](std::uint64_t operations) {
+    for (std::uint64_t i = 0; i < operations; i++) {
+      crowd.Update(kStepMillis, &world);
+    }
+
+    BenchmarkRunner::KeepResult(static_cast<std::uint64_t>(crowd.subpixel_position(0).x_));
+  });
+
+  BenchmarkEntity entity(junction);
+
+  // Moves an entity back and forth between two tiles by 1 ms at a time, so most steps move within a tile.
+  runner.Run("movable/update_position", "micro", [&](std::uint64_t operations) {
+    for (std::uint64_t i = 0; i < operations; i++) {
+      entity.Shuttle(1, junction, junction_neighbour, &world);
+    }
+
+    BenchmarkRunner::KeepResult(static_cast<std::uint64_t>(entity.position().x_ + entity.position().y_));
+  });
+
+  // Repeats the map benchmarks on generated mazes of increasing size, to measure how they scale with the map.
+  for (unsigned int size : kMazeSizes) {
+    const std::string suffix = std::to_string(size);
+    const std::array<std::string, 4> names {{
+      "maze/generate_" + suffix, "maze/load_" + suffix, "maze/get_path_" + suffix, "maze/check_dot_intersection_" + suffix
+    }};
+
+    if (std::none_of(names.begin(), names.end(), [&runner](const std::string& name) { return runner.Selected(name); })) {
+      continue;
+    }
+
+    MazeOptions maze_options {size, size, 1, MazeGenerator::kDefaultLoopPercent, 100};
+    std::string maze;
+
+    runner.Run(names[0], "micro", [&](std::uint64_t operations) {
+      for (std::uint64_t i = 0; i < operations; i++) {
+        maze_options.seed_ = static_cast<unsigned int>(i + 1);
+        maze = MazeGenerator::Generate(maze_options);
+      }
+
+      BenchmarkRunner::KeepResult(maze.size());
+    });
+
+    LevelArena maze_arena;
+    World maze_world;
+
+    LoadMaze(size, maze_arena, maze_world);
+
+    // Creates the map and its items, as loading a level does.
+    runner.Run(names[1], "micro", [&](std::uint64_t operations) {
+      for (std::uint64_t i = 0; i < operations; i++) {
+        maze_arena.Release();
+        maze_world.Init(maze_arena);
+      }
+
+      BenchmarkRunner::KeepResult(maze_world.GetRemainingItemCount());
+    });
+
+    const std::vector<Vector2<TileCoordinate>> maze_tiles = CollectOpenTiles(maze_world, Tile::block_type::no_block);
+    const std::vector<std::array<Vector2<TileCoordinate>, 2>> pairs = MakePairs(maze_tiles, kMazePathPairCount);
+    TilePath maze_path;
+    maze_path.Reserve(maze_arena, maze_world.GetMaxPathLength());
+
+    runner.Run(names[2], "micro", [&](std::uint64_t operations) {
+      std::uint64_t path_length = 0;
+
+      for (std::uint64_t i = 0; i < operations; i++) {
+        const auto& pair = pairs[i % pairs.size()];
+
+        maze_world.GetPath(pair[0], pair[1], maze_path);
+        path_length += maze_path.size();
+      }
+
+      BenchmarkRunner::KeepResult(path_length);
+    });
+
+    // Tests points between tiles, as for the map in the assets, so none of the Dots are eaten.
+    runner.Run(names[3], "micro", [&](std::uint64_t operations) {
+      std::uint64_t hit_count = 0;
+
+      for (std::uint64_t i = 0; i < operations; i++) {
+        const Vector2<TileCoordinate> tile = maze_tiles[i % maze_tiles.size()];
+        const float half_tile = PacMan::kTileSize / 2.f;
+
+        hit_count += maze_world.CheckDotIntersection(
+          Vector2<float>(tile.x_ * PacMan::kTileSize + half_tile, tile.y_ * PacMan::kTileSize + half_tile));
+      }
+
+      BenchmarkRunner::KeepResult(hit_count);
+    });
+  }
+
+  // Compares the hierarchical pathfinder with the flat depth-first search on the same pairs of tiles.
+  for (unsigned int size : kPathfindingMazeSizes) {
+    const std::string suffix = std::to_string(size);
+    const std::array<std::string, 3> names {{"path/flat_" + suffix, "path/hierarchical_" + suffix, "path/update_" + suffix}};
+
+    if (std::none_of(names.begin(), names.end(), [&runner](const std::string& name) { return runner.Selected(name); })) {
+      continue;
+    }
+
+    LevelArena maze_arena;
+    World maze_world;
+
+    LoadMaze(size, maze_arena, maze_world);
+
+    const std::vector<Vector2<TileCoordinate>> maze_tiles = CollectOpenTiles(maze_world, Tile::block_type::no_block);
+    const std::vector<std::array<Vector2<TileCoordinate>, 2>> pairs = MakePairs(maze_tiles, kMazePathPairCount);
+    TilePath maze_path;
+    maze_path.Reserve(maze_arena, maze_world.GetMaxPathLength());
+
+    runner.Run(names[0], "micro", [&](std::uint64_t operations) {
+      std::uint64_t path_length = 0;
+
+      for (std::uint64_t i = 0; i < operations; i++) {
+        const auto& pair = pairs[i % pairs.size()];
+
+        maze_world.GetFlatPath(pair[0], pair[1], maze_path);
+        path_length += maze_path.size();
+      }
+
+      BenchmarkRunner::KeepResult(path_length);
+    });
+
+    runner.Run(names[1], "micro", [&](std::uint64_t operations) {
+      std::uint64_t path_length = 0;
+
+      for (std::uint64_t i = 0; i < operations; i++) {
+        const auto& pair = pairs[i % pairs.size()];
+
+        maze_world.GetPath(pair[0], pair[1], maze_path);
+        path_length += maze_path.size();
+      }
+
+      BenchmarkRunner::KeepResult(path_length);
+    });
+
+    // Closes and opens a corridor in turn, which updates the clusters around it rather than the whole map.
+    const Vector2<TileCoordinate> corridor = maze_tiles[maze_tiles.size() / 2];
+
+    runner.Run(names[2], "micro", [&](std::uint64_t operations) {
+      for (std::uint64_t i = 0; i < operations; i++) {
+        maze_world.SetBlockType(corridor, i % 2 == 0 ? Tile::block_type::block : Tile::block_type::no_block);
+      }
+
+      maze_world.SetBlockType(corridor, Tile::block_type::no_block);
+    });
+  }
+
+  // Chases a target that moves one tile per operation, finding each path from scratch or by repairing the last.
+  for (unsigned int size : kChaseMazeSizes) {
+    const std::string suffix = std::to_string(size);
+    const std::array<std::string, 3> names {{
+      "chase/replan_" + suffix, "chase/incremental_" + suffix, "chase/incremental_update_" + suffix
+    }};
+
+    if (std::none_of(names.begin(), names.end(), [&runner](const std::string& name) { return runner.Selected(name); })) {
+      continue;
+    }
+
+    LevelArena maze_arena;
+    World maze_world;
+
+    LoadMaze(size, maze_arena, maze_world);
+
+    const std::vector<Vector2<TileCoordinate>> maze_tiles = CollectOpenTiles(maze_world, Tile::block_type::partial_block);
+    TilePath maze_path;
+    maze_path.Reserve(maze_arena, maze_world.GetMaxPathLength());
+
+    // The target walks between random tiles, and the chaser sets out from a random tile whenever it catches up.
+    std::mt19937 route_random(1);
+    std::vector<Vector2<TileCoordinate>> route(1, maze_tiles[route_random() % maze_tiles.size()]);
+    const Vector2<TileCoordinate> chaser_start = maze_tiles[route_random() % maze_tiles.size()];
+
+    for (unsigned int i = 0; i < kChaseRouteLegCount; i++) {
+      maze_world.GetPath(route.back(), maze_tiles[route_random() % maze_tiles.size()], maze_path);
+
+      while (!maze_path.empty()) {
+        route.push_back(TakeStep(maze_world, route.back(), maze_path));
+      }
+    }
+
+    // Each operation moves the target one tile along its route, finds the chaser's path to it and moves the
+    // chaser one step along the path.
+    auto chase = [&](std::uint64_t operations, auto find_path) {
+      Vector2<TileCoordinate> chaser = chaser_start;
+      std::uint64_t path_length = 0;
+
+      for (std::uint64_t i = 0; i < operations; i++) {
+        const Vector2<TileCoordinate> target = route[i % route.size()];
+
+        find_path(chaser, target);
+        path_length += maze_path.size();
+
+        if (!maze_path.empty()) {
+          chaser = TakeStep(maze_world, chaser, maze_path);
+        }
+
+        if (chaser == target) {
+          chaser = chaser_start;
+        }
+      }
+
+      BenchmarkRunner::KeepResult(path_length);
+    };
+
+    runner.Run(names[0], "micro", [&](std::uint64_t operations) {
+      chase(operations, [&](Vector2<TileCoordinate> chaser, Vector2<TileCoordinate> target) {
+        maze_world.GetPath(chaser, target, maze_path);
+      });
+    });
+
+    IncrementalPathfinder pathfinder;
+    pathfinder.Build(maze_world, Tile::block_type::partial_block);
+
+    runner.Run(names[1], "micro", [&](std::uint64_t operations) {
+      chase(operations, [&](Vector2<TileCoordinate> chaser, Vector2<TileCoordinate> target) {
+        pathfinder.SetGoal(target);
+        pathfinder.FindPath(chaser, maze_path);
+      });
+    });
+
+    // Closes and opens a corridor halfway along the chaser's path in turn, repairing the path after each change.
+    maze_world.GetPath(chaser_start, route.front(), maze_path);
+
+    Vector2<TileCoordinate> corridor = chaser_start;
+
+    for (unsigned int step_count = maze_path.size() / 2; step_count > 0; step_count--) {
+      corridor = TakeStep(maze_world, corridor, maze_path);
+    }
+
+    if (!(corridor == chaser_start)) {
+      pathfinder.SetGoal(route.front());
+
+      runner.Run(names[2], "micro", [&](std::uint64_t operations) {
+        std::uint64_t path_length = 0;
+
+        for (std::uint64_t i = 0; i < operations; i++) {
+          maze_world.SetBlockType(corridor, i % 2 == 0 ? Tile::block_type::block : Tile::block_type::no_block);
+          pathfinder.UpdateTile(corridor);
+          pathfinder.FindPath(chaser_start, maze_path);
+          path_length += maze_path.size();
+        }
+
+        maze_world.SetBlockType(corridor, Tile::block_type::no_block);
+        pathfinder.UpdateTile(corridor);
+        BenchmarkRunner::KeepResult(path_length);
+      });
+    }
+  }
+
+  const std::string distance_suffix = std::to_string(kDistanceFieldMazeSize);
+  const std::array<std::string, 3> distance_names {{
+    "distance/breadth_first_" + distance_suffix, "distance/bitset_" + distance_suffix,
+    "distance/parallel_" + distance_suffix
+  }};
+
+  if (std::any_of(distance_names.begin(), distance_names.end(),
+                  [&runner](const std::string& name) { return runner.Selected(name); })) {
+    LevelArena maze_arena;
+    World maze_world;
+    const std::string maze = LoadMaze(kDistanceFieldMazeSize, maze_arena, maze_world);
+
+    // The Ghosts' home tile and the exits of their base are marked in the maze, and the Avatar starts on a set tile.
+    std::vector<Vector2<TileCoordinate>> sources;
+    Vector2<TileCoordinate> tile(0, 0);
+
+    for (char cell : maze) {
+      if (cell == '\n') {
+        tile = Vector2<TileCoordinate>(0, tile.y_ + 1);
+        continue;
+      }
+
+      if (cell == 'H' || cell == 'P' || cell == 'R') {
+        sources.push_back(tile);
+      }
+
+      tile.x_++;
+    }
+
+    sources.push_back(kAvatarStartTile);
+
+    std::vector<DistanceGrid> grids(sources.size());
+    std::vector<Vector2<TileCoordinate>> queue;
+    queue.reserve(static_cast<size_t>(kDistanceFieldMazeSize) * kDistanceFieldMazeSize);
+
+    // Each operation finds the distance fields of every source.
+    runner.Run(distance_names[0], "micro", [&](std::uint64_t operations) {
+      for (std::uint64_t i = 0; i < operations; i++) {
+        for (size_t j = 0; j < sources.size(); j++) {
+          FindDistancesBreadthFirst(maze_world, sources[j], queue, grids[j]);
+        }
+      }
+
+      BenchmarkRunner::KeepResult(grids.back().Get(sources.front()));
+    });
+
+    runner.Run(distance_names[1], "micro", [&](std::uint64_t operations) {
+      for (std::uint64_t i = 0; i < operations; i++) {
+        maze_world.GetDistanceFields(sources, Tile::block_type::partial_block, grids);
+      }
+
+      BenchmarkRunner::KeepResult(grids.back().Get(sources.front()));
+    });
+
+    ThreadPool thread_pool;
+
+    runner.Run(distance_names[2], "micro", [&](std::uint64_t operations) {
+      for (std::uint64_t i = 0; i < operations; i++) {
+        maze_world.GetDistanceFields(sources, Tile::block_type::partial_block, grids, &thread_pool);
+      }
+
+      BenchmarkRunner::KeepResult(grids.back().Get(sources.front()));
+    });
+  }
+
+  // Vector math over a buffer of vectors, which mirrors the movement and collision arithmetic.
+  std::vector<Vector2<float>> vectors;
+
+  for (unsigned int i = 0; i < 1024; i++) {
+    vectors.push_back(Vector2<float>(static_cast<float>(i % 37) - 18.f, static_cast<float>(i % 23) - 11.f));
+  }
+
+  runner.Run("vector2/arithmetic", "micro", [&](std::uint64_t operations) {
+    Vector2<float> sum(0.f, 0.f);
+
+    for (std::uint64_t i = 0; i < operations; i++) {
+      const Vector2<float>& a = vectors[i & 1023];
+      const Vector2<float>& b = vectors[(i + 1) & 1023];
+
+      sum += (a - b) * .5f + a / 4.f;
+    }
+
+    BenchmarkRunner::KeepResult(static_cast<std::uint64_t>(sum.x_ + sum.y_));
+  });
+
+  runner.Run("vector2/get_length", "micro", [&](std::uint64_t operations) {
+    float total = 0.f;
+
+    for (std::uint64_t i = 0; i < operations; i++) {
+      total += vectors[i & 1023].GetLength();
+    }
+
+    BenchmarkRunner::KeepResult(static_cast<std::uint64_t>(total));
+  });
+
+  runner.Run("vector2/normalize", "micro", [&](std::uint64_t operations) {
+    float total = 0.f;
+
+    for (std::uint64_t i = 0; i < operations; i++) {
+      Vector2<float> v = vectors[i & 1023];
+      v.Normalize();
+      total += v.x_;
+    }
+
+    BenchmarkRunner::KeepResult(static_cast<std::uint64_t>(total * 1000.f));
+  });
+
+  // Updates a game by a frame with a scripted player. A new game is started whenever one ends.
+  srand(1);
+
+  PacMan* frame_game = new PacMan(nullptr);
+  ScriptedPlayer frame_player(1);
+
+  runner.Run("pacman/update_frame", "macro", [&](std::uint64_t operations) {
+    for (std::uint64_t i = 0; i < operations; i++) {
+      if (frame_game->game_over()) {
+        delete frame_game;
+        frame_game = new PacMan(nullptr);
+      }
+
+      frame_game->Update(kStepMillis, frame_player.NextFrame());
+    }
+  });
+
+  // Reloads the level, which releases the level arena and creates the map, items and entities again.
+  runner.Run("pacman/load_level", "macro", [&](std::uint64_t operations) {
+    for (std::uint64_t i = 0; i < operations; i++) {
+      frame_game->LoadLevel();
+    }
+  });
+
+  delete frame_game;
+
+  // Plays whole games with a scripted player, each with its own seed.
+  unsigned int game_seed = 0;
+  std::uint64_t scripted_frames = 0;
+
+  runner.Run("pacman/scripted_game", "macro", [&](std::uint64_t operations) {
+    for (std::uint64_t i = 0; i < operations; i++) {
+      scripted_frames += PlayScriptedGame(++game_seed);
+    }
+  });
+
+  if (runner.Selected("pacman/scripted_game") && game_seed > 0) {
+    std::cerr << "Scripted games averaged " << scripted_frames / game_seed << " frames" << std::endl;
+  }
+
+  return true;
+}
+
+int main(int argc, char** args) {
+  std::string out_file_path;
+  std::string filter;
+  unsigned int min_millis = 200;
+  unsigned int repetitions = 5;
+  std::string replay_directory_path;
+  unsigned int record_count = 0;
+  std::string baseline_file_path;
+  double threshold_percent = 10.0;
+
+  try {
+    for (int i = 1; i < argc; i++) {
+      const std::string option = args[i];
+
+      // Retrieves the value that follows an option.
+      auto next_value = [&]() -> std::string {
+        if (i + 1 >= argc) {
+          throw std::invalid_argument("Missing value for " + option);
+        }
+
+        return args[++i];
+      };
+
+      if (option == "--out") {
+        out_file_path = next_value();
+      } else if (option == "--filter") {
+        filter = next_value();
+      } else if (option == "--min-time") {
+        min_millis = LaunchOptions::ParseUnsigned(option, next_value());
+      } else if (option == "--repetitions") {
+        repetitions = LaunchOptions::ParseUnsigned(option, next_value());
+      } else if (option == "--replay") {
+        replay_directory_path = next_value();
+      } else if (option == "--record-scripted") {
+        record_count = LaunchOptions::ParseUnsigned(option, next_value());
+      } else if (option == "--baseline") {
+        baseline_file_path = next_value();
+      } else if (option == "--threshold") {
+        threshold_percent = LaunchOptions::ParseUnsigned(option, next_value());
+      } else {
+        throw std::invalid_argument("Unrecognised option \"" + option + "\"");
+      }
+    }
+
+    if (record_count > 0 && replay_directory_path.empty()) {
+      throw std::invalid_argument("--record-scripted requires --replay");
+    }
+  }
+  catch (const std::invalid_argument& e) {
+    std::cerr << e.what() << std::endl << kUsage;
+    return EXIT_FAILURE;
+  }
+
+  // Only the timer and file paths of SDL are used, as nothing is drawn.
+  if (SDL_Init(0) < 0) {
+    std::cerr << "Failed to initialise SDL" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    // Maps the asset archive if it exists, so the map is read the same way as in the game.
+    ResourceManager::Instance().OpenArchive();
+
+    if (record_count > 0) {
+      ReplayHarness::RecordScriptedGames(replay_directory_path, record_count);
+    }
+  }
+  catch (const std::exception& e) {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  BenchmarkRunner runner(min_millis, repetitions, filter);
+  unsigned int failure_count = 0;
+
+  // Replays recorded games instead of the benchmark suite when a directory of traces is given.
+  if (replay_directory_path.empty()) {
+    if (!RunSuite(runner)) {
+      return EXIT_FAILURE;
+    }
+  } else {
+    try {
+      failure_count += ReplayHarness::ReplayDirectory(runner, replay_directory_path);
+    }
+    catch (const std::exception& e) {
+      std::cerr << "Exception: " << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Flags the benchmarks that slowed down since the baseline was recorded.
+  if (!baseline_file_path.empty()) {
+    try {
+      failure_count += ReplayHarness::CompareWithBaseline(runner, baseline_file_path, threshold_percent);
+    }
+    catch (const std::exception& e) {
+      std::cerr << "Exception: " << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Writes the results as JSON.
+  if (out_file_path.empty()) {
+    runner.WriteJson(std::cout);
+  } else {
+    std::ofstream out_file(out_file_path);
+
+    runner.WriteJson(out_file);
+
+    if (out_file.fail()) {
+      std::cerr << "Exception: Cannot write \"" << out_file_path << "\"" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return failure_count == 0 ? 0 : EXIT_FAILURE;
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "ReplayHarness.h"
+
+#include <array>
+#include <map>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <filesystem>
+#include <cstdlib>
+#include <cmath>
+
+#include "SDL_scancode.h"
+
+#include "BenchmarkRunner.h"
+#include "ScriptedPlayer.h"
+#include "InputTrace.h"
+#include "PacMan.h"
+
+namespace {
+  /// <summary>
+  /// The frame time that scripted games are recorded with, matching headless runs of the game.
+  /// </summary>
+  const unsigned int kStepMillis = 17;
+  /// <summary>
+  /// The number of frames after which a scripted game is ended, if the player has neither won nor lost.
+  /// </summary>
+  const unsigned int kMaxScriptedGameFrames = 60 * 60 * 10;
+
+  /// <summary>
+  /// Finds the value of a field in a line of a JSON results file.
+  /// </summary>
+  /// <param name="line">The line, which holds one benchmark.</param>
+  /// <param name="field">The name of the field.</param>
+  /// <param name="value">Receives the text of the value, without quotes.</param>
+  /// <returns>True if the line contains the field, else false.</returns>
+  bool FindJsonField(const std::string& line, const std::string& field, std::string& value) {
+    const std::string key = "\"" + field + "\": ";
+    size_t start = line.find(key);
+
+    if (start == std::string::npos) {
+      return false;
+    }
+
+    start += key.size();
+
+    if (start < line.size() && line[start] == '"') {
+      const size_t end = line.find('"', start + 1);
+      value = line.substr(start + 1, end == std::string::npos ? std::string::npos : end - start - 1);
+    } else {
+      value = line.substr(start, line.find_first_of(",}", start) - start);
+    }
+
+    return true;
+  }
+}
+
+ReplayHarness::Outcome ReplayHarness::Replay(const InputTrace& trace) {
+  srand(trace.seed());
+
+  PacMan game(nullptr);
+  std::array<Uint8, SDL_NUM_SCANCODES> keystate {};
+  Outcome outcome {0, 0, 0};
+  bool playing = true;
+
+  for (auto run = trace.runs().begin(); playing && run != trace.runs().end(); ++run) {
+    InputTrace::KeystateFromKeys(run->keys_, keystate.data());
+
+    for (unsigned int i = 0; playing && i < run->frame_count_; i++) {
+      // The escape key ends the game part way through the frame, as it did when recorded.
+      playing = game.Update(run->elapsed_millis_, keystate.data());
+      outcome.frame_count_++;
+    }
+  }
+
+  outcome.score_ = game.score();
+  outcome.state_hash_ = game.StateHash();
+
+  return outcome;
+}
+
+unsigned int ReplayHarness::ReplayDirectory(BenchmarkRunner& runner, const std::string& directory_path) {
+  std::vector<std::filesystem::path> trace_paths;
+  std::error_code error;
+
+  for (const auto& dir_entry : std::filesystem::directory_iterator(directory_path, error)) {
+    if (dir_entry.is_regular_file() && dir_entry.path().extension() == InputTrace::kFileExtension) {
+      trace_paths.push_back(dir_entry.path());
+    }
+  }
+
+  if (error) {
+    throw std::ios_base::failure("Cannot find/access \"" + directory_path + "\"");
+  }
+
+  // Replays in name order, so results are listed in the same order on every platform.
+  std::sort(trace_paths.begin(), trace_paths.end());
+
+  unsigned int mismatch_count = 0;
+
+  for (const auto& trace_path : trace_paths) {
+    const std::string name = "replay/" + trace_path.stem().string();
+
+    if (!runner.Selected(name)) {
+      continue;
+    }
+
+    const InputTrace trace = InputTrace::Load(trace_path.string());
+    Outcome outcome {0, 0, 0};
+
+    runner.RunFixed(name, "replay", [&](std::uint64_t) {
+      outcome = Replay(trace);
+    }, std::max<std::uint64_t>(trace.frame_count(), 1));
+
+    const auto allocations = std::llround(runner.results().back().allocations_ * trace.frame_count());
+
+    std::cerr << "  " << outcome.frame_count_ << " frames, score " << outcome.score_ << ", "
+              << allocations << " allocations per replay" << std::endl;
+
+    // The game is deterministic, so any difference is a change in behaviour rather than in speed.
+    if (outcome.score_ != trace.score() || outcome.state_hash_ != trace.state_hash()) {
+      std::cerr << "  Does not match its recording: score " << outcome.score_ << " (recorded " << trace.score()
+                << "), state " << std::hex << outcome.state_hash_ << " (recorded " << trace.state_hash() << ")"
+                << std::dec << std::endl;
+      mismatch_count++;
+    }
+  }
+
+  return mismatch_count;
+}
+
+unsigned int ReplayHarness::CompareWithBaseline(const BenchmarkRunner& runner, const std::string& baseline_file_path,
+                                                double threshold_percent) {
+  std::ifstream baseline_file(baseline_file_path);
+
+  if (!baseline_file.is_open()) {
+    throw std::ios_base::failure("Cannot find/access \"" + baseline_file_path + "\"");
+  }
+
+  // The results are written one benchmark per line, so each line is searched for a name and a median time.
+  std::map<std::string, double> baseline_nanos;
+  std::string line;
+
+  while (std::getline(baseline_file, line)) {
+    std::string name;
+    std::string median_nanos;
+
+    if (FindJsonField(line, "name", name) && FindJsonField(line, "median_ns", median_nanos)) {
+      baseline_nanos[name] = std::atof(median_nanos.c_str());
+    }
+  }
+
+  unsigned int regression_count = 0;
+
+  std::cerr << "Compared with " << baseline_file_path << " (threshold " << threshold_percent << "%):" << std::endl;
+
+  for (const auto& result : runner.results()) {
+    auto baseline = baseline_nanos.find(result.name_);
+
+    if (baseline == baseline_nanos.end() || baseline->second <= 0) {
+      std::cerr << "  " << std::left << std::setw(42) << result.name_ << std::right << " not in baseline" << std::endl;
+      continue;
+    }
+
+    const double change_percent = (result.median_nanos_ - baseline->second) / baseline->second * 100.0;
+    const bool regressed = change_percent > threshold_percent;
+
+    std::cerr << "  " << std::left << std::setw(42) << result.name_ << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << baseline->second << " -> " << std::setw(14) << result.median_nanos_ << " ns/op"
+              << std::showpos << std::setw(9) << change_percent << "%" << std::noshowpos
+              << (regressed ? "  REGRESSION" : "") << std::endl;
+
+    if (regressed) {
+      regression_count++;
+    }
+  }
+
+  return regression_count;
+}
+
+void ReplayHarness::RecordScriptedGames(const std::string& directory_path, unsigned int count) {
+  std::error_code error;
+  std::filesystem::create_directories(directory_path, error);
+
+  for (unsigned int seed = 1; seed <= count; seed++) {
+    srand(seed);
+
+    PacMan game(nullptr);
+    ScriptedPlayer player(seed);
+    InputTrace trace(seed);
+
+    while (!game.game_over() && trace.frame_count() < kMaxScriptedGameFrames) {
+      const Uint8* keystate = player.NextFrame();
+
+      trace.Record(kStepMillis, keystate);
+      game.Update(kStepMillis, keystate);
+    }
+
+    trace.set_result(game.score(), game.StateHash());
+
+    const std::string file_path =
+      (std::filesystem::path(directory_path) / ("scripted-" + std::to_string(seed) + InputTrace::kFileExtension)).string();
+
+    trace.Save(file_path);
+    std::cerr << "Recorded " << trace.frame_count() << " frames to " << file_path << std::endl;
+  }
+}
\ No newline at end of file
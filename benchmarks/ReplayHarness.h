@@ -0,0 +1,77 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+class BenchmarkRunner;
+class InputTrace;
+
+/// <summary>
+/// Replays recorded games as benchmarks. Each trace in a directory is replayed headless through
+/// PacMan::Update as fast as possible, timed per frame, and checked against the score and state hash
+/// that were recorded with it. The timings can then be compared against the results of an earlier version.
+/// </summary>
+class ReplayHarness {
+ public:
+  /// <summary>
+  /// The outcome of a replayed game.
+  /// </summary>
+  struct Outcome {
+    /// <summary>
+    /// The number of frames replayed. Fewer than recorded if the game was exited with the escape key.
+    /// </summary>
+    std::uint64_t frame_count_;
+    /// <summary>
+    /// The final score.
+    /// </summary>
+    unsigned short score_;
+    /// <summary>
+    /// The final hash of the game state.
+    /// </summary>
+    std::uint64_t state_hash_;
+  };
+  /// <summary>
+  /// Replays a trace from the start of a new game.
+  /// </summary>
+  /// <param name="trace">The trace to replay.</param>
+  /// <returns>The outcome of the game.</returns>
+  static Outcome Replay(const InputTrace& trace);
+  /// <summary>
+  /// Replays every trace in a directory as a benchmark named "replay/" followed by the trace's file name.
+  /// Each operation is a frame. Reports every trace whose outcome differs from its recording.
+  /// Throws std::ios_base::failure if the directory or a trace cannot be read.
+  /// </summary>
+  /// <param name="runner">Times the replays.</param>
+  /// <param name="directory_path">The directory that contains the traces.</param>
+  /// <returns>The number of traces whose outcome differs from their recording.</returns>
+  static unsigned int ReplayDirectory(BenchmarkRunner& runner, const std::string& directory_path);
+  /// <summary>
+  /// Compares the median time of each benchmark run so far against the same benchmark in a baseline.
+  /// Reports the change of every benchmark, and flags those that slowed down by more than the threshold.
+  /// Throws std::ios_base::failure if the baseline cannot be read.
+  /// </summary>
+  /// <param name="runner">Holds the results to compare.</param>
+  /// <param name="baseline_file_path">A JSON results file written by an earlier run of the benchmarks.</param>
+  /// <param name="threshold_percent">The largest slowdown that is not a regression, as a percentage.</param>
+  /// <returns>The number of benchmarks that regressed.</returns>
+  static unsigned int CompareWithBaseline(const BenchmarkRunner& runner, const std::string& baseline_file_path,
+                                          double threshold_percent);
+  /// <summary>
+  /// Plays games with the scripted player and writes each as a trace, which gives a workload of
+  /// deterministic games without recording them by hand.
+  /// Throws std::ios_base::failure if a trace cannot be written.
+  /// </summary>
+  /// <param name="directory_path">The directory that the traces are written to.</param>
+  /// <param name="count">The number of games to record. Game n is played with seed n.</param>
+  static void RecordScriptedGames(const std::string& directory_path, unsigned int count);
+
+ private:
+  /// <summary>
+  /// Constructor for the ReplayHarness class.
+  /// </summary>
+  ReplayHarness(void);
+};
\ No newline at end of file
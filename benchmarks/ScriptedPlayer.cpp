@@ -0,0 +1,32 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "ScriptedPlayer.h"
+
+#include <array>
+
+namespace {
+  /// <summary>
+  /// The keys that the player turns with.
+  /// </summary>
+  const std::array<SDL_Scancode, 4> kArrowKeys {
+    SDL_SCANCODE_UP, SDL_SCANCODE_DOWN, SDL_SCANCODE_LEFT, SDL_SCANCODE_RIGHT
+  };
+}
+
+ScriptedPlayer::ScriptedPlayer(std::uint32_t seed)
+    : state_(seed),
+      keystate_({}),
+      frame_(0) {}
+
+const Uint8* ScriptedPlayer::NextFrame() {
+  if (frame_++ % kTurnFrames == 0) {
+    // A linear congruential generator, so the script is the same on every platform.
+    state_ = state_ * 1664525u + 1013904223u;
+    keystate_ = {};
+    keystate_[kArrowKeys[state_ >> 30]] = 1;
+  }
+
+  return keystate_.data();
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "SDL_scancode.h"
+#include "SDL_stdinc.h"
+
+/// <summary>
+/// Generates the keyboard input of a scripted player, who turns in a pseudo-random direction at a fixed interval.
+/// The script is independent of rand(), so it does not disturb the Ghosts' decisions.
+/// </summary>
+class ScriptedPlayer {
+ public:
+  /// <summary>
+  /// Constructor for the ScriptedPlayer class.
+  /// </summary>
+  /// <param name="seed">Determines the sequence of turns.</param>
+  ScriptedPlayer(std::uint32_t seed);
+  /// <summary>
+  /// Advances the script by a frame.
+  /// </summary>
+  /// <returns>The state of every key for the frame, indexed by SDL scancode.</returns>
+  const Uint8* NextFrame(void);
+
+ private:
+  /// <summary>
+  /// The number of frames between the player's changes of direction.
+  /// </summary>
+  static const unsigned int kTurnFrames = 20;
+  /// <summary>
+  /// The state of the pseudo-random generator.
+  /// </summary>
+  std::uint32_t state_;
+  /// <summary>
+  /// The state of every key.
+  /// </summary>
+  std::array<Uint8, SDL_NUM_SCANCODES> keystate_;
+  /// <summary>
+  /// The number of frames played.
+  /// </summary>
+  unsigned int frame_;
+};
\ No newline at end of file
@@ -0,0 +1,179 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "AllocationTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+  /// <summary>
+  /// The counters are plain atomics rather than members of an object, so they are usable by
+  /// allocations made during static initialisation, before any constructor has run.
+  /// </summary>
+  std::atomic<std::uint64_t> allocations {0};
+  std::atomic<std::uint64_t> deallocations {0};
+  std::atomic<std::uint64_t> bytes_allocated {0};
+
+  /// <summary>
+  /// Allocates memory from the C heap and counts the allocation.
+  /// </summary>
+  /// <param name="size">The number of bytes requested.</param>
+  /// <returns>The allocated memory, or nullptr if the allocation failed.</returns>
+  void* CountedAllocate(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+
+    // A zero byte request must still return a unique pointer.
+    return std::malloc(size > 0 ? size : 1);
+  }
+
+  /// <summary>
+  /// Frees memory allocated by CountedAllocate and counts the deallocation.
+  /// </summary>
+  /// <param name="memory">The memory to free. May be nullptr.</param>
+  void CountedFree(void* memory) {
+    if (memory) {
+      deallocations.fetch_add(1, std::memory_order_relaxed);
+      std::free(memory);
+    }
+  }
+
+  /// <summary>
+  /// Allocates memory aligned beyond the default alignment from the C heap and counts the allocation.
+  /// </summary>
+  /// <param name="size">The number of bytes requested.</param>
+  /// <param name="alignment">The alignment requested, which is a power of two.</param>
+  /// <returns>The allocated memory, or nullptr if the allocation failed.</returns>
+  void* CountedAllocateAligned(std::size_t size, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+
+    std::size_t alignment_bytes = static_cast<std::size_t>(alignment);
+#ifdef _MSC_VER
+    return _aligned_malloc(size > 0 ? size : 1, alignment_bytes);
+#else
+    // aligned_alloc takes sizes in whole multiples of the alignment, and a zero byte request must still return a
+    // unique pointer.
+    std::size_t aligned_size = size > 0 ? (size + alignment_bytes - 1) & ~(alignment_bytes - 1) : alignment_bytes;
+    return std::aligned_alloc(alignment_bytes, aligned_size);
+#endif
+  }
+
+  /// <summary>
+  /// Frees memory allocated by CountedAllocateAligned and counts the deallocation.
+  /// </summary>
+  /// <param name="memory">The memory to free. May be nullptr.</param>
+  void CountedFreeAligned(void* memory) {
+    if (memory) {
+      deallocations.fetch_add(1, std::memory_order_relaxed);
+#ifdef _MSC_VER
+      _aligned_free(memory);
+#else
+      std::free(memory);
+#endif
+    }
+  }
+}
+
+std::uint64_t AllocationTracker::allocation_count() {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationTracker::deallocation_count() {
+  return deallocations.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationTracker::allocated_bytes() {
+  return bytes_allocated.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) {
+  if (void* memory = CountedAllocate(size)) {
+    return memory;
+  }
+
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+  CountedFree(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+  CountedFree(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+  CountedFree(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+  CountedFree(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+  CountedFree(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+  CountedFree(memory);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  if (void* memory = CountedAllocateAligned(size, alignment)) {
+    return memory;
+  }
+
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return CountedAllocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return CountedAllocateAligned(size, alignment);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+  CountedFreeAligned(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept {
+  CountedFreeAligned(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+  CountedFreeAligned(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+  CountedFreeAligned(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+  CountedFreeAligned(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+  CountedFreeAligned(memory);
+}
\ No newline at end of file
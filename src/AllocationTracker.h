@@ -0,0 +1,37 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <cstdint>
+
+/// <summary>
+/// Counts every heap allocation made through the global operator new and operator delete, which are
+/// replaced in AllocationTracker.cpp. Counting is lock-free and includes allocations made on any thread.
+/// The profiler reports the number of allocations made in each frame.
+/// </summary>
+class AllocationTracker {
+ public:
+  /// <summary>
+  /// Gets the number of allocations made since startup.
+  /// </summary>
+  /// <returns>The number of allocations.</returns>
+  static std::uint64_t allocation_count(void);
+  /// <summary>
+  /// Gets the number of deallocations made since startup.
+  /// </summary>
+  /// <returns>The number of deallocations.</returns>
+  static std::uint64_t deallocation_count(void);
+  /// <summary>
+  /// Gets the total number of bytes requested by allocations since startup.
+  /// </summary>
+  /// <returns>The number of bytes allocated.</returns>
+  static std::uint64_t allocated_bytes(void);
+
+ private:
+  /// <summary>
+  /// Constructor for the AllocationTracker class.
+  /// </summary>
+  AllocationTracker(void);
+};
\ No newline at end of file
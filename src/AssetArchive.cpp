@@ -0,0 +1,324 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "AssetArchive.h"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <cstdint>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "SDL.h"
+#include "SDL_image.h"
+
+const char* AssetArchive::kFileName = "Assets.pak";
+
+namespace {
+  /// <summary>
+  /// Identifies the file as an asset archive.
+  /// </summary>
+  const char kMagic[4] = {'P', 'M', 'A', 'A'};
+  /// <summary>
+  /// The version of the archive layout. Archives with a different version are rejected.
+  /// </summary>
+  const std::uint32_t kVersion = 1;
+  /// <summary>
+  /// The size of the header: the magic, the version and the entry count.
+  /// </summary>
+  const size_t kHeaderSize = 12;
+  /// <summary>
+  /// The size of an index record: name offset and length, type, width, height, padding, payload offset and size.
+  /// </summary>
+  const size_t kIndexRecordSize = 40;
+  /// <summary>
+  /// The alignment of each payload, which keeps pixel rows suitably aligned for texture uploads.
+  /// </summary>
+  const size_t kPayloadAlignment = 16;
+
+  std::uint32_t ReadU32(const unsigned char* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<std::uint32_t>(data[3]) << 24);
+  }
+
+  std::uint64_t ReadU64(const unsigned char* data) {
+    return ReadU32(data) | (static_cast<std::uint64_t>(ReadU32(data + 4)) << 32);
+  }
+
+  void WriteU32(std::vector<unsigned char>& output, std::uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+      output.push_back(static_cast<unsigned char>(value >> (i * 8)));
+    }
+  }
+
+  void WriteU64(std::vector<unsigned char>& output, std::uint64_t value) {
+    WriteU32(output, static_cast<std::uint32_t>(value));
+    WriteU32(output, static_cast<std::uint32_t>(value >> 32));
+  }
+
+  size_t Align(size_t value) {
+    return (value + kPayloadAlignment - 1) / kPayloadAlignment * kPayloadAlignment;
+  }
+
+  /// <summary>
+  /// An asset that has been loaded into memory, ready to be written to an archive.
+  /// </summary>
+  struct PackedAsset {
+    std::string name_;
+    AssetArchive::entry_type type_;
+    int width_;
+    int height_;
+    std::vector<unsigned char> payload_;
+  };
+}
+
+AssetArchive::AssetArchive(const std::string& file_path)
+    : data_(nullptr),
+      size_(0),
+      mapping_handle_(nullptr) {
+#ifdef _WIN32
+  HANDLE file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::ios_base::failure("Cannot find/access \"" + file_path + "\"");
+  }
+
+  LARGE_INTEGER file_size;
+  GetFileSizeEx(file, &file_size);
+  size_ = static_cast<size_t>(file_size.QuadPart);
+
+  mapping_handle_ = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  // The mapping keeps the file open, so the file handle is no longer needed.
+  CloseHandle(file);
+
+  if (mapping_handle_) {
+    data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+  }
+#else
+  int file = open(file_path.c_str(), O_RDONLY);
+
+  if (file < 0) {
+    throw std::ios_base::failure("Cannot find/access \"" + file_path + "\"");
+  }
+
+  struct stat file_stat;
+  fstat(file, &file_stat);
+  size_ = static_cast<size_t>(file_stat.st_size);
+
+  void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+  // The mapping keeps the file open, so the descriptor is no longer needed.
+  close(file);
+
+  if (mapping != MAP_FAILED) {
+    data_ = static_cast<const unsigned char*>(mapping);
+  }
+#endif
+
+  if (!data_) {
+    Unmap();
+    throw std::ios_base::failure("Cannot map \"" + file_path + "\"");
+  }
+
+  try {
+    ReadIndex();
+  } catch (const std::exception&) {
+    Unmap();
+    throw;
+  }
+}
+
+AssetArchive::~AssetArchive() {
+  Unmap();
+}
+
+void AssetArchive::Unmap() {
+#ifdef _WIN32
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+
+  if (mapping_handle_) {
+    CloseHandle(mapping_handle_);
+  }
+#else
+  if (data_) {
+    munmap(const_cast<unsigned char*>(data_), size_);
+  }
+#endif
+
+  data_ = nullptr;
+  mapping_handle_ = nullptr;
+}
+
+void AssetArchive::ReadIndex() {
+  if (size_ < kHeaderSize || std::memcmp(data_, kMagic, sizeof(kMagic)) != 0 || ReadU32(data_ + 4) != kVersion) {
+    throw std::ios_base::failure("Asset archive is not a supported archive");
+  }
+
+  const std::uint32_t entry_count = ReadU32(data_ + 8);
+
+  if (size_ < kHeaderSize + static_cast<std::uint64_t>(entry_count) * kIndexRecordSize) {
+    throw std::ios_base::failure("Asset archive index is truncated");
+  }
+
+  entries_.reserve(entry_count);
+
+  for (std::uint32_t i = 0; i < entry_count; i++) {
+    const unsigned char* record = data_ + kHeaderSize + i * kIndexRecordSize;
+    const std::uint64_t name_offset = ReadU32(record);
+    const std::uint64_t name_length = ReadU32(record + 4);
+    const std::uint64_t payload_offset = ReadU64(record + 24);
+    const std::uint64_t payload_size = ReadU64(record + 32);
+
+    // Every name and payload must lie within the archive.
+    if (name_offset + name_length > size_ || payload_offset + payload_size > size_) {
+      throw std::ios_base::failure("Asset archive entry is out of bounds");
+    }
+
+    Entry entry {
+      std::string(reinterpret_cast<const char*>(data_ + name_offset), static_cast<size_t>(name_length)),
+      static_cast<entry_type>(ReadU32(record + 8)),
+      static_cast<int>(ReadU32(record + 12)),
+      static_cast<int>(ReadU32(record + 16)),
+      data_ + payload_offset,
+      static_cast<size_t>(payload_size)
+    };
+
+    if (entry.type_ == entry_type::image &&
+        static_cast<std::uint64_t>(entry.width_) * entry.height_ * 4 != payload_size) {
+      throw std::ios_base::failure("Asset archive image \"" + entry.name_ + "\" has an invalid size");
+    }
+
+    entries_.push_back(entry);
+  }
+}
+
+unsigned int AssetArchive::Pack(const std::string& assets_path, const std::string& file_path) {
+  std::vector<PackedAsset> assets;
+
+  // Loads every image, font and text file, keyed in the same form the game requests them.
+  for (auto& dir_entry : std::filesystem::recursive_directory_iterator(assets_path)) {
+    const auto extension = dir_entry.path().extension();
+
+    if (!dir_entry.is_regular_file() || (extension != ".png" && extension != ".ttf" && extension != ".txt")) {
+      continue;
+    }
+
+    PackedAsset asset {dir_entry.path().lexically_relative(assets_path).string(), entry_type::file, 0, 0, {}};
+    std::replace(asset.name_.begin(), asset.name_.end(), '/', '\\');
+
+    if (extension == ".png") {
+      SDL_Surface* loaded = IMG_Load(dir_entry.path().string().c_str());
+      // Decodes to the format that the archive stores, so loading requires no conversion.
+      SDL_Surface* converted = loaded ? SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0) : nullptr;
+      SDL_FreeSurface(loaded);
+
+      if (!converted) {
+        throw std::ios_base::failure("Cannot decode \"" + dir_entry.path().string() + "\"");
+      }
+
+      asset.type_ = entry_type::image;
+      asset.width_ = converted->w;
+      asset.height_ = converted->h;
+      asset.payload_.reserve(static_cast<size_t>(converted->w) * converted->h * 4);
+
+      // Stores each pixel as a little-endian word, removing any row padding.
+      for (int y = 0; y < converted->h; y++) {
+        auto row = reinterpret_cast<const std::uint32_t*>(static_cast<const unsigned char*>(converted->pixels) + y * converted->pitch);
+
+        for (int x = 0; x < converted->w; x++) {
+          WriteU32(asset.payload_, row[x]);
+        }
+      }
+
+      SDL_FreeSurface(converted);
+    } else {
+      std::ifstream input(dir_entry.path(), std::ios::binary);
+
+      if (input.fail()) {
+        throw std::ios_base::failure("Cannot find/access \"" + dir_entry.path().string() + "\"");
+      }
+
+      asset.payload_.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+
+    assets.push_back(std::move(asset));
+  }
+
+  // Sorted so that the index can be searched, and so identical assets always produce identical archives.
+  std::sort(assets.begin(), assets.end(), [](const PackedAsset& a, const PackedAsset& b) {
+    return a.name_ < b.name_;
+  });
+
+  // Lays out the header, index and names, followed by the aligned payloads.
+  std::vector<unsigned char> output(kMagic, kMagic + sizeof(kMagic));
+  WriteU32(output, kVersion);
+  WriteU32(output, static_cast<std::uint32_t>(assets.size()));
+
+  size_t name_offset = kHeaderSize + assets.size() * kIndexRecordSize;
+  size_t payload_offset = name_offset;
+
+  for (auto& asset : assets) {
+    payload_offset += asset.name_.size();
+  }
+
+  for (auto& asset : assets) {
+    payload_offset = Align(payload_offset);
+
+    WriteU32(output, static_cast<std::uint32_t>(name_offset));
+    WriteU32(output, static_cast<std::uint32_t>(asset.name_.size()));
+    WriteU32(output, static_cast<std::uint32_t>(asset.type_));
+    WriteU32(output, static_cast<std::uint32_t>(asset.width_));
+    WriteU32(output, static_cast<std::uint32_t>(asset.height_));
+    // Pads the record so that the 64-bit fields are aligned.
+    WriteU32(output, 0);
+    WriteU64(output, payload_offset);
+    WriteU64(output, asset.payload_.size());
+
+    name_offset += asset.name_.size();
+    payload_offset += asset.payload_.size();
+  }
+
+  for (auto& asset : assets) {
+    output.insert(output.end(), asset.name_.begin(), asset.name_.end());
+  }
+
+  for (auto& asset : assets) {
+    output.resize(Align(output.size()), 0);
+    output.insert(output.end(), asset.payload_.begin(), asset.payload_.end());
+  }
+
+  std::ofstream archive(file_path, std::ios::binary);
+  archive.write(reinterpret_cast<const char*>(output.data()), output.size());
+
+  if (archive.fail()) {
+    throw std::ios_base::failure("Cannot create \"" + file_path + "\"");
+  }
+
+  return static_cast<unsigned int>(assets.size());
+}
+
+const AssetArchive::Entry* AssetArchive::Find(const std::string& name) const {
+  auto entry = std::lower_bound(entries_.begin(), entries_.end(), name, [](const Entry& e, const std::string& n) {
+    return e.name_ < n;
+  });
+
+  return (entry != entries_.end() && entry->name_ == name) ? &*entry : nullptr;
+}
+
+const std::vector<AssetArchive::Entry>& AssetArchive::entries() const {
+  return entries_;
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/// <summary>
+/// A read-only, memory-mapped archive holding every game asset in a single file.
+/// Images are stored pre-decoded as ARGB8888 pixels, so textures can be created from the archive
+/// without any decoding. Other files, such as the font and map structure, are stored unchanged.
+///
+/// The archive consists of a header, an index of entries sorted by name, the entry names, and
+/// the payloads. All integers are little-endian, and payloads are aligned to 16 bytes.
+/// </summary>
+class AssetArchive {
+ public:
+  /// <summary>
+  /// The kinds of payload stored in the archive.
+  ///
+  /// image is a pre-decoded image, stored as rows of little-endian ARGB8888 pixels with no padding.
+  /// file is a file stored byte for byte.
+  /// </summary>
+  enum class entry_type : std::uint32_t {image, file};
+  /// <summary>
+  /// A single asset in the archive.
+  /// </summary>
+  struct Entry {
+    /// <summary>
+    /// The path of the asset relative to the "assets" folder, using the separators used by the game.
+    /// </summary>
+    std::string name_;
+    /// <summary>
+    /// The kind of payload.
+    /// </summary>
+    entry_type type_;
+    /// <summary>
+    /// The width of an image in pixels. Zero for files.
+    /// </summary>
+    int width_;
+    /// <summary>
+    /// The height of an image in pixels. Zero for files.
+    /// </summary>
+    int height_;
+    /// <summary>
+    /// The payload, which points into the mapped archive.
+    /// </summary>
+    const unsigned char* data_;
+    /// <summary>
+    /// The size of the payload in bytes.
+    /// </summary>
+    size_t size_;
+  };
+  /// <summary>
+  /// Constructor for the AssetArchive class. Maps the archive into memory and reads its index.
+  /// Throws if the archive cannot be opened or is malformed.
+  /// </summary>
+  /// <param name="file_path">The path of the archive.</param>
+  AssetArchive(const std::string& file_path);
+  /// <summary>
+  /// Destructor for the AssetArchive class.
+  /// Unmaps the archive. Payloads must no longer be in use.
+  /// </summary>
+  ~AssetArchive(void);
+  /// <summary>
+  /// Packs the images, fonts and text files in a folder into an archive.
+  /// Images are decoded with SDL_image, which must be initialised.
+  /// Throws if a file cannot be read or the archive cannot be written.
+  /// </summary>
+  /// <param name="assets_path">The path of the folder to pack, ending with a separator.</param>
+  /// <param name="file_path">The path of the archive to write.</param>
+  /// <returns>The number of entries written.</returns>
+  static unsigned int Pack(const std::string& assets_path, const std::string& file_path);
+  /// <summary>
+  /// Finds an entry by name.
+  /// </summary>
+  /// <param name="name">The path of the asset relative to the "assets" folder.</param>
+  /// <returns>The entry, or nullptr if the archive does not contain it.</returns>
+  const Entry* Find(const std::string& name) const;
+  /// <summary>
+  /// Gets every entry in the archive, sorted by name.
+  /// </summary>
+  /// <returns>The entries in the archive.</returns>
+  const std::vector<Entry>& entries(void) const;
+  /// <summary>
+  /// The name of the archive file within the "assets" folder.
+  /// </summary>
+  static const char* kFileName;
+
+ private:
+  /// <summary>
+  /// Copy constructor for the AssetArchive class.
+  /// </summary>
+  /// <param name="reference">The AssetArchive reference to copy.</param>
+  AssetArchive(AssetArchive const& reference);
+  /// <summary>
+  /// Reads and validates the index of the mapped archive.
+  /// </summary>
+  void ReadIndex(void);
+  /// <summary>
+  /// Unmaps the archive, if it is mapped.
+  /// </summary>
+  void Unmap(void);
+  /// <summary>
+  /// The first byte of the mapped archive.
+  /// </summary>
+  const unsigned char* data_;
+  /// <summary>
+  /// The size of the mapped archive in bytes.
+  /// </summary>
+  size_t size_;
+  /// <summary>
+  /// The platform handle of the file mapping, needed to unmap it on Windows.
+  /// </summary>
+  void* mapping_handle_;
+  /// <summary>
+  /// The entries in the archive, sorted by name.
+  /// </summary>
+  std::vector<Entry> entries_;
+};
\ No newline at end of file
@@ -5,28 +5,31 @@
 #include "Avatar.h"
 #include "MovableGameEntity.h"
 
-#include <sstream>
+#include <cstdio>
 
+#include "Drawer.h"
 #include "Timer.h"
 #include "Vector2.h"
 #include "World.h"
 #include "Tile.h"
 
 Avatar::Avatar(Vector2<float> initial_position)
-	: MovableGameEntity(initial_position, .25f),
+	: MovableGameEntity(initial_position, 250),
 	  mouth_open_(false),
 	  ghosts_caught_in_row_(0),
 	  mouth_timer_(Timer(80, true)) {
 	direction_ = Vector2<char>::left;
+	draw_layer_ = DrawLayer::avatar;
 }
 
 
 void Avatar::Update(unsigned int elapsed_millis, const World* world) {
 	// Updates position if the Avatar is not stationary.
 	if (direction_ != Vector2<char>::zero) {
-		UpdatePosition(elapsed_millis);
+		UpdatePosition(elapsed_millis, world);
 		mouth_timer_.Resume();
 	} else {
+		HoldPosition();
 		mouth_timer_.Pause();
 	}
 
@@ -44,40 +47,33 @@ void Avatar::UpdateImage() {
 	if (update_image_flag_) {
 		update_image_flag_ = false;
 
-		std::stringstream result;
-
-		result << "Avatar\\";
-
-		if (!mouth_open_ || direction_ == Vector2<char>::zero) {
-			result << "Closed";
-		}
-		else {
-			result << "Open-";
-
+		const char* image_name = "Closed";
 
+		if (mouth_open_ && direction_ != Vector2<char>::zero) {
 			if (direction_ == Vector2<char>::up) {
-				result << "Up";
+				image_name = "Open-Up";
 			} else if (direction_ == Vector2<char>::down) {
-				result << "Down";
+				image_name = "Open-Down";
 			} else if (direction_ == Vector2<char>::left) {
-				result << "Left";
+				image_name = "Open-Left";
 			} else if (direction_ == Vector2<char>::right) {
-				result << "Right";
+				image_name = "Open-Right";
 			}
 		}
-		result << ".png";
 
-		set_image_file_path(result.str());
+		// Formats the path into a fixed buffer, so changing the image does not allocate.
+		char path[32];
+		std::snprintf(path, sizeof(path), "Avatar\\%s.png", image_name);
+
+		set_image_file_path(path);
 	}
 }
 
 void Avatar::UpdateNextTile(const World* world) {
 	if (CheckIsAtDestination()) {
-		Vector2<unsigned char> next_tile = World::GetTileInDirection(current_tile_, direction_);
-
 		// Continues movement in current direction if unblocked, else the Avatar is set to stationary.
-		if (world->CheckTileValidity(next_tile, Tile::block_type::no_block)) {
-			next_tile_ = next_tile;
+		if (world->GetExitMask(current_tile_, Tile::block_type::no_block) & World::GetDirectionBit(direction_)) {
+			next_tile_ = World::GetTileInDirection(current_tile_, direction_);
 		} else {
 			direction_ = Vector2<char>::zero;
 		}
@@ -88,7 +84,7 @@ void Avatar::set_direction(Vector2<char> new_direction, const World* world) {
 	// Prevents update if it's in current direction of travel.
 	if (direction_ != new_direction) {
 		// Prevents direction update if the path in that direction is blocked.
-		if (world->CheckTileValidity(World::GetTileInDirection(next_tile_, new_direction), Tile::block_type::no_block)) {
+		if (world->GetExitMask(next_tile_, Tile::block_type::no_block) & World::GetDirectionBit(new_direction)) {
 			direction_ = new_direction;
 			update_image_flag_ = true;
 		}
@@ -0,0 +1,74 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "CollisionBroadphase.h"
+
+#include <cstring>
+
+#include "LevelArena.h"
+
+namespace {
+  /// <summary>
+  /// The least number of slots in the table, for every entity filed in a frame. Spare slots keep entities
+  /// in different cells from sharing a slot.
+  /// </summary>
+  const unsigned int kSlotsPerEntity = 2;
+}
+
+CollisionBroadphase::CollisionBroadphase()
+    : slot_heads_(nullptr),
+      slot_stamps_(nullptr),
+      next_entities_(nullptr),
+      entity_cells_(nullptr),
+      slot_mask_(0),
+      max_entity_count_(0),
+      stamp_(0) {}
+
+void CollisionBroadphase::Reserve(LevelArena& arena, unsigned int max_entity_count) {
+  unsigned int slot_count = 1;
+
+  while (slot_count < max_entity_count * kSlotsPerEntity) {
+    slot_count <<= 1;
+  }
+
+  slot_heads_ = static_cast<int*>(arena.Allocate(slot_count * sizeof(int), alignof(int)));
+  slot_stamps_ = static_cast<unsigned int*>(arena.Allocate(slot_count * sizeof(unsigned int), alignof(unsigned int)));
+  next_entities_ = static_cast<int*>(arena.Allocate(max_entity_count * sizeof(int), alignof(int)));
+  entity_cells_ = arena.CreateArray<Vector2<unsigned int>>(max_entity_count);
+
+  // No slot is stamped with a frame yet, so every slot starts empty.
+  std::memset(slot_stamps_, 0, slot_count * sizeof(unsigned int));
+
+  slot_mask_ = slot_count - 1;
+  max_entity_count_ = max_entity_count;
+  stamp_ = 0;
+}
+
+void CollisionBroadphase::Clear() {
+  stamp_++;
+}
+
+void CollisionBroadphase::Insert(unsigned int index, Vector2<TileCoordinate> tile) {
+  if (index >= max_entity_count_) {
+    return;
+  }
+
+  const Vector2<unsigned int> cell(tile.x_ / kCellSize, tile.y_ / kCellSize);
+  const unsigned int slot = GetSlot(cell);
+
+  // A slot stamped with an earlier frame holds stale entities, so it is emptied on first use.
+  if (slot_stamps_[slot] != stamp_) {
+    slot_stamps_[slot] = stamp_;
+    slot_heads_[slot] = -1;
+  }
+
+  entity_cells_[index] = cell;
+  next_entities_[index] = slot_heads_[slot];
+  slot_heads_[slot] = static_cast<int>(index);
+}
+
+unsigned int CollisionBroadphase::GetSlot(Vector2<unsigned int> cell) const {
+  // Mixes the coordinates with large odd multipliers, so neighbouring cells spread across the table.
+  return (cell.x_ * 73856093u ^ cell.y_ * 19349663u) & slot_mask_;
+}
\ No newline at end of file
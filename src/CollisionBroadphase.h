@@ -0,0 +1,132 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include "Vector2.h"
+#include "TileCoordinate.h"
+
+class LevelArena;
+
+/// <summary>
+/// Finds the entities that may be in contact with an entity, from the tiles that they occupy.
+/// Entities are filed under the cell of tiles that holds their current tile each frame, and a query only
+/// visits the cells close enough for contact, so its cost depends on how many entities are nearby rather
+/// than in total. Cells are hashed into a table sized for the entities rather than the map, so a grid for
+/// the largest maps takes no more memory than one for the smallest.
+/// Filing and querying never allocate, and a new frame does not need the table to be cleared.
+/// </summary>
+class CollisionBroadphase {
+ public:
+  /// <summary>
+  /// Constructor for the CollisionBroadphase class. The table has no slots until Reserve is called.
+  /// </summary>
+  CollisionBroadphase(void);
+  /// <summary>
+  /// Reserves the table in the level arena. The storage lives until the arena is released.
+  /// </summary>
+  /// <param name="arena">The arena that the table is reserved in.</param>
+  /// <param name="max_entity_count">The greatest number of entities filed in a frame.</param>
+  void Reserve(LevelArena& arena, unsigned int max_entity_count);
+  /// <summary>
+  /// Starts a new frame, forgetting the entities filed in the previous frame.
+  /// </summary>
+  void Clear(void);
+  /// <summary>
+  /// Files an entity under the cell that holds the tile it occupies. Entities beyond the capacity are ignored.
+  /// </summary>
+  /// <param name="index">The index of the entity, which queries report it by.</param>
+  /// <param name="tile">The current tile of the entity.</param>
+  void Insert(unsigned int index, Vector2<TileCoordinate> tile);
+  /// <summary>
+  /// Visits every entity filed under a tile that is close enough to the given tile for contact.
+  /// An entity lies within a tile of its current tile over a frame, and contact is closer than a tile,
+  /// so the cells holding the tiles up to two away in each direction are visited. Each entity is visited once.
+  /// </summary>
+  /// <param name="tile">The current tile of the entity that contact is tested for.</param>
+  /// <param name="visit">Called with the index of each nearby entity.</param>
+  template <typename Visitor>
+  void ForEachNear(Vector2<TileCoordinate> tile, Visitor visit) const;
+
+ private:
+  /// <summary>
+  /// Copy constructor for the CollisionBroadphase class.
+  /// </summary>
+  /// <param name="reference">The CollisionBroadphase reference to copy.</param>
+  CollisionBroadphase(CollisionBroadphase const& reference);
+  /// <summary>
+  /// Gets the slot of the table that a cell is filed in.
+  /// </summary>
+  /// <param name="cell">The position of the cell, in cells.</param>
+  /// <returns>The index of the slot.</returns>
+  unsigned int GetSlot(Vector2<unsigned int> cell) const;
+  /// <summary>
+  /// The number of tiles along each side of a cell. A query reaches at most two tiles, so it visits at most
+  /// two cells along each axis.
+  /// </summary>
+  static const unsigned int kCellSize = 4;
+  /// <summary>
+  /// The number of tiles in each direction that a query visits.
+  /// </summary>
+  static const int kQueryReach = 2;
+  /// <summary>
+  /// The first entity filed in each slot, or -1 if there is none. Only valid where the slot's stamp is current.
+  /// </summary>
+  int* slot_heads_;
+  /// <summary>
+  /// The frame that each slot's entry in slot_heads_ was written in.
+  /// </summary>
+  unsigned int* slot_stamps_;
+  /// <summary>
+  /// The next entity filed in the same slot as each entity, or -1 if it is the last.
+  /// </summary>
+  int* next_entities_;
+  /// <summary>
+  /// The cell that each entity is filed under. Cells that share a slot are told apart by it.
+  /// </summary>
+  Vector2<unsigned int>* entity_cells_;
+  /// <summary>
+  /// One less than the number of slots, which is a power of two.
+  /// </summary>
+  unsigned int slot_mask_;
+  /// <summary>
+  /// The greatest number of entities filed in a frame.
+  /// </summary>
+  unsigned int max_entity_count_;
+  /// <summary>
+  /// The current frame. Slots stamped with an earlier frame are empty.
+  /// </summary>
+  unsigned int stamp_;
+};
+
+template <typename Visitor>
+void CollisionBroadphase::ForEachNear(Vector2<TileCoordinate> tile, Visitor visit) const {
+  if (max_entity_count_ == 0) {
+    return;
+  }
+
+  // The cells of the tiles up to kQueryReach away, which are never more than two along each axis.
+  const unsigned int first_x = (tile.x_ > kQueryReach ? tile.x_ - kQueryReach : 0) / kCellSize;
+  const unsigned int first_y = (tile.y_ > kQueryReach ? tile.y_ - kQueryReach : 0) / kCellSize;
+  const unsigned int last_x = (tile.x_ + kQueryReach) / kCellSize;
+  const unsigned int last_y = (tile.y_ + kQueryReach) / kCellSize;
+
+  for (unsigned int y = first_y; y <= last_y; y++) {
+    for (unsigned int x = first_x; x <= last_x; x++) {
+      const Vector2<unsigned int> cell(x, y);
+      const unsigned int slot = GetSlot(cell);
+
+      if (slot_stamps_[slot] != stamp_) {
+        continue;
+      }
+
+      for (int index = slot_heads_[slot]; index != -1; index = next_entities_[index]) {
+        // Other cells may share the slot, and their entities are visited with their own cell.
+        if (entity_cells_[index] == cell) {
+          visit(static_cast<unsigned int>(index));
+        }
+      }
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "DistanceFields.h"
+
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "World.h"
+#include "DistanceGrid.h"
+#include "ThreadPool.h"
+
+namespace {
+  /// <summary>
+  /// Gets the position of the lowest set bit of a word.
+  /// </summary>
+  /// <param name="bits">The word, which must have a bit set.</param>
+  /// <returns>The number of clear bits below the lowest set bit.</returns>
+  unsigned int CountTrailingZeros(std::uint64_t bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctzll(bits));
+#endif
+  }
+}
+
+DistanceFields::DistanceFields()
+    : world_(nullptr),
+      row_words_(0) {}
+
+void DistanceFields::Build(const World& world) {
+  world_ = &world;
+  row_words_ = (world.map_width() + kWordBits - 1) / kWordBits + 2;
+
+  const size_t word_count = static_cast<size_t>(row_words_) * (world.map_height() + 2);
+
+  no_block_tiles_.assign(word_count, 0);
+  partial_block_tiles_.assign(word_count, 0);
+
+  for (unsigned int y = 0; y < world.map_height(); y++) {
+    for (unsigned int x = 0; x < world.map_width(); x++) {
+      UpdateTile(Vector2<TileCoordinate>(x, y));
+    }
+  }
+
+  portal_steps_.clear();
+
+  for (const World::Portal& portal : world.portals()) {
+    for (auto direction : {Vector2<char>::up, Vector2<char>::down, Vector2<char>::left, Vector2<char>::right}) {
+      const Vector2<TileCoordinate> from_tile =
+          World::GetTileInDirection(portal.entrance_, Vector2<char>(-direction.x_, -direction.y_));
+      const Vector2<TileCoordinate> to_tile = World::GetTileInDirection(portal.exit_, direction);
+
+      if (from_tile.x_ < world.map_width() && from_tile.y_ < world.map_height() &&
+          to_tile.x_ < world.map_width() && to_tile.y_ < world.map_height()) {
+        portal_steps_.push_back({GetWordIndex(from_tile), 1ull << (from_tile.x_ % kWordBits),
+                                 GetWordIndex(to_tile), 1ull << (to_tile.x_ % kWordBits)});
+      }
+    }
+  }
+}
+
+void DistanceFields::UpdateTile(Vector2<TileCoordinate> tile_position) {
+  if (!world_ || tile_position.x_ >= world_->map_width() || tile_position.y_ >= world_->map_height()) {
+    return;
+  }
+
+  const unsigned int word = GetWordIndex(tile_position);
+  const std::uint64_t bit = 1ull << (tile_position.x_ % kWordBits);
+
+  no_block_tiles_[word] &= ~bit;
+  partial_block_tiles_[word] &= ~bit;
+
+  // A step onto a portal's entrance ends past its exit, so the entrance itself is never reached.
+  if (world_->CheckPortalEntrance(tile_position)) {
+    return;
+  }
+
+  if (world_->CheckTileValidity(tile_position, Tile::block_type::no_block)) {
+    no_block_tiles_[word] |= bit;
+  }
+
+  if (world_->CheckTileValidity(tile_position, Tile::block_type::partial_block)) {
+    partial_block_tiles_[word] |= bit;
+  }
+}
+
+void DistanceFields::Find(const std::vector<Vector2<TileCoordinate>>& source_tiles,
+                          enum Tile::block_type max_valid_block_type, std::vector<DistanceGrid>& grids,
+                          ThreadPool* thread_pool) {
+  grids.resize(source_tiles.size());
+
+  if (!world_ || source_tiles.empty()) {
+    return;
+  }
+
+  // Exits onto fully blocking tiles are never valid, so block is treated the same as partial_block.
+  const std::vector<std::uint64_t>& open_tiles =
+      max_valid_block_type == Tile::block_type::no_block ? no_block_tiles_ : partial_block_tiles_;
+  const unsigned int worker_count = thread_pool ?
+      std::max(1u, std::min(thread_pool->thread_count(), static_cast<unsigned int>(source_tiles.size()))) : 1;
+
+  // Bitsets are left empty by every search, so those sized for an earlier map only need to grow.
+  if (searches_.size() < worker_count) {
+    searches_.resize(worker_count);
+  }
+
+  for (unsigned int i = 0; i < worker_count; i++) {
+    Search& search = searches_[i];
+
+    if (search.visited_.size() < open_tiles.size()) {
+      search.visited_.resize(open_tiles.size(), 0);
+      search.frontier_.resize(open_tiles.size(), 0);
+      search.next_.resize(open_tiles.size(), 0);
+      search.frontier_words_.reserve(open_tiles.size());
+      search.next_words_.reserve(open_tiles.size());
+    }
+  }
+
+  if (worker_count == 1) {
+    for (unsigned int i = 0; i < source_tiles.size(); i++) {
+      SearchFrom(open_tiles, source_tiles[i], searches_[0], grids[i]);
+    }
+
+    return;
+  }
+
+  // Each worker searches every worker_count-th source, so the workers never share a grid or a bitset.
+  for (unsigned int worker = 0; worker < worker_count; worker++) {
+    thread_pool->Submit([&, worker] {
+      for (size_t i = worker; i < source_tiles.size(); i += worker_count) {
+        SearchFrom(open_tiles, source_tiles[i], searches_[worker], grids[i]);
+      }
+    });
+  }
+
+  thread_pool->Wait();
+}
+
+unsigned int DistanceFields::GetWordIndex(Vector2<TileCoordinate> tile_position) const {
+  return (tile_position.y_ + 1) * row_words_ + 1 + tile_position.x_ / kWordBits;
+}
+
+void DistanceFields::SearchFrom(const std::vector<std::uint64_t>& open_tiles, Vector2<TileCoordinate> source_tile,
+                                Search& search, DistanceGrid& grid) const {
+  grid.Reset(world_->map_width(), world_->map_height());
+
+  if (source_tile.x_ >= world_->map_width() || source_tile.y_ >= world_->map_height()) {
+    return;
+  }
+
+  std::fill(search.visited_.begin(), search.visited_.begin() + open_tiles.size(), 0);
+
+  const unsigned int source_word = GetWordIndex(source_tile);
+  const std::uint64_t source_bit = 1ull << (source_tile.x_ % kWordBits);
+
+  search.visited_[source_word] = source_bit;
+  search.frontier_[source_word] = source_bit;
+  search.frontier_words_.assign(1, source_word);
+  grid.GetRow(source_tile.y_)[source_tile.x_] = 0;
+
+  // Adds the bits of tiles beside the frontier to the next level, unless they are blocked or already reached.
+  auto reach = [&](unsigned int word, std::uint64_t bits) {
+    bits &= open_tiles[word] & ~search.visited_[word];
+
+    if (bits) {
+      if (!search.next_[word]) {
+        search.next_words_.push_back(word);
+      }
+
+      search.next_[word] |= bits;
+    }
+  };
+
+  for (unsigned int distance = 1; !search.frontier_words_.empty(); distance++) {
+    search.next_words_.clear();
+
+    for (const PortalStep& step : portal_steps_) {
+      if (search.frontier_[step.from_word_] & step.from_bit_) {
+        reach(step.to_word_, step.to_bit_);
+      }
+    }
+
+    for (unsigned int word : search.frontier_words_) {
+      const std::uint64_t bits = search.frontier_[word];
+
+      search.frontier_[word] = 0;
+
+      // Bit i of a word is the tile i places right of the word's first tile, so shifting left moves right.
+      // The bits shifted out of either end of the word move into the first or last bit of the next word.
+      reach(word, (bits << 1) | (bits >> 1));
+      reach(word + 1, bits >> (kWordBits - 1));
+      reach(word - 1, bits << (kWordBits - 1));
+      reach(word - row_words_, bits);
+      reach(word + row_words_, bits);
+    }
+
+    for (unsigned int word : search.next_words_) {
+      std::uint64_t bits = search.next_[word];
+      unsigned int* distances = grid.GetRow(word / row_words_ - 1) + (word % row_words_ - 1) * kWordBits;
+
+      search.next_[word] = 0;
+      search.visited_[word] |= bits;
+      search.frontier_[word] = bits;
+
+      for (; bits; bits &= bits - 1) {
+        distances[CountTrailingZeros(bits)] = distance;
+      }
+    }
+
+    search.frontier_words_.swap(search.next_words_);
+  }
+}
\ No newline at end of file
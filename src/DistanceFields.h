@@ -0,0 +1,156 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "Tile.h"
+#include "Vector2.h"
+#include "TileCoordinate.h"
+
+class World;
+class DistanceGrid;
+class ThreadPool;
+
+/// <summary>
+/// Finds the distance from source tiles to every tile of the map, by breadth-first searches over bitsets.
+///
+/// The open tiles of the map are packed one bit per tile into rows of 64-bit words, for each block type that
+/// can be moved onto. The frontier of a search is a bitset of the same layout, and each level of the search
+/// expands 64 tiles at once with shifts of a word of the frontier, masked by the words of the open tiles.
+/// Only the words that hold part of the frontier are expanded, so a level costs as much as the frontier
+/// covers rather than the whole map. Steps through portals cannot be made by shifts, so the entrances are
+/// left out of the open tiles and each level also adds the tile past a portal for every tile before it that
+/// the frontier holds. Each source is searched separately, and the searches are shared out between the
+/// workers of a thread pool.
+/// </summary>
+class DistanceFields {
+ public:
+  /// <summary>
+  /// Constructor for the DistanceFields class. No distances are found until Build is called.
+  /// </summary>
+  DistanceFields(void);
+  /// <summary>
+  /// Packs the open tiles of the map into bits, and finds the steps through its portals. Called once the
+  /// World's tiles and portals have been created.
+  /// </summary>
+  /// <param name="world">The World whose tiles are packed. It must outlive any later call.</param>
+  void Build(const World& world);
+  /// <summary>
+  /// Packs the bits of a tile again, after its block type has changed.
+  /// </summary>
+  /// <param name="tile_position">The map coordinates of the tile that changed.</param>
+  void UpdateTile(Vector2<TileCoordinate> tile_position);
+  /// <summary>
+  /// Finds the distance from each source tile to every tile of the map, filling a grid for each source.
+  /// </summary>
+  /// <param name="source_tiles">The map coordinates of the tiles to find the distances from. The distances
+  /// from a tile outside the map are all unreachable.</param>
+  /// <param name="max_valid_block_type">The most blocking tile type that can still be moved onto, as for
+  /// World::GetExitMask.</param>
+  /// <param name="grids">Resized to one grid for each source tile, in the same order.</param>
+  /// <param name="thread_pool">The workers that the searches are shared out between, or null to search
+  /// on the calling thread.</param>
+  void Find(const std::vector<Vector2<TileCoordinate>>& source_tiles, enum Tile::block_type max_valid_block_type,
+            std::vector<DistanceGrid>& grids, ThreadPool* thread_pool);
+
+ private:
+  /// <summary>
+  /// The number of tiles packed into each word.
+  /// </summary>
+  static const unsigned int kWordBits = 64;
+  /// <summary>
+  /// The bitsets and lists of words used by a search, which each worker has its own of.
+  /// </summary>
+  struct Search {
+    /// <summary>
+    /// One bit for each tile, set once the search has reached the tile.
+    /// </summary>
+    std::vector<std::uint64_t> visited_;
+    /// <summary>
+    /// One bit for each tile reached at the current level of the search.
+    /// </summary>
+    std::vector<std::uint64_t> frontier_;
+    /// <summary>
+    /// One bit for each tile first reached at the next level of the search.
+    /// </summary>
+    std::vector<std::uint64_t> next_;
+    /// <summary>
+    /// The indices of the words of the frontier that have bits set.
+    /// </summary>
+    std::vector<unsigned int> frontier_words_;
+    /// <summary>
+    /// The indices of the words of the next level that have bits set.
+    /// </summary>
+    std::vector<unsigned int> next_words_;
+  };
+  /// <summary>
+  /// A step through a portal, from the tile before its entrance to the tile past its exit.
+  /// </summary>
+  struct PortalStep {
+    /// <summary>
+    /// The index of the word that holds the bit of the tile the step starts from.
+    /// </summary>
+    unsigned int from_word_;
+    /// <summary>
+    /// The bit of the tile the step starts from.
+    /// </summary>
+    std::uint64_t from_bit_;
+    /// <summary>
+    /// The index of the word that holds the bit of the tile the step ends on.
+    /// </summary>
+    unsigned int to_word_;
+    /// <summary>
+    /// The bit of the tile the step ends on.
+    /// </summary>
+    std::uint64_t to_bit_;
+  };
+  /// <summary>
+  /// Copy constructor for the DistanceFields class.
+  /// </summary>
+  /// <param name="reference">The DistanceFields reference to copy.</param>
+  DistanceFields(DistanceFields const& reference);
+  /// <summary>
+  /// Gets the index of the word that holds a tile's bit. Words are padded with an empty word on each side
+  /// of every row and an empty row above and below the map, so the neighbours of a word are always words.
+  /// </summary>
+  /// <param name="tile_position">The map coordinates of the tile, which must be in the map.</param>
+  /// <returns>The index of the word.</returns>
+  unsigned int GetWordIndex(Vector2<TileCoordinate> tile_position) const;
+  /// <summary>
+  /// Finds the distance from a source tile to every tile of the map.
+  /// </summary>
+  /// <param name="open_tiles">The bits of the tiles that can be moved onto.</param>
+  /// <param name="source_tile">The map coordinates of the tile to search from.</param>
+  /// <param name="search">The bitsets of the search, which are left empty for the next search.</param>
+  /// <param name="grid">The grid that the distances are stored in.</param>
+  void SearchFrom(const std::vector<std::uint64_t>& open_tiles, Vector2<TileCoordinate> source_tile,
+                  Search& search, DistanceGrid& grid) const;
+  /// <summary>
+  /// The World whose tiles are packed. Null until Build is called.
+  /// </summary>
+  const World* world_;
+  /// <summary>
+  /// The number of words in each row of the bitsets, including the padding on either side.
+  /// </summary>
+  unsigned int row_words_;
+  /// <summary>
+  /// The bits of the tiles that are not blocking, row by row.
+  /// </summary>
+  std::vector<std::uint64_t> no_block_tiles_;
+  /// <summary>
+  /// The bits of the tiles that are at most partially blocking, row by row.
+  /// </summary>
+  std::vector<std::uint64_t> partial_block_tiles_;
+  /// <summary>
+  /// The steps through every portal whose tiles on either side are in the map.
+  /// </summary>
+  std::vector<PortalStep> portal_steps_;
+  /// <summary>
+  /// The searches of each worker. Sized for the most workers used so far, so later searches do not allocate.
+  /// </summary>
+  std::vector<Search> searches_;
+};
\ No newline at end of file
@@ -0,0 +1,44 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "DistanceGrid.h"
+
+#include <algorithm>
+
+DistanceGrid::DistanceGrid()
+    : width_(0),
+      height_(0) {}
+
+void DistanceGrid::Reset(unsigned int width, unsigned int height) {
+  const size_t tile_count = static_cast<size_t>(width) * height;
+
+  width_ = width;
+  height_ = height;
+
+  if (distances_.size() < tile_count) {
+    distances_.resize(tile_count);
+  }
+
+  std::fill(distances_.begin(), distances_.begin() + tile_count, kUnreachable);
+}
+
+unsigned int DistanceGrid::Get(Vector2<TileCoordinate> tile_position) const {
+  if (tile_position.x_ >= width_ || tile_position.y_ >= height_) {
+    return kUnreachable;
+  }
+
+  return distances_[static_cast<size_t>(tile_position.y_) * width_ + tile_position.x_];
+}
+
+unsigned int* DistanceGrid::GetRow(unsigned int y) {
+  return &distances_[static_cast<size_t>(y) * width_];
+}
+
+unsigned int DistanceGrid::width() const {
+  return width_;
+}
+
+unsigned int DistanceGrid::height() const {
+  return height_;
+}
\ No newline at end of file
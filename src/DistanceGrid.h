@@ -0,0 +1,70 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <vector>
+
+#include "Vector2.h"
+#include "TileCoordinate.h"
+
+/// <summary>
+/// The number of steps from a source tile to every tile of the map, such as to guide entities towards the
+/// source from anywhere. Filled by World::GetDistanceFields.
+/// </summary>
+class DistanceGrid {
+ public:
+  /// <summary>
+  /// The distance to a tile that cannot be reached from the source.
+  /// </summary>
+  static const unsigned int kUnreachable = static_cast<unsigned int>(-1);
+  /// <summary>
+  /// Constructor for the DistanceGrid class. The grid has no tiles until Reset is called.
+  /// </summary>
+  DistanceGrid(void);
+  /// <summary>
+  /// Sizes the grid for a map and marks every tile unreachable. The storage only grows, so resetting a grid
+  /// for a map of the same size does not allocate.
+  /// </summary>
+  /// <param name="width">The number of tiles along each row.</param>
+  /// <param name="height">The number of rows.</param>
+  void Reset(unsigned int width, unsigned int height);
+  /// <summary>
+  /// Gets the distance to a tile.
+  /// </summary>
+  /// <param name="tile_position">The map coordinates of the tile.</param>
+  /// <returns>The number of steps from the source to the tile, or kUnreachable if it cannot be reached or is
+  /// outside the map.</returns>
+  unsigned int Get(Vector2<TileCoordinate> tile_position) const;
+  /// <summary>
+  /// Gets the distances of a row of tiles, for the searches that fill the grid.
+  /// </summary>
+  /// <param name="y">The row, which must be less than the height.</param>
+  /// <returns>The distance to each tile of the row, from left to right.</returns>
+  unsigned int* GetRow(unsigned int y);
+  /// <summary>
+  /// Gets the number of tiles along each row.
+  /// </summary>
+  /// <returns>The width of the grid in tiles.</returns>
+  unsigned int width(void) const;
+  /// <summary>
+  /// Gets the number of rows.
+  /// </summary>
+  /// <returns>The height of the grid in tiles.</returns>
+  unsigned int height(void) const;
+
+ private:
+  /// <summary>
+  /// The number of tiles along each row.
+  /// </summary>
+  unsigned int width_;
+  /// <summary>
+  /// The number of rows.
+  /// </summary>
+  unsigned int height_;
+  /// <summary>
+  /// The distance to each tile, row by row.
+  /// </summary>
+  std::vector<unsigned int> distances_;
+};
\ No newline at end of file
@@ -5,64 +5,249 @@
 #include "Drawer.h"
 
 #include <string>
+#include <vector>
+#include <algorithm>
 #include <iostream>
+#include <climits>
 
 #include "SDL_ttf.h"
 #include "SDL_image.h"
 
 #include "Vector2.h"
 #include "ResourceManager.h"
+#include "Profiler.h"
+
+// Text textures and rectangles are ordered after every cached image texture.
+const unsigned int Drawer::kTextTextureIdBase = UINT_MAX / 2;
+
+namespace {
+  /// <summary>
+  /// The character drawn in place of characters that are not in the glyph atlas.
+  /// </summary>
+  const char kReplacementGlyph = '?';
+}
+
+unsigned int Drawer::GlyphIndex(char character) {
+  if (character < kFirstGlyph || character >= kFirstGlyph + static_cast<int>(kGlyphCount)) {
+    character = kReplacementGlyph;
+  }
+
+  return static_cast<unsigned int>(character - kFirstGlyph);
+}
 
 Drawer::Drawer(SDL_Renderer* renderer)
-    : renderer_(renderer) {}
+    : renderer_(renderer),
+      next_text_id_(0),
+      frame_stats_({0, 0}),
+      glyph_font_(nullptr),
+      glyph_atlas_(nullptr),
+      glyphs_({}),
+      glyph_height_(0) {}
+
+Drawer::~Drawer() {
+  if (glyph_atlas_) {
+    SDL_DestroyTexture(glyph_atlas_);
+  }
+}
 
-void Drawer::Draw(const std::string& image_file_path, Vector2<float> position_) const {
+void Drawer::Draw(const std::string& image_file_path, Vector2<float> position_, DrawLayer layer) const {
   // Retrieves texture with the given file name.
-  SDL_Texture* texture = nullptr;
-  int texture_width;
-  int texture_height;
+  const ResourceManager::Texture* texture = nullptr;
 
   try {
-    texture = ResourceManager::Instance().GetTexture(image_file_path, renderer_);
+    texture = &ResourceManager::Instance().GetTexture(image_file_path, renderer_);
   }
   catch (const std::exception& e) {
     std::cerr << "Exception: " << e.what() << std::endl;
     exit(EXIT_FAILURE);
   }
 
-  // Retrieves the height and width of the supplied texture.
-  SDL_QueryTexture(texture, nullptr, nullptr, &texture_width, &texture_height);
-  // The dimensions of the texture.
-  SDL_Rect size_rect {0, 0, texture_width, texture_height};
-  // The positioning and dimensions of the image.
-  SDL_Rect pos_rect {static_cast<int>(position_.x_), static_cast<int>(position_.y_),
-                    size_rect.w, size_rect.h};
-
-  // Adds image to the drawing buffer.
-  SDL_RenderCopy(renderer_, texture, &size_rect, &pos_rect);
+  // Adds image to the batch. The dimensions are cached by the ResourceManager.
+  Submit({
+    texture->texture_,
+    texture->id_,
+    layer,
+    false,
+    0,
+    {0, 0, texture->width_, texture->height_},
+    {static_cast<int>(position_.x_), static_cast<int>(position_.y_), texture->width_, texture->height_},
+    {0, 0, 0, 0}
+  });
 }
 
-void Drawer::DrawText(const std::string& text, Vector2<float> position_, SDL_Color colour) const {
-  if (!ResourceManager::Instance().font() || text.empty()) {
+void Drawer::DrawText(const char* text, Vector2<float> position_, SDL_Color colour, DrawLayer layer) const {
+  ScopedTimer timer(ProfileZone::drawer_draw_text);
+
+  TTF_Font* font = ResourceManager::Instance().font();
+
+  if (!font || !text || *text == '\0') {
+    return;
+  }
+
+  // Renders the glyphs the first time text is drawn, and again whenever the active font changes.
+  if (font != glyph_font_) {
+    BuildGlyphAtlas(font);
+  }
+
+  if (!glyph_atlas_) {
     return;
   }
 
-  // Generates high quality text SDL surface from assigned font.
-  if (SDL_Surface* surface = TTF_RenderText_Shaded(ResourceManager::Instance().font(), text.c_str(), colour, {0, 0, 0})) {
-    // Generates high quality SDL texture.
-    if (SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surface)) {
-      // Dimensions of the text.
-      SDL_Rect size_rect{0, 0, surface->w, surface->h};
-      // Positioning and dimensions of the text.
-      SDL_Rect pos_rect{static_cast<int>(position_.x_), static_cast<int>(position_.y_),
-                        size_rect.w, size_rect.h};
-
-      // Adds text to the drawing buffer.
-      SDL_RenderCopy(renderer_, texture, &size_rect, &pos_rect);
-
-      // Frees generated resources.
-      SDL_DestroyTexture(texture);
-      SDL_FreeSurface(surface);
+  const int x = static_cast<int>(position_.x_);
+  const int y = static_cast<int>(position_.y_);
+  int width = 0;
+
+  for (const char* character = text; *character != '\0'; character++) {
+    width += glyphs_[GlyphIndex(*character)].advance_;
+  }
+
+  // Glyphs are rendered without a background, so the black background of shaded text is drawn beneath them.
+  DrawRect({x, y, width, glyph_height_}, {0, 0, 0, 255}, layer);
+
+  int pen_x = x;
+
+  for (const char* character = text; *character != '\0'; character++) {
+    const Glyph& glyph = glyphs_[GlyphIndex(*character)];
+
+    if (*character != ' ' && glyph.source_.w > 0) {
+      // Glyphs are ordered with rectangles, in submission order, so they are drawn over their background.
+      Submit({
+        glyph_atlas_,
+        kTextTextureIdBase + next_text_id_++,
+        layer,
+        true,
+        0,
+        glyph.source_,
+        {pen_x, y, glyph.source_.w, glyph.source_.h},
+        colour
+      });
     }
+
+    pen_x += glyph.advance_;
   }
+}
+
+void Drawer::DrawRect(const SDL_Rect& rect, SDL_Color colour, DrawLayer layer) const {
+  // Rectangles are ordered with text, in submission order, so text can be drawn over a background.
+  Submit({nullptr, kTextTextureIdBase + next_text_id_++, layer, false, 0, {0, 0, 0, 0}, rect, colour});
+}
+
+void Drawer::Flush() {
+  /*
+   * Groups the batch by layer, then by texture within each layer. Images sharing a layer and texture
+   * keep their submission order. Comparing the sequence, rather than sorting stably, avoids the
+   * temporary buffer that a stable sort allocates.
+   */
+  std::sort(batch_.begin(), batch_.end(), [](const Sprite& a, const Sprite& b) {
+    if (a.layer_ != b.layer_) {
+      return a.layer_ < b.layer_;
+    }
+
+    if (a.texture_id_ != b.texture_id_) {
+      return a.texture_id_ < b.texture_id_;
+    }
+
+    return a.sequence_ < b.sequence_;
+  });
+
+  frame_stats_ = {0, 0};
+  const SDL_Texture* bound_texture = nullptr;
+
+  // Rectangles change the draw colour, which is restored afterwards for clearing the screen.
+  SDL_Color clear_colour;
+  SDL_GetRenderDrawColor(renderer_, &clear_colour.r, &clear_colour.g, &clear_colour.b, &clear_colour.a);
+
+  for (auto& sprite : batch_) {
+    if (sprite.texture_ == nullptr) {
+      SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND);
+      SDL_SetRenderDrawColor(renderer_, sprite.colour_.r, sprite.colour_.g, sprite.colour_.b, sprite.colour_.a);
+      SDL_RenderFillRect(renderer_, &sprite.destination_);
+      frame_stats_.draw_calls_++;
+      continue;
+    }
+
+    if (sprite.texture_ != bound_texture) {
+      if (bound_texture) {
+        frame_stats_.texture_switches_++;
+      }
+
+      bound_texture = sprite.texture_;
+    }
+
+    // Glyphs are white in the atlas, and take the colour of their text.
+    if (sprite.tinted_) {
+      SDL_SetTextureColorMod(sprite.texture_, sprite.colour_.r, sprite.colour_.g, sprite.colour_.b);
+    }
+
+    // Adds image to the drawing buffer.
+    SDL_RenderCopy(renderer_, sprite.texture_, &sprite.source_, &sprite.destination_);
+    frame_stats_.draw_calls_++;
+  }
+
+  SDL_SetRenderDrawColor(renderer_, clear_colour.r, clear_colour.g, clear_colour.b, clear_colour.a);
+
+  // The capacity is kept, so steady-state frames do not reallocate the batch.
+  batch_.clear();
+  next_text_id_ = 0;
+}
+
+Drawer::FrameStats Drawer::frame_stats() const {
+  return frame_stats_;
+}
+
+void Drawer::BuildGlyphAtlas(TTF_Font* font) const {
+  if (glyph_atlas_) {
+    SDL_DestroyTexture(glyph_atlas_);
+    glyph_atlas_ = nullptr;
+  }
+
+  glyph_font_ = font;
+  glyph_height_ = TTF_FontHeight(font);
+
+  std::array<SDL_Surface*, kGlyphCount> surfaces {};
+  int atlas_width = 0;
+
+  // Renders each glyph in white, so it can be tinted to any colour when drawn.
+  for (unsigned int i = 0; i < kGlyphCount; i++) {
+    const Uint16 character = static_cast<Uint16>(kFirstGlyph + i);
+    int advance = 0;
+
+    TTF_GlyphMetrics(font, character, nullptr, nullptr, nullptr, nullptr, &advance);
+    surfaces[i] = TTF_RenderGlyph_Blended(font, character, {255, 255, 255, 255});
+
+    const int width = surfaces[i] ? surfaces[i]->w : 0;
+    const int height = surfaces[i] ? std::min(surfaces[i]->h, glyph_height_) : 0;
+
+    glyphs_[i] = {{atlas_width, 0, width, height}, advance};
+    atlas_width += width;
+  }
+
+  // Packs the glyphs side by side, so all text is drawn from a single texture.
+  if (SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, std::max(atlas_width, 1), std::max(glyph_height_, 1), 32,
+                                                          SDL_PIXELFORMAT_ARGB8888)) {
+    for (unsigned int i = 0; i < kGlyphCount; i++) {
+      if (surfaces[i]) {
+        // Copies the glyph's alpha, rather than blending it onto the empty atlas.
+        SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+
+        SDL_Rect destination = glyphs_[i].source_;
+        SDL_BlitSurface(surfaces[i], nullptr, atlas, &destination);
+      }
+    }
+
+    if ((glyph_atlas_ = SDL_CreateTextureFromSurface(renderer_, atlas))) {
+      SDL_SetTextureBlendMode(glyph_atlas_, SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_FreeSurface(atlas);
+  }
+
+  for (auto surface : surfaces) {
+    SDL_FreeSurface(surface);
+  }
+}
+
+void Drawer::Submit(Sprite sprite) const {
+  sprite.sequence_ = static_cast<unsigned int>(batch_.size());
+  batch_.push_back(sprite);
 }
\ No newline at end of file
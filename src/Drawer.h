@@ -5,6 +5,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <array>
 
 #include "SDL_image.h"
 
@@ -12,36 +14,195 @@ template <typename> struct Vector2;
 struct SDL_Renderer;
 struct SDL_Window;
 struct SDL_Surface;
+struct SDL_Texture;
+typedef struct _TTF_Font TTF_Font;
+
+/// <summary>
+/// The layers that images are drawn on. Layers are drawn in ascending order, so images on
+/// later layers appear above images on earlier layers.
+/// </summary>
+enum class DrawLayer : unsigned char {
+  map, items, avatar, ghosts, ui, overlay
+};
 
 /// <summary>
 /// Handles adding images and text to the drawing buffer.
-/// Items in this buffer are then drawn at the end of each frame.
+/// Submissions are batched for the frame and sorted by layer and texture when flushed,
+/// which minimises the number of texture switches made by the renderer.
+/// Text is drawn from an atlas of glyphs rendered once per font, so drawing text does not allocate.
 /// </summary>
 class Drawer {
  public:
+  /// <summary>
+  /// Instrumentation gathered from the most recently flushed frame.
+  /// </summary>
+  struct FrameStats {
+    /// <summary>
+    /// The number of copy calls issued to the renderer.
+    /// </summary>
+    unsigned int draw_calls_;
+    /// <summary>
+    /// The number of times the bound texture changed between consecutive copy calls.
+    /// </summary>
+    unsigned int texture_switches_;
+  };
   /// <summary>
   ///  Constructor for the Drawer class.
   /// </summary>
   /// <param name="renderer">Creates SDL_Surface and SDL_Texture objects from input files.</param>
   Drawer(SDL_Renderer* renderer);
   /// <summary>
-  /// Adds an image to the drawing buffer at the specified position.
+  /// Destructor for the Drawer class.
+  /// Releases the glyph atlas.
+  /// </summary>
+  ~Drawer(void);
+  /// <summary>
+  /// Adds an image to the drawing batch at the specified position.
   /// </summary>
   /// <param name="image_file_path">The file path for the file to draw.</param>
   /// <param name="position">The position to draw the image in pixels.</param>
-  void Draw(const std::string& image_file_path, Vector2<float> position) const;
+  /// <param name="layer">The layer to draw the image on.</param>
+  void Draw(const std::string& image_file_path, Vector2<float> position, DrawLayer layer = DrawLayer::items) const;
   /// <summary>
-  /// Adds text to the drawing buffer at the specified position.
-  /// The default colour for UI text is set to white.
+  /// Adds text to the drawing batch at the specified position, on the UI layer by default.
+  /// The default colour for UI text is set to white. The text is drawn on a black background.
+  /// Characters outside of printable ASCII are drawn as '?'.
   /// </summary>
   /// <param name="text">The text to display.</param>
   /// <param name="position">The position of the text</param>
   /// <param name="colour">The colour of the text.</param>
-  void DrawText(const std::string& text, Vector2<float> position, SDL_Color colour = { 252, 252, 255 }) const;
+  /// <param name="layer">The layer that the text is drawn on.</param>
+  void DrawText(const char* text, Vector2<float> position, SDL_Color colour = { 252, 252, 255 },
+                DrawLayer layer = DrawLayer::ui) const;
+  /// <summary>
+  /// Adds a filled rectangle to the drawing buffer, blended by the colour's alpha.
+  /// </summary>
+  /// <param name="rect">The position and dimensions of the rectangle.</param>
+  /// <param name="colour">The colour of the rectangle.</param>
+  /// <param name="layer">The layer that the rectangle is drawn on.</param>
+  void DrawRect(const SDL_Rect& rect, SDL_Color colour, DrawLayer layer = DrawLayer::ui) const;
+  /// <summary>
+  /// Sorts the frame's batch by layer and texture, and adds it to the drawing buffer.
+  /// Must be called once per frame, before the renderer is presented.
+  /// </summary>
+  void Flush(void);
+  /// <summary>
+  /// Gets the instrumentation for the most recently flushed frame.
+  /// </summary>
+  /// <returns>The draw call and texture switch counts of the last frame.</returns>
+  FrameStats frame_stats(void) const;
 
  private:
+  /// <summary>
+  /// A single image submission waiting in the batch.
+  /// </summary>
+  struct Sprite {
+    /// <summary>
+    /// The texture to copy from. Null if the submission is a filled rectangle.
+    /// </summary>
+    SDL_Texture* texture_;
+    /// <summary>
+    /// Orders textures deterministically within a layer, independent of their addresses.
+    /// </summary>
+    unsigned int texture_id_;
+    /// <summary>
+    /// The layer that the image is drawn on.
+    /// </summary>
+    DrawLayer layer_;
+    /// <summary>
+    /// True if the texture is tinted by the colour when copied, as glyphs are.
+    /// </summary>
+    bool tinted_;
+    /// <summary>
+    /// The position of the submission in the batch. Keeps sprites sharing a layer and texture in submission order.
+    /// </summary>
+    unsigned int sequence_;
+    /// <summary>
+    /// The dimensions of the texture.
+    /// </summary>
+    SDL_Rect source_;
+    /// <summary>
+    /// The positioning and dimensions of the image.
+    /// </summary>
+    SDL_Rect destination_;
+    /// <summary>
+    /// The colour of a filled rectangle or tinted texture.
+    /// </summary>
+    SDL_Color colour_;
+  };
+  /// <summary>
+  /// The position of a glyph in the atlas.
+  /// </summary>
+  struct Glyph {
+    /// <summary>
+    /// The area of the atlas that the glyph occupies.
+    /// </summary>
+    SDL_Rect source_;
+    /// <summary>
+    /// The horizontal distance from the glyph to the next, in pixels.
+    /// </summary>
+    int advance_;
+  };
+  /// <summary>
+  /// Renders every printable ASCII character of a font in white, and packs them into the glyph atlas.
+  /// </summary>
+  /// <param name="font">The font to render.</param>
+  void BuildGlyphAtlas(TTF_Font* font) const;
+  /// <summary>
+  /// Gets the index of a character in the glyph atlas.
+  /// </summary>
+  /// <param name="character">The character.</param>
+  /// <returns>The index of the character, or of '?' if the character is not printable ASCII.</returns>
+  static unsigned int GlyphIndex(char character);
+  /// <summary>
+  /// Adds a sprite to the batch, recording its submission order.
+  /// </summary>
+  /// <param name="sprite">The sprite to add.</param>
+  void Submit(Sprite sprite) const;
+  /// <summary>
+  /// The first character in the glyph atlas.
+  /// </summary>
+  static const char kFirstGlyph = ' ';
+  /// <summary>
+  /// The number of characters in the glyph atlas: the printable ASCII characters.
+  /// </summary>
+  static const unsigned int kGlyphCount = '~' - ' ' + 1;
+  /// <summary>
+  /// The texture identifier assigned to the first text texture or rectangle of each frame.
+  /// </summary>
+  static const unsigned int kTextTextureIdBase;
   /// <summary>
   /// Creates SDL_Surface and SDL_Texture objects from input files.
   /// </summary>
   SDL_Renderer* renderer_;
+  /// <summary>
+  /// The submissions made since the last flush.
+  /// Mutable as submitting an image does not change the observable state of the Drawer.
+  /// </summary>
+  mutable std::vector<Sprite> batch_;
+  /// <summary>
+  /// Identifies the text textures and rectangles in the batch, in submission order.
+  /// </summary>
+  mutable unsigned int next_text_id_;
+  /// <summary>
+  /// The instrumentation for the most recently flushed frame.
+  /// </summary>
+  FrameStats frame_stats_;
+  /// <summary>
+  /// The font that the glyph atlas was rendered from. Null until text is first drawn.
+  /// Mutable as the atlas is a cache, rebuilt when the active font changes.
+  /// </summary>
+  mutable TTF_Font* glyph_font_;
+  /// <summary>
+  /// Every printable ASCII character of the font, side by side in white, which is tinted when drawn.
+  /// </summary>
+  mutable SDL_Texture* glyph_atlas_;
+  /// <summary>
+  /// The position of each character in the glyph atlas.
+  /// </summary>
+  mutable std::array<Glyph, kGlyphCount> glyphs_;
+  /// <summary>
+  /// The height of a line of text in the glyph atlas's font.
+  /// </summary>
+  mutable int glyph_height_;
 };
\ No newline at end of file
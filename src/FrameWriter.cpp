@@ -0,0 +1,186 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "FrameWriter.h"
+
+#include <string>
+#include <vector>
+#include <ios>
+#include <cstring>
+#include <mutex>
+#include <condition_variable>
+
+// Allows a quarter of a second of frames to queue before the game thread waits for the writer.
+const size_t FrameWriter::kMaxQueuedFrames = 15;
+
+FrameWriter::FrameWriter(const std::string& file_path, format format, int width, int height,
+                         unsigned int frame_millis)
+    : file_path_(file_path),
+      file_(file_path, std::ios::binary),
+      format_(format),
+      width_(width),
+      height_(height),
+      closing_(false),
+      write_failed_(false) {
+  // Handle file not accessible error.
+  if (file_.fail()) {
+    throw std::ios_base::failure("Cannot create \"" + file_path + "\"");
+  }
+
+  if (format_ == format::y4m) {
+    // The frame rate is stored as a fraction, so millisecond frame durations are represented exactly.
+    file_ << "YUV4MPEG2 W" << width_ << " H" << height_ << " F1000:" << frame_millis << " Ip A1:1 C444\n";
+
+    if (file_.fail()) {
+      throw std::ios_base::failure("Cannot write \"" + file_path + "\"");
+    }
+
+    output_buffer_.resize(static_cast<size_t>(width_) * height_ * 3);
+  } else {
+    output_buffer_.resize(static_cast<size_t>(width_) * height_ * 4);
+  }
+
+  thread_ = std::thread(&FrameWriter::Run, this);
+}
+
+FrameWriter::~FrameWriter() {
+  Stop();
+}
+
+void FrameWriter::Close() {
+  Stop();
+  file_.close();
+
+  // The stream's error state is kept until it is closed, so a write that failed on the writer thread is seen here.
+  if (write_failed_ || file_.fail()) {
+    throw std::ios_base::failure("Cannot write \"" + file_path_ + "\"");
+  }
+}
+
+FrameWriter::format FrameWriter::FormatFromFilePath(const std::string& file_path) {
+  const std::string extension = ".y4m";
+
+  if (file_path.size() >= extension.size() &&
+      file_path.compare(file_path.size() - extension.size(), extension.size(), extension) == 0) {
+    return format::y4m;
+  }
+
+  return format::raw;
+}
+
+void FrameWriter::Submit(const unsigned char* pixels, int pitch) {
+  std::vector<unsigned int> frame;
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // Applies back-pressure if the writer cannot keep up.
+    frame_written_.wait(lock, [this] { return queued_frames_.size() < kMaxQueuedFrames; });
+
+    // Reuses a buffer that has already been written, if one is available.
+    if (!free_frames_.empty()) {
+      frame.swap(free_frames_.back());
+      free_frames_.pop_back();
+    }
+  }
+
+  frame.resize(static_cast<size_t>(width_) * height_);
+
+  // Copies the frame row by row, removing any row padding.
+  for (int y = 0; y < height_; y++) {
+    std::memcpy(&frame[static_cast<size_t>(y) * width_], pixels + y * pitch, width_ * sizeof(unsigned int));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queued_frames_.push_back(std::move(frame));
+  }
+
+  frame_queued_.notify_one();
+}
+
+void FrameWriter::Stop() {
+  if (!thread_.joinable()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closing_ = true;
+  }
+
+  frame_queued_.notify_one();
+  thread_.join();
+}
+
+void FrameWriter::Run() {
+  std::vector<unsigned int> frame;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+
+      // Returns the previously written frame to the pool.
+      if (!frame.empty()) {
+        free_frames_.push_back(std::move(frame));
+        frame = std::vector<unsigned int>();
+      }
+
+      frame_queued_.wait(lock, [this] { return closing_ || !queued_frames_.empty(); });
+
+      // All queued frames are written before the writer stops.
+      if (queued_frames_.empty()) {
+        return;
+      }
+
+      frame.swap(queued_frames_.front());
+      queued_frames_.pop_front();
+    }
+
+    frame_written_.notify_one();
+
+    // Once a write has failed the file is incomplete, so the remaining frames are not converted.
+    if (!write_failed_) {
+      WriteFrame(frame);
+    }
+  }
+}
+
+void FrameWriter::WriteFrame(const std::vector<unsigned int>& frame) {
+  const size_t pixel_count = frame.size();
+  unsigned char* output = output_buffer_.data();
+
+  if (format_ == format::y4m) {
+    file_ << "FRAME\n";
+
+    unsigned char* y_plane = output;
+    unsigned char* u_plane = output + pixel_count;
+    unsigned char* v_plane = output + pixel_count * 2;
+
+    // Converts to limited range BT.601 YCbCr using integer arithmetic, so conversion is exact on every platform.
+    for (size_t i = 0; i < pixel_count; i++) {
+      const int r = (frame[i] >> 16) & 0xFF;
+      const int g = (frame[i] >> 8) & 0xFF;
+      const int b = frame[i] & 0xFF;
+
+      y_plane[i] = static_cast<unsigned char>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+      u_plane[i] = static_cast<unsigned char>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+      v_plane[i] = static_cast<unsigned char>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+  } else {
+    // Reorders each pixel into R, G, B, A bytes.
+    for (size_t i = 0; i < pixel_count; i++) {
+      output[i * 4] = static_cast<unsigned char>(frame[i] >> 16);
+      output[i * 4 + 1] = static_cast<unsigned char>(frame[i] >> 8);
+      output[i * 4 + 2] = static_cast<unsigned char>(frame[i]);
+      output[i * 4 + 3] = static_cast<unsigned char>(frame[i] >> 24);
+    }
+  }
+
+  file_.write(reinterpret_cast<const char*>(output), output_buffer_.size());
+
+  if (file_.fail()) {
+    write_failed_ = true;
+  }
+}
\ No newline at end of file
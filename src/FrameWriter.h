@@ -0,0 +1,145 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/// <summary>
+/// Writes captured frames to a video stream on a background thread, so that encoding and disk
+/// access do not slow down the game loop.
+/// Frames are written either as raw RGBA bytes or as an uncompressed YUV4MPEG2 (Y4M) stream.
+/// </summary>
+class FrameWriter {
+ public:
+  /// <summary>
+  /// The stream formats that frames can be written in.
+  ///
+  /// raw writes each frame as tightly packed R, G, B, A bytes.
+  /// y4m writes a YUV4MPEG2 stream with full resolution (4:4:4) BT.601 chroma, readable by most video tools.
+  /// </summary>
+  enum class format {raw, y4m};
+  /// <summary>
+  /// Constructor for the FrameWriter class. Opens the output file and starts the writer thread.
+  /// Throws if the file cannot be opened.
+  /// </summary>
+  /// <param name="file_path">The path of the file to write.</param>
+  /// <param name="format">The format of the stream.</param>
+  /// <param name="width">The width of each frame in pixels.</param>
+  /// <param name="height">The height of each frame in pixels.</param>
+  /// <param name="frame_millis">The duration of each frame in milliseconds, recorded in the Y4M header.</param>
+  FrameWriter(const std::string& file_path, format format, int width, int height, unsigned int frame_millis);
+  /// <summary>
+  /// Destructor for the FrameWriter class.
+  /// Writes any frames that are still queued before closing the file. Failed writes are only reported by Close.
+  /// </summary>
+  ~FrameWriter(void);
+  /// <summary>
+  /// Writes any frames that are still queued, then closes the file. No frames may be submitted afterwards.
+  /// Throws if any frame could not be written, such as when the disk is full.
+  /// </summary>
+  void Close(void);
+  /// <summary>
+  /// Determines the stream format from a file path's extension.
+  /// Files ending in ".y4m" are written as Y4M, and all other files as raw RGBA.
+  /// </summary>
+  /// <param name="file_path">The path of the file to write.</param>
+  /// <returns>The format matching the file extension.</returns>
+  static format FormatFromFilePath(const std::string& file_path);
+  /// <summary>
+  /// Copies a frame and queues it to be written.
+  /// Blocks if the writer has fallen too far behind, which bounds the memory used by the queue.
+  /// </summary>
+  /// <param name="pixels">The frame's native-endian ARGB8888 pixels.</param>
+  /// <param name="pitch">The number of bytes between the starts of consecutive rows.</param>
+  void Submit(const unsigned char* pixels, int pitch);
+
+ private:
+  /// <summary>
+  /// Copy constructor for the FrameWriter class.
+  /// </summary>
+  /// <param name="reference">The FrameWriter reference to copy.</param>
+  FrameWriter(FrameWriter const& reference);
+  /// <summary>
+  /// Stops the writer thread once every queued frame has been written. Does nothing if it has already stopped.
+  /// </summary>
+  void Stop(void);
+  /// <summary>
+  /// The body of the writer thread. Converts and writes frames until the writer is closed.
+  /// </summary>
+  void Run(void);
+  /// <summary>
+  /// Converts a frame into the output format and writes it to the file.
+  /// </summary>
+  /// <param name="frame">The tightly packed ARGB8888 frame.</param>
+  void WriteFrame(const std::vector<unsigned int>& frame);
+  /// <summary>
+  /// The maximum number of frames that may wait in the queue.
+  /// </summary>
+  static const size_t kMaxQueuedFrames;
+  /// <summary>
+  /// The path of the output file.
+  /// </summary>
+  const std::string file_path_;
+  /// <summary>
+  /// The output file.
+  /// </summary>
+  std::ofstream file_;
+  /// <summary>
+  /// The format of the stream.
+  /// </summary>
+  const format format_;
+  /// <summary>
+  /// The width of each frame in pixels.
+  /// </summary>
+  const int width_;
+  /// <summary>
+  /// The height of each frame in pixels.
+  /// </summary>
+  const int height_;
+  /// <summary>
+  /// Frames waiting to be written, in submission order.
+  /// </summary>
+  std::deque<std::vector<unsigned int>> queued_frames_;
+  /// <summary>
+  /// Frame buffers that have been written and can be reused, so steady-state capture does not allocate.
+  /// </summary>
+  std::vector<std::vector<unsigned int>> free_frames_;
+  /// <summary>
+  /// Holds a converted frame before it is written to the file.
+  /// Only accessed by the writer thread.
+  /// </summary>
+  std::vector<unsigned char> output_buffer_;
+  /// <summary>
+  /// Guards the queue, the free buffers and the closing flag.
+  /// </summary>
+  std::mutex mutex_;
+  /// <summary>
+  /// Signals the writer thread that a frame has been queued or that the writer is closing.
+  /// </summary>
+  std::condition_variable frame_queued_;
+  /// <summary>
+  /// Signals the game thread that a queued frame has been written.
+  /// </summary>
+  std::condition_variable frame_written_;
+  /// <summary>
+  /// Set when the writer should finish the queue and stop.
+  /// </summary>
+  bool closing_;
+  /// <summary>
+  /// Set by the writer thread when a frame could not be written. Later frames are dropped rather than written.
+  /// Only read once the writer thread has stopped.
+  /// </summary>
+  bool write_failed_;
+  /// <summary>
+  /// The thread that converts and writes frames.
+  /// </summary>
+  std::thread thread_;
+};
\ No newline at end of file
@@ -12,14 +12,15 @@
 
 GameEntity::GameEntity(Vector2<float> position, const std::string& image_file_path)
 		: position_(position * static_cast<float>(PacMan::kTileSize)),
-			image_file_path_(image_file_path) {}
+			image_file_path_(image_file_path),
+			draw_layer_(DrawLayer::items) {}
 
 void GameEntity::Draw(const Drawer* drawer) const {
 	extern const unsigned char kXOffset;
 	extern const unsigned char kYOffset;
 
 	if (!image_file_path_.empty()) {
-		drawer->Draw(image_file_path_, {position_.x_ + kXOffset, position_.y_ + kYOffset});
+		drawer->Draw(image_file_path_, {position_.x_ + kXOffset, position_.y_ + kYOffset}, draw_layer_);
 	}
 }
 
@@ -31,6 +32,6 @@ void GameEntity::set_position(Vector2<float> position) {
 	position_ = position;
 }
 
-void GameEntity::set_image_file_path(const std::string& image_file_path) {
-	image_file_path_ = image_file_path;
+void GameEntity::set_image_file_path(const char* image_file_path) {
+	image_file_path_.assign(image_file_path);
 }
\ No newline at end of file
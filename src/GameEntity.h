@@ -9,6 +9,7 @@
 #include "Vector2.h"
 
 class Drawer;
+enum class DrawLayer : unsigned char;
 
 /// <summary>
 /// Represents an abstract entity within the game.
@@ -37,10 +38,10 @@ class GameEntity {
 	/// <param name="drawer">The drawer that handles adding entity images to the drawing buffer.</param>
 	virtual void Draw(const Drawer* drawer) const;
 	/// <summary>
-	/// Sets the image file path.
+	/// Sets the image file path. Does not allocate, as the capacity for any image path is reserved on construction.
 	/// </summary>
 	/// <param name="image_file_path">The path of the image to be drawn.</param>
-	void set_image_file_path(const std::string& image_file_path);
+	void set_image_file_path(const char* image_file_path);
 
  protected:
 	/// <summary>
@@ -51,4 +52,8 @@ class GameEntity {
 	/// The file path of the image to be drawn.
 	/// </summary>
 	std::string image_file_path_;
+	/// <summary>
+	/// The layer that the entity's image is drawn on.
+	/// </summary>
+	DrawLayer draw_layer_;
 };
\ No newline at end of file
@@ -0,0 +1,637 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "Ghosts.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <array>
+#include <initializer_list>
+#include <utility>
+
+#include "Drawer.h"
+#include "Tile.h"
+#include "World.h"
+#include "Vector2.h"
+#include "Profiler.h"
+#include "LevelArena.h"
+#include "TilePath.h"
+#include "MovableGameEntity.h"
+#include "PacMan.h"
+
+namespace {
+	/// <summary>
+	/// Where a Ghost starts, and the direction it starts in.
+	/// </summary>
+	struct Spawn {
+		/// <summary>
+		/// The starting x-coordinate in tiles.
+		/// </summary>
+		float x_;
+		/// <summary>
+		/// The starting y-coordinate in tiles.
+		/// </summary>
+		float y_;
+		/// <summary>
+		/// The direction travelled in at the start of the game and on resets.
+		/// </summary>
+		Vector2<char> initial_direction_;
+	};
+
+	/// <summary>
+	/// The spawn of each colour of Ghost: red, cyan, pink and orange. Ghost i uses spawn i % 4.
+	/// </summary>
+	const std::array<Spawn, 4> kSpawns {{
+		{14.5f, 10.f, Vector2<char>(-1, 0)},
+		{13.f, 13.f, Vector2<char>(0, -1)},
+		{14.5f, 13.f, Vector2<char>(0, 1)},
+		{16.f, 13.f, Vector2<char>(0, -1)}
+	}};
+
+	/// <summary>
+	/// The colour of red Ghosts, which leave the base by their own destinations.
+	/// </summary>
+	const unsigned char kRed = 0;
+
+	/// <summary>
+	/// The portion of the image paths relating to each colour.
+	/// </summary>
+	const std::array<const char*, 4> kColourPaths {"Red\\", "Cyan\\", "Pink\\", "Orange\\"};
+
+	/// <summary>
+	/// The portion of the image paths relating to each direction: up, down, left and right.
+	/// </summary>
+	const std::array<const char*, 4> kDirectionPaths {"Up_", "Down_", "Left_", "Right_"};
+
+	/// <summary>
+	/// The index of the first vulnerable image, after the images of every colour, direction and wobble.
+	/// </summary>
+	const unsigned short kVulnerableImage = 4 * 4 * 2;
+
+	/// <summary>
+	/// The index of the dead image, after the two vulnerable images.
+	/// </summary>
+	const unsigned short kDeadImage = kVulnerableImage + 2;
+
+	/// <summary>
+	/// Marks a Ghost whose image has not been set, which is not drawn.
+	/// </summary>
+	const unsigned short kNoImage = 0xFFFF;
+
+	/// <summary>
+	/// The number of updates after a path is requested that it is applied, whether or not the path planner was
+	/// quicker. One update gives the planner the rest of the frame, including drawing, to find the path.
+	/// </summary>
+	const unsigned int kPathPlanningTicks = 1;
+
+	/// <summary>
+	/// The greatest number of steps that each of a Ghost's paths holds, so the memory of the paths does not grow
+	/// with the size of the map. A longer path is followed in legs, each planned from the end of the last.
+	/// </summary>
+	const unsigned int kMaxPathSteps = 128;
+
+	/// <summary>
+	/// Formats the path of every Ghost image, in the order that kVulnerableImage and kDeadImage index.
+	/// </summary>
+	/// <returns>The image paths.</returns>
+	std::vector<std::string> BuildImageFilePaths() {
+		std::vector<std::string> paths;
+		char path[48];
+
+		for (auto colour : kColourPaths) {
+			for (auto direction : kDirectionPaths) {
+				for (auto wobble : {"Wobble_0", "Wobble_1"}) {
+					std::snprintf(path, sizeof(path), "Ghosts\\%s%s%s.png", colour, direction, wobble);
+					paths.push_back(path);
+				}
+			}
+		}
+
+		paths.push_back("Ghosts\\Vulnerable\\Wobble_0.png");
+		paths.push_back("Ghosts\\Vulnerable\\Wobble_1.png");
+		paths.push_back("Ghosts\\Dead.png");
+
+		return paths;
+	}
+
+	/// <summary>
+	/// The directions that a Ghost may turn to at a tile, in the order that a random pick indexes them.
+	/// </summary>
+	struct DirectionChoices {
+		/// <summary>
+		/// The number of directions that may be turned to.
+		/// </summary>
+		unsigned int count_;
+		/// <summary>
+		/// The directions that may be turned to, of which the first count_ are valid.
+		/// </summary>
+		std::array<Vector2<char>, 3> directions_;
+	};
+
+	/// <summary>
+	/// The choices for every direction of travel (up, down, left, right) and every exit mask of a tile.
+	/// </summary>
+	typedef std::array<std::array<DirectionChoices, 16>, 4> DirectionChoiceTable;
+
+	/// <summary>
+	/// The index into the choice table of each direction bit. Only the indices of single bits are used.
+	/// </summary>
+	const std::array<unsigned char, 9> kDirectionIndices {0, 0, 1, 0, 2, 0, 0, 0, 3};
+
+	/// <summary>
+	/// Builds the choice table. A Ghost carries on ahead or turns to either side, and only reverses when it cannot.
+	/// </summary>
+	/// <returns>The choice table.</returns>
+	DirectionChoiceTable BuildDirectionChoiceTable() {
+		DirectionChoiceTable table {};
+
+		for (auto reference : {Vector2<char>::up, Vector2<char>::down, Vector2<char>::left, Vector2<char>::right}) {
+			// Ahead, then the lateral directions, which is the order that Ghosts have always picked in.
+			const std::array<Vector2<char>, 3> candidates {
+				reference,
+				Vector2<char>(reference.y_, reference.x_),
+				Vector2<char>(reference.y_ * -1, reference.x_ * -1)
+			};
+
+			for (unsigned int exits = 0; exits < 16; exits++) {
+				DirectionChoices& choices = table[kDirectionIndices[World::GetDirectionBit(reference)]][exits];
+
+				for (auto candidate : candidates) {
+					if (exits & World::GetDirectionBit(candidate)) {
+						choices.directions_[choices.count_++] = candidate;
+					}
+				}
+			}
+		}
+
+		return table;
+	}
+}
+
+const unsigned int Ghosts::kDefaultCount = 4;
+
+const int Ghosts::kSpeedMultiplier = 3;
+const int Ghosts::kSpeed = 150;
+
+const std::vector<std::string> Ghosts::kImageFilePaths = BuildImageFilePaths();
+
+Vector2<TileCoordinate> Ghosts::home_tile_;
+
+std::vector<Vector2<TileCoordinate>> Ghosts::path_destinations_ = {};
+std::vector<Vector2<TileCoordinate>> Ghosts::red_path_destinations_ = {};
+
+Ghosts::Ghosts()
+	: tick_(0),
+	  // Ghosts are made vunerable for 8 seconds.
+	  vulnerable_timer_(Timer(8000, false)),
+	  // Ghosts invert direction every 5 seconds.
+	  invert_timer_(Timer(5000, true)),
+	  // Ghosts invert their wobble state every 150 milliseconds.
+	  wobble_timer_(Timer(150, true)),
+	  invert_direction_flag_(false),
+	  vulnerable_flag_(false),
+	  wobble_flag_(false),
+	  count_(0),
+	  subpixel_positions_(nullptr),
+	  previous_subpixel_positions_(nullptr),
+	  initial_subpixel_positions_(nullptr),
+	  current_tiles_(nullptr),
+	  next_tiles_(nullptr),
+	  directions_(nullptr),
+	  initial_directions_(nullptr),
+	  speeds_(nullptr),
+	  states_(nullptr),
+	  colours_(nullptr),
+	  paths_(nullptr),
+	  planned_paths_(nullptr),
+	  path_due_ticks_(nullptr),
+	  path_targets_(nullptr),
+	  path_requested_flags_(nullptr),
+	  path_continue_flags_(nullptr),
+	  set_path_from_base_flags_(nullptr),
+	  update_image_flags_(nullptr),
+	  image_indices_(nullptr) {}
+
+void Ghosts::Init(LevelArena& arena, unsigned int count, unsigned int max_path_length) {
+	count_ = count;
+
+	subpixel_positions_ = arena.CreateArray<Vector2<int>>(count);
+	previous_subpixel_positions_ = arena.CreateArray<Vector2<int>>(count);
+	initial_subpixel_positions_ = arena.CreateArray<Vector2<int>>(count);
+	current_tiles_ = arena.CreateArray<Vector2<TileCoordinate>>(count);
+	next_tiles_ = arena.CreateArray<Vector2<TileCoordinate>>(count);
+	directions_ = arena.CreateArray<Vector2<char>>(count);
+	initial_directions_ = arena.CreateArray<Vector2<char>>(count);
+	speeds_ = arena.CreateArray<int>(count);
+	states_ = arena.CreateArray<enum state>(count);
+	colours_ = arena.CreateArray<unsigned char>(count);
+	paths_ = arena.CreateArray<TilePath>(count);
+	planned_paths_ = arena.CreateArray<TilePath>(count);
+	path_due_ticks_ = arena.CreateArray<unsigned int>(count);
+	path_targets_ = arena.CreateArray<Vector2<TileCoordinate>>(count);
+	path_requested_flags_ = arena.CreateArray<bool>(count);
+	path_continue_flags_ = arena.CreateArray<bool>(count);
+	set_path_from_base_flags_ = arena.CreateArray<bool>(count);
+	update_image_flags_ = arena.CreateArray<bool>(count);
+	image_indices_ = arena.CreateArray<unsigned short>(count);
+
+	const int tile_subpixels = PacMan::kTileSize * MovableGameEntity::kSubpixelsPerPixel;
+	const unsigned int path_capacity = std::min(max_path_length, kMaxPathSteps);
+
+	for (unsigned int i = 0; i < count_; i++) {
+		const Spawn& spawn = kSpawns[i % kSpawns.size()];
+
+		initial_subpixel_positions_[i] = Vector2<int>(static_cast<int>(spawn.x_ * tile_subpixels),
+		                                              static_cast<int>(spawn.y_ * tile_subpixels));
+		subpixel_positions_[i] = previous_subpixel_positions_[i] = initial_subpixel_positions_[i];
+		current_tiles_[i] = next_tiles_[i] = Vector2<TileCoordinate>(static_cast<TileCoordinate>(spawn.x_),
+		                                                             static_cast<TileCoordinate>(spawn.y_));
+		directions_[i] = initial_directions_[i] = spawn.initial_direction_;
+		speeds_[i] = kSpeed;
+		states_[i] = state::healthy;
+		colours_[i] = static_cast<unsigned char>(i % kSpawns.size());
+		set_path_from_base_flags_[i] = true;
+		update_image_flags_[i] = true;
+		image_indices_[i] = kNoImage;
+
+		paths_[i].Reserve(arena, path_capacity);
+		planned_paths_[i].Reserve(arena, path_capacity);
+	}
+
+	// Each Ghost has at most one path being planned, unless it dies while its path out of the base is planned.
+	path_planner_.Reserve(arena, count);
+
+	// Timers start running, with their full time remaining.
+	for (Timer* timer : {&vulnerable_timer_, &invert_timer_, &wobble_timer_}) {
+		timer->Reset();
+		timer->Resume();
+	}
+
+	vulnerable_flag_ = false;
+	invert_direction_flag_ = false;
+	wobble_flag_ = false;
+}
+
+void Ghosts::AddPathDestination(Vector2<TileCoordinate> tile_position) {
+	path_destinations_.push_back(tile_position);
+}
+
+void Ghosts::AddRedPathDestination(Vector2<TileCoordinate> tile_position) {
+	red_path_destinations_.push_back(tile_position);
+}
+
+void Ghosts::ClearPathDestinations() {
+	path_destinations_.clear();
+	red_path_destinations_.clear();
+}
+
+void Ghosts::set_home_tile(Vector2<TileCoordinate> tile_position) {
+	home_tile_ = tile_position;
+}
+
+void Ghosts::SetPathFromBase(unsigned int index, World* world) {
+	const std::vector<Vector2<TileCoordinate>>& destinations =
+		colours_[index] == kRed ? red_path_destinations_ : path_destinations_;
+
+	SetPath(index, world, destinations[rand() % destinations.size()]);
+}
+
+void Ghosts::SetPath(unsigned int index, World* world, Vector2<TileCoordinate> destination) {
+	// A Ghost on a tile keeps its direction for one more tile while the path is planned, if it can.
+	if (current_tiles_[index] == next_tiles_[index] &&
+		world->GetExitMask(current_tiles_[index], Tile::block_type::partial_block) & World::GetDirectionBit(directions_[index])) {
+		next_tiles_[index] = World::GetTileInDirection(current_tiles_[index], directions_[index]);
+	}
+
+	// The path starts from the tile the Ghost is moving to, past a portal's exit if it is an entrance.
+	const Vector2<TileCoordinate> start = current_tiles_[index] == next_tiles_[index] ? current_tiles_[index] :
+		world->GetStepDestination(current_tiles_[index], Vector2<char>(
+			static_cast<char>(next_tiles_[index].x_ - current_tiles_[index].x_),
+			static_cast<char>(next_tiles_[index].y_ - current_tiles_[index].y_)));
+
+	// Any previous path is abandoned, so the Ghost goes no further than that tile until the path is applied.
+	paths_[index].Reset(start);
+
+	path_planner_.Submit(world, start, destination, &planned_paths_[index]);
+	path_due_ticks_[index] = tick_ + kPathPlanningTicks;
+	path_targets_[index] = destination;
+	path_requested_flags_[index] = true;
+	path_continue_flags_[index] = false;
+}
+
+void Ghosts::ApplyPlannedPaths() {
+	bool planner_finished = false;
+
+	for (unsigned int i = 0; i < count_; i++) {
+		if (!path_requested_flags_[i] || path_due_ticks_[i] > tick_) {
+			continue;
+		}
+
+		if (!planner_finished) {
+			path_planner_.Finish();
+			planner_finished = true;
+		}
+
+		// The planned path's storage becomes the next path to plan into, so applying a path does not copy it.
+		std::swap(paths_[i], planned_paths_[i]);
+		path_requested_flags_[i] = false;
+		// A full path may have been cut short, so the rest is planned once it has been followed.
+		path_continue_flags_[i] = paths_[i].size() == paths_[i].capacity();
+	}
+}
+
+void Ghosts::FinishPaths() {
+	path_planner_.Finish();
+}
+
+void Ghosts::Die(unsigned int index, World* world) {
+	states_[index] = state::dead;
+
+	/*
+	 * Sets a path to the Ghosts' home tile.
+	 * The Ghost is revived upon reaching this tile.
+	 */
+	SetPath(index, world, home_tile_);
+
+	speeds_[index] *= kSpeedMultiplier;
+
+	update_image_flags_[index] = true;
+}
+
+void Ghosts::Revive(unsigned int index, World* world) {
+	speeds_[index] /= kSpeedMultiplier;
+
+	update_image_flags_[index] = true;
+
+	SetPathFromBase(index, world);
+
+	states_[index] = state::healthy;
+}
+
+void Ghosts::PreUpdateHandler(unsigned int elapsed_millis) {
+	if (wobble_timer_.Update(elapsed_millis)) {
+		wobble_flag_ = !wobble_flag_;
+
+		for (unsigned int i = 0; i < count_; i++) {
+			update_image_flags_[i] = true;
+		}
+	}
+
+	// Terminates the vulnerability period early if no Ghosts are vulnerable.
+	bool vulnerable_remaining = false;
+	for (unsigned int i = 0; i < count_; i++) {
+		if (states_[i] == state::vulnerable) {
+			vulnerable_remaining = true;
+			break;
+		}
+	}
+
+	if (vulnerable_timer_.Update(elapsed_millis) || (vulnerable_flag_ && !vulnerable_remaining)) {
+		// Inverts the direction of the Ghosts.
+		invert_direction_flag_ = true;
+		// Bool to reset vulnerable the individual vulnerable flags.
+		vulnerable_flag_ = false;
+		// Resumes the inversion of direction.
+		invert_timer_.Reset();
+		invert_timer_.Resume();
+	} else if (invert_timer_.Update(elapsed_millis)) {
+		invert_direction_flag_ = true;
+	}
+}
+
+void Ghosts::Update(unsigned int elapsed_millis, World* world) {
+	ScopedTimer timer(ProfileZone::ghost_update);
+
+	// Handles the data shared by all Ghosts before the update.
+	PreUpdateHandler(elapsed_millis);
+
+	tick_++;
+	ApplyPlannedPaths();
+
+	for (unsigned int i = 0; i < count_; i++) {
+		UpdateDecision(i, world);
+	}
+
+	/*
+	 * Moves every Ghost. Each move is integer arithmetic on one Ghost's entries of the arrays, so each
+	 * iteration is independent of every other.
+	 */
+	for (unsigned int i = 0; i < count_; i++) {
+		MovableGameEntity::Move(static_cast<int>(elapsed_millis) * speeds_[i], subpixel_positions_[i],
+			previous_subpixel_positions_[i], current_tiles_[i], next_tiles_[i], world);
+	}
+
+	for (unsigned int i = 0; i < count_; i++) {
+		UpdateImage(i);
+	}
+
+	// Handles the data shared by all Ghosts after the update.
+	invert_direction_flag_ = false;
+}
+
+void Ghosts::UpdateDecision(unsigned int index, World* world) {
+	// Ghost invulnerability has ended.
+	if (states_[index] == state::vulnerable && !vulnerable_flag_) {
+		states_[index] = state::healthy;
+		update_image_flags_[index] = true;
+	}
+
+	// Ghost inverts its direction.
+	if (invert_direction_flag_ && paths_[index].empty() && !path_requested_flags_[index] && !path_continue_flags_[index] &&
+		states_[index] != state::dead) {
+		directions_[index] *= -1.f;
+
+		auto temp_tile = current_tiles_[index];
+		current_tiles_[index] = next_tiles_[index];
+		next_tiles_[index] = temp_tile;
+	}
+
+	// The Ghost is currently placed on a tile.
+	if (current_tiles_[index] == next_tiles_[index]) {
+		// If the Ghost has not completed its designated path, continue along it.
+		if (!paths_[index].empty()) {
+			next_tiles_[index] = paths_[index].PopFront(*world);
+
+			directions_[index] = {
+			  next_tiles_[index].x_ - current_tiles_[index].x_,
+				next_tiles_[index].y_ - current_tiles_[index].y_,
+			};
+			// Wait on the tile until the path being planned is applied.
+		} else if (path_requested_flags_[index]) {
+			// Plan the next leg of a path that was cut short, unless it ended at the destination.
+		} else if (path_continue_flags_[index]) {
+			path_continue_flags_[index] = false;
+
+			if (current_tiles_[index] != path_targets_[index]) {
+				SetPath(index, world, path_targets_[index]);
+			}
+			// Revive if the ghost is in a dead state and has reached its home tile.
+		} else if (states_[index] == state::dead && current_tiles_[index] == home_tile_) {
+			Revive(index, world);
+			// Set a path out of the base if the set_path_from_base_ flag is set.
+		} else if (set_path_from_base_flags_[index]) {
+			set_path_from_base_flags_[index] = false;
+			SetPathFromBase(index, world);
+			// Force the Ghost to move in a specific direction if it is valid, or relative to that direction if it is not.
+		} else {
+			directions_[index] = GenerateRandomDirection(current_tiles_[index], directions_[index], world);
+			next_tiles_[index] = World::GetTileInDirection(current_tiles_[index], directions_[index]);
+		}
+	}
+}
+
+void Ghosts::HandleVulnerableEvent() {
+	invert_direction_flag_ = true;
+	vulnerable_flag_ = true;
+
+	vulnerable_timer_.Reset();
+	vulnerable_timer_.Resume();
+
+ /*
+	* Prevents the Ghosts' directions to invert (as a result of the inversion timer reaching zero) for the
+	* duration of the vulnerability period.
+	*/
+	invert_timer_.Pause();
+
+	for (unsigned int i = 0; i < count_; i++) {
+		if (states_[i] != state::dead) {
+			states_[i] = state::vulnerable;
+			update_image_flags_[i] = true;
+		}
+	}
+}
+
+void Ghosts::Reset() {
+ /*
+	* Resets the timers and associated flags that are shared by all Ghosts.
+	*
+	* Note: the vulnerability timer is not reset here; that is because
+	* it is automatically reset upon consuming a power pellet.
+	*/
+	invert_timer_.Reset();
+	wobble_timer_.Reset();
+
+	// Paths being planned are abandoned, once the planner has finished writing them.
+	path_planner_.Finish();
+
+	wobble_flag_ = false;
+	invert_direction_flag_ = false;
+	vulnerable_flag_ = false;
+
+	// Reset the state of each Ghost.
+	for (unsigned int i = 0; i < count_; i++) {
+		Reset(i);
+	}
+}
+
+void Ghosts::Reset(unsigned int index) {
+	const int tile_subpixels = PacMan::kTileSize * MovableGameEntity::kSubpixelsPerPixel;
+
+	// Returns the Ghost back to its initial position, on the tile that contains it.
+	subpixel_positions_[index] = previous_subpixel_positions_[index] = initial_subpixel_positions_[index];
+	current_tiles_[index] = next_tiles_[index] = Vector2<TileCoordinate>(
+		static_cast<TileCoordinate>(subpixel_positions_[index].x_ / tile_subpixels),
+		static_cast<TileCoordinate>(subpixel_positions_[index].y_ / tile_subpixels));
+
+	states_[index] = state::healthy;
+	speeds_[index] = kSpeed;
+	directions_[index] = initial_directions_[index];
+
+	// Any path the Ghost was following, or was having planned, is abandoned.
+	paths_[index].Reset(current_tiles_[index]);
+	set_path_from_base_flags_[index] = true;
+	path_requested_flags_[index] = false;
+	path_continue_flags_[index] = false;
+	update_image_flags_[index] = true;
+
+	UpdateImage(index);
+}
+
+void Ghosts::UpdateImage(unsigned int index) {
+	if (update_image_flags_[index]) {
+		update_image_flags_[index] = false;
+
+		// Images are looked up in a table of every Ghost image, so changing the image does not allocate.
+		const unsigned short wobble = wobble_flag_ ? 0 : 1;
+
+		if (states_[index] == state::dead) {
+			image_indices_[index] = kDeadImage;
+		} else if (states_[index] == state::vulnerable) {
+			image_indices_[index] = kVulnerableImage + wobble;
+		} else {
+			// Ghosts that are not moving up, down or left face right.
+			const Vector2<char> direction = directions_[index];
+			unsigned short direction_index = 3;
+
+			if (direction == Vector2<char>::up) {
+				direction_index = 0;
+			} else if (direction == Vector2<char>::down) {
+				direction_index = 1;
+			} else if (direction == Vector2<char>::left) {
+				direction_index = 2;
+			}
+
+			image_indices_[index] = static_cast<unsigned short>((colours_[index] * 4 + direction_index) * 2 + wobble);
+		}
+	}
+}
+
+void Ghosts::Draw(const Drawer* drawer) const {
+	extern const unsigned char kXOffset;
+	extern const unsigned char kYOffset;
+
+	for (unsigned int i = 0; i < count_; i++) {
+		if (image_indices_[i] == kNoImage) {
+			continue;
+		}
+
+		const Vector2<float> position(static_cast<float>(subpixel_positions_[i].x_) / MovableGameEntity::kSubpixelsPerPixel,
+		                              static_cast<float>(subpixel_positions_[i].y_) / MovableGameEntity::kSubpixelsPerPixel);
+
+		drawer->Draw(kImageFilePaths[image_indices_[i]], {position.x_ + kXOffset, position.y_ + kYOffset},
+			DrawLayer::ghosts);
+	}
+}
+
+unsigned int Ghosts::count() const {
+	return count_;
+}
+
+Vector2<int> Ghosts::subpixel_position(unsigned int index) const {
+	return subpixel_positions_[index];
+}
+
+Vector2<int> Ghosts::previous_subpixel_position(unsigned int index) const {
+	return previous_subpixel_positions_[index];
+}
+
+Vector2<TileCoordinate> Ghosts::current_tile(unsigned int index) const {
+	return current_tiles_[index];
+}
+
+enum Ghosts::state Ghosts::state(unsigned int index) const {
+	return states_[index];
+}
+
+Vector2<char> Ghosts::GenerateRandomDirection(Vector2<TileCoordinate> tile, Vector2<char> reference_direction,
+	const World* world) {
+	// Built on first use, as the direction constants are initialised in an unspecified order at startup.
+	static const DirectionChoiceTable direction_choices = BuildDirectionChoiceTable();
+
+	const unsigned char reference_bit = World::GetDirectionBit(reference_direction);
+
+	// A Ghost that is not moving has nowhere to turn relative to.
+	if (reference_bit == 0) {
+		return reference_direction;
+	}
+
+	// The exits are looked up, so a decision is a bit test and a table lookup, without scanning the tiles.
+	const unsigned char exits = world->GetExitMask(tile, Tile::block_type::no_block);
+	const DirectionChoices& choices = direction_choices[kDirectionIndices[reference_bit]][exits];
+
+	return choices.count_ == 0 ? reference_direction *= -1 : choices.directions_[rand() % choices.count_];
+}
\ No newline at end of file
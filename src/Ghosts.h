@@ -0,0 +1,344 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "Vector2.h"
+#include "TileCoordinate.h"
+#include "Timer.h"
+#include "PathPlanner.h"
+
+class Drawer;
+class World;
+class LevelArena;
+class TilePath;
+
+/// <summary>
+/// Adversaries that can reduce the player's lives if they contact the Avatar,
+/// but can also be a source of points if contacted while they are vulnerable.
+///
+/// Every Ghost is held in one set of arrays - positions, tiles, directions, states, paths and so on - indexed
+/// by Ghost, rather than as an object each. Updates are loops over the arrays without virtual calls, so any
+/// number of Ghosts can be played. A Ghost's colour is data: the first four Ghosts are red, cyan, pink and
+/// orange, and further Ghosts start from the same places and colours in turn.
+/// </summary>
+class Ghosts {
+ public:
+	/// <summary>
+	/// The states of a Ghost.
+	///
+	/// healthy is the default Ghost state - if the Avatar makes contact wuth a Ghost in this state, a life is lost.
+	/// vulnerable means the Ghost can be killed if contact is made with the Avatar.
+	/// dead means the Ghost is dead, and is travelling back to the home bease where it is revived.
+	/// </summary>
+	enum class state : unsigned char {healthy, vulnerable, dead};
+	/// <summary>
+	/// The number of Ghosts in a game unless another number is chosen.
+	/// </summary>
+	static const unsigned int kDefaultCount;
+	/// <summary>
+	/// Constructor for the Ghosts class. There are no Ghosts until Init is called.
+	/// </summary>
+	Ghosts(void);
+	/// <summary>
+	/// Creates the Ghosts of a level in the level arena, where they live until it is released.
+	/// Also restores the timers and flags shared by all Ghosts to their values at startup, so a new game
+	/// plays out the same regardless of any earlier game in the process.
+	/// </summary>
+	/// <param name="arena">The arena that the Ghosts are created in.</param>
+	/// <param name="count">The number of Ghosts.</param>
+	/// <param name="max_path_length">The greatest number of steps in a path. Each Ghost's paths hold this many steps, up to a
+	/// fixed limit beyond which longer paths are followed in legs.</param>
+	void Init(LevelArena& arena, unsigned int count, unsigned int max_path_length);
+	/// <summary>
+	/// Updates every Ghost.
+	/// </summary>
+	/// <param name="elapsed_millis">The number of milliseconds since the last frame update.</param>
+	/// <param name="world">Determines the tile validity for Ghost movement.</param>
+	void Update(unsigned int elapsed_millis, World* world);
+	/// <summary>
+	/// Resets every Ghost upon the player losing a life.
+	/// </summary>
+	void Reset(void);
+	/// <summary>
+	/// Handles the event causing Ghosts to become vulnerable.
+	/// </summary>
+	void HandleVulnerableEvent(void);
+	/// <summary>
+	/// Kills a Ghost. A Ghost dies when it is contacted by the Avatar when it is vulnerable.
+	/// </summary>
+	/// <param name="index">The index of the Ghost.</param>
+	/// <param name="world">Plans the path for the Ghost back to the home tile.</param>
+	void Die(unsigned int index, World* world);
+	/// <summary>
+	/// Blocks until every requested path has been planned. Must be called before the level arena that the
+	/// Ghosts live in is released, or the World that plans their paths is destroyed.
+	/// </summary>
+	void FinishPaths(void);
+	/// <summary>
+	/// Adds the image of every Ghost to the drawing buffer.
+	/// </summary>
+	/// <param name="drawer">Adds the images to the drawing buffer.</param>
+	void Draw(const Drawer* drawer) const;
+	/// <summary>
+	/// Gets the number of Ghosts.
+	/// </summary>
+	/// <returns>The number of Ghosts.</returns>
+	unsigned int count(void) const;
+	/// <summary>
+	/// Gets the position of a Ghost in sub-pixels.
+	/// </summary>
+	/// <param name="index">The index of the Ghost.</param>
+	/// <returns>The position in sub-pixels.</returns>
+	Vector2<int> subpixel_position(unsigned int index) const;
+	/// <summary>
+	/// Gets the position of a Ghost in sub-pixels at the start of the last frame.
+	/// </summary>
+	/// <param name="index">The index of the Ghost.</param>
+	/// <returns>The previous position in sub-pixels.</returns>
+	Vector2<int> previous_subpixel_position(unsigned int index) const;
+	/// <summary>
+	/// Gets the tile that a Ghost is occupying.
+	/// </summary>
+	/// <param name="index">The index of the Ghost.</param>
+	/// <returns>The current tile of the Ghost.</returns>
+	Vector2<TileCoordinate> current_tile(unsigned int index) const;
+	/// <summary>
+	/// Gets the state of a Ghost.
+	/// </summary>
+	/// <param name="index">The index of the Ghost.</param>
+	/// <returns>The state of the Ghost.</returns>
+	enum state state(unsigned int index) const;
+	/// <summary>
+	/// Sets the position of the home tile. Ghosts will be redirected here upon death.
+	/// </summary>
+	/// <param name="home_position">The position of the Ghosts' home tile.</param>
+	static void set_home_tile(Vector2<TileCoordinate> home_position);
+	/// <summary>
+	/// Adds a destination that Ghosts other than red Ghosts may take out of the base.
+	/// </summary>
+	/// <param name="tile_position">The position of the destination tile.</param>
+	static void AddPathDestination(Vector2<TileCoordinate> tile_position);
+	/// <summary>
+	/// Adds a destination that red Ghosts take out of the base.
+	/// </summary>
+	/// <param name="tile_position">The position of the destination tile.</param>
+	static void AddRedPathDestination(Vector2<TileCoordinate> tile_position);
+	/// <summary>
+	/// Removes every path destination, before a map is loaded.
+	/// </summary>
+	static void ClearPathDestinations(void);
+
+ protected:
+	/// <summary>
+	/// Generates a random direction relative to the reference direction. The returned direction will be the direction itself
+	/// or the direction to the left or right of it, if any of these are valid. Else, it will return the only direction remaining -
+	/// the direction pointing iin the reverse direction.
+	/// </summary>
+	/// <param name="tile">The tile that the Ghost is leaving.</param>
+	/// <param name="reference_direction">The direction that candidate directions are relative to.</param>
+	/// <param name="world">Determines whether the directions are valid for the Ghost to travel in.</param>
+	/// <returns>A direction relative to the reference direction.</returns>
+	static Vector2<char> GenerateRandomDirection(Vector2<TileCoordinate> tile, Vector2<char> reference_direction,
+		const World* world);
+
+ private:
+	/// <summary>
+	/// Copy constructor for the Ghosts class.
+	/// </summary>
+	/// <param name="reference">The Ghosts reference to copy.</param>
+	Ghosts(Ghosts const& reference);
+	/// <summary>
+	/// Handles the data shared by all Ghosts before each update.
+	/// </summary>
+	/// <param name="elapsed_millis">The elapsed number of milliseconds since the previous frame update.</param>
+	void PreUpdateHandler(unsigned int elapsed_millis);
+	/// <summary>
+	/// Decides where a Ghost moves next: along its path, out of the base, or in a random direction.
+	/// Ghosts decide in order of their index, as decisions draw random numbers.
+	/// </summary>
+	/// <param name="index">The index of the Ghost.</param>
+	/// <param name="world">Determines which tiles are valid for the Ghost to move to.</param>
+	void UpdateDecision(unsigned int index, World* world);
+	/// <summary>
+	/// Updates the image that represents a Ghost, if it is outdated.
+	/// Updates Ghost wobble movements and the direction the Ghost is facing.
+	/// Also updates the image for the vulnerable and dead Ghost states.
+	/// </summary>
+	/// <param name="index">The index of the Ghost.</param>
+	void UpdateImage(unsigned int index);
+	/// <summary>
+	/// Returns a Ghost to its starting place and state.
+	/// </summary>
+	/// <param name="index">The index of the Ghost.</param>
+	void Reset(unsigned int index);
+	/// <summary>
+	/// Requests a new path for a Ghost to follow to a given destination, which the path planner finds on its
+	/// worker thread. The Ghost keeps its direction for a tile if it can, and the path starts from that tile.
+	/// The path is applied kPathPlanningTicks updates later, and until then the Ghost waits on its tile. A path
+	/// too long for the Ghost's path storage is cut short, and the rest requested once the Ghost reaches its end.
+	/// </summary>
+	/// <param name="index">The index of the Ghost.</param>
+	/// <param name="world">Plans the path.</param>
+	/// <param name="destination">The location of the destination tile.</param>
+	void SetPath(unsigned int index, World* world, Vector2<TileCoordinate> destination);
+	/// <summary>
+	/// Applies every planned path that is due at the current tick, waiting for the path planner if it has not
+	/// finished. Paths are applied in order of Ghost index, so a game plays out the same however long the
+	/// paths take to plan.
+	/// </summary>
+	void ApplyPlannedPaths(void);
+	/// <summary>
+	/// Sets a path for a Ghost out of the base, to a random destination for its colour.
+	/// </summary>
+	/// <param name="index">The index of the Ghost.</param>
+	/// <param name="world">Plans the path.</param>
+	void SetPathFromBase(unsigned int index, World* world);
+	/// <summary>
+	/// Indicates that a Ghost should not be considered dead, and sets the path to exit the base.
+	/// </summary>
+	/// <param name="index">The index of the Ghost.</param>
+	/// <param name="world">Plans the path to exit the base.</param>
+	void Revive(unsigned int index, World* world);
+	/// <summary>
+	/// The default speed of a Ghost in sub-pixels per millisecond.
+	/// </summary>
+	static const int kSpeed;
+	/// <summary>
+	/// The amount that speed is scaled by while a Ghost is in the 'dead' state.
+	/// </summary>
+	static const int kSpeedMultiplier;
+	/// <summary>
+	/// The path of every Ghost image, indexed by colour, direction and wobble, then the vulnerable and dead images.
+	/// </summary>
+	static const std::vector<std::string> kImageFilePaths;
+	/// <summary>
+	/// The tile position that Ghosts must reach in order to revive.
+	/// </summary>
+	static Vector2<TileCoordinate> home_tile_;
+	/// <summary>
+	/// Holds all of the destinations in the map that Ghosts other than red Ghosts can follow upon reset and game start.
+	/// </summary>
+	static std::vector<Vector2<TileCoordinate>> path_destinations_;
+	/// <summary>
+	/// Holds all of the destinations in the map that red Ghosts can follow upon reset and game start.
+	/// </summary>
+	static std::vector<Vector2<TileCoordinate>> red_path_destinations_;
+	/// <summary>
+	/// Finds the Ghosts' paths on a worker thread.
+	/// </summary>
+	PathPlanner path_planner_;
+	/// <summary>
+	/// The number of updates since the Ghosts were created, which planned paths are applied by.
+	/// </summary>
+	unsigned int tick_;
+	/// <summary>
+	/// Manages the timing of the Ghost vulnerabilty period.
+	/// </summary>
+	Timer vulnerable_timer_;
+	/// <summary>
+	/// Manages the timing of the Ghost direction inversion.
+	/// </summary>
+	Timer invert_timer_;
+	/// <summary>
+	/// Manages the timing of the Ghost sprite flipping between two variants, simulating a 'wobble' effect.
+	/// </summary>
+	Timer wobble_timer_;
+	/// <summary>
+	/// Inverts the direction of all Ghosts that are not following a path when set to true.
+	/// </summary>
+	bool invert_direction_flag_;
+	/// <summary>
+	/// Manages the vulnerability state for Ghosts. Corresponds with the timer that tracks vulnerability.
+	/// </summary>
+	bool vulnerable_flag_;
+	/// <summary>
+	/// Manages the appearance of the sprites, allowing them to flip between two different images.
+	/// </summary>
+	bool wobble_flag_;
+	/// <summary>
+	/// The number of Ghosts.
+	/// </summary>
+	unsigned int count_;
+	/// <summary>
+	/// The position of each Ghost in sub-pixels.
+	/// </summary>
+	Vector2<int>* subpixel_positions_;
+	/// <summary>
+	/// The position of each Ghost in sub-pixels at the start of the last frame.
+	/// </summary>
+	Vector2<int>* previous_subpixel_positions_;
+	/// <summary>
+	/// The starting position of each Ghost in sub-pixels.
+	/// </summary>
+	Vector2<int>* initial_subpixel_positions_;
+	/// <summary>
+	/// The tile that each Ghost is occupying.
+	/// </summary>
+	Vector2<TileCoordinate>* current_tiles_;
+	/// <summary>
+	/// The tile that each Ghost is moving towards.
+	/// </summary>
+	Vector2<TileCoordinate>* next_tiles_;
+	/// <summary>
+	/// The direction that each Ghost is moving in.
+	/// </summary>
+	Vector2<char>* directions_;
+	/// <summary>
+	/// The direction that each Ghost travels in at the start of the game and on resets.
+	/// </summary>
+	Vector2<char>* initial_directions_;
+	/// <summary>
+	/// The speed of each Ghost in sub-pixels per millisecond.
+	/// </summary>
+	int* speeds_;
+	/// <summary>
+	/// The state of each Ghost.
+	/// </summary>
+	enum state* states_;
+	/// <summary>
+	/// The colour of each Ghost: 0 for red, 1 for cyan, 2 for pink and 3 for orange.
+	/// </summary>
+	unsigned char* colours_;
+	/// <summary>
+	/// The path that each Ghost must travel.
+	/// </summary>
+	TilePath* paths_;
+	/// <summary>
+	/// The path being planned for each Ghost, which is swapped with its path when it is applied.
+	/// </summary>
+	TilePath* planned_paths_;
+	/// <summary>
+	/// The tick at which each Ghost's planned path is applied.
+	/// </summary>
+	unsigned int* path_due_ticks_;
+	/// <summary>
+	/// The destination of the path that each Ghost is following or having planned.
+	/// </summary>
+	Vector2<TileCoordinate>* path_targets_;
+	/// <summary>
+	/// Signals that a path is being planned for each Ghost.
+	/// </summary>
+	bool* path_requested_flags_;
+	/// <summary>
+	/// Signals that each Ghost's path filled its storage, so another leg towards its destination is planned once
+	/// the Ghost has followed it.
+	/// </summary>
+	bool* path_continue_flags_;
+	/// <summary>
+	/// Signals that each Ghost should exit the base.
+	/// </summary>
+	bool* set_path_from_base_flags_;
+	/// <summary>
+	/// Determines whether the image of each Ghost is outdated.
+	/// </summary>
+	bool* update_image_flags_;
+	/// <summary>
+	/// The index into kImageFilePaths of each Ghost's image, or kNoImage before it is first set.
+	/// </summary>
+	unsigned short* image_indices_;
+};
\ No newline at end of file
@@ -0,0 +1,652 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "HierarchicalPathfinder.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "World.h"
+#include "Tile.h"
+#include "TilePath.h"
+
+namespace {
+  /// <summary>
+  /// Orders the nodes waiting to be expanded so that the heap holds the lowest estimate at its front.
+  /// Equal estimates are ordered by node, so the same query always finds the same path.
+  /// </summary>
+  struct OpenNodeGreater {
+    template <typename OpenNode>
+    bool operator()(const OpenNode& a, const OpenNode& b) const {
+      return a.estimate_ != b.estimate_ ? a.estimate_ > b.estimate_ : a.node_ > b.node_;
+    }
+  };
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder()
+    : world_(nullptr),
+      heuristic_weight_(1),
+      cluster_columns_(0),
+      cluster_rows_(0),
+      edge_count_(0),
+      max_cluster_node_count_(0),
+      goal_exit_distance_(kNone),
+      search_stamp_(0),
+      local_origin_(Vector2<TileCoordinate>::zero),
+      local_start_(Vector2<TileCoordinate>::zero),
+      local_size_(0, 0),
+      local_stamp_(0) {
+  local_stamps_.fill(0);
+}
+
+void HierarchicalPathfinder::Build(const World& world) {
+  world_ = &world;
+  cluster_columns_ = (world.map_width() + kClusterSize - 1) / kClusterSize;
+  cluster_rows_ = (world.map_height() + kClusterSize - 1) / kClusterSize;
+  heuristic_weight_ = world.map_width() * world.map_height() >= kWeightedSearchArea ? kHeuristicWeight : 1;
+
+  nodes_.clear();
+  free_nodes_.clear();
+  edge_count_ = 0;
+  max_cluster_node_count_ = 0;
+  cluster_nodes_.assign(cluster_columns_ * cluster_rows_, std::vector<unsigned int>());
+
+  for (unsigned int cluster = 0; cluster < cluster_nodes_.size(); cluster++) {
+    AddEntrances(cluster, true);
+    AddEntrances(cluster, false);
+  }
+
+  AddPortalTransitions(kNone);
+
+  for (unsigned int cluster = 0; cluster < cluster_nodes_.size(); cluster++) {
+    ConnectCluster(cluster);
+  }
+
+  ReserveSearch();
+}
+
+void HierarchicalPathfinder::UpdateTile(Vector2<TileCoordinate> tile_position) {
+  if (!world_ || tile_position.x_ >= world_->map_width() || tile_position.y_ >= world_->map_height()) {
+    return;
+  }
+
+  const unsigned int cluster = GetCluster(tile_position);
+  const unsigned int column = cluster % cluster_columns_;
+  const unsigned int row = cluster / cluster_columns_;
+
+  // The clusters that share a border with the cluster, whose entrances with it are placed again, and those
+  // joined to it by a step through a portal.
+  std::array<unsigned int, 4 + 4 * World::kMaxPortalCount> neighbours;
+  unsigned int neighbour_count = 0;
+
+  if (row > 0) {
+    neighbours[neighbour_count++] = cluster - cluster_columns_;
+  }
+
+  if (row + 1 < cluster_rows_) {
+    neighbours[neighbour_count++] = cluster + cluster_columns_;
+  }
+
+  if (column > 0) {
+    neighbours[neighbour_count++] = cluster - 1;
+  }
+
+  if (column + 1 < cluster_columns_) {
+    neighbours[neighbour_count++] = cluster + 1;
+  }
+
+  for (const World::Portal& portal : world_->portals()) {
+    for (Vector2<char> direction : World::kStepDirections) {
+      const Vector2<TileCoordinate> tile =
+          World::GetTileInDirection(portal.entrance_, Vector2<char>(-direction.x_, -direction.y_));
+      const Vector2<TileCoordinate> destination = World::GetTileInDirection(portal.exit_, direction);
+
+      if (tile.x_ >= world_->map_width() || tile.y_ >= world_->map_height() ||
+          destination.x_ >= world_->map_width() || destination.y_ >= world_->map_height()) {
+        continue;
+      }
+
+      const unsigned int near_cluster = GetCluster(tile);
+      const unsigned int far_cluster = GetCluster(destination);
+      const unsigned int other_cluster = near_cluster == cluster ? far_cluster :
+                                         far_cluster == cluster ? near_cluster : cluster;
+
+      if (other_cluster != cluster &&
+          std::find(neighbours.begin(), neighbours.begin() + neighbour_count, other_cluster) ==
+              neighbours.begin() + neighbour_count) {
+        neighbours[neighbour_count++] = other_cluster;
+      }
+    }
+  }
+
+  // Removes the cluster's nodes, with the edges across its entrances and through its portals.
+  while (!cluster_nodes_[cluster].empty()) {
+    RemoveNode(cluster_nodes_[cluster].back());
+  }
+
+  // Removes the nodes of the neighbours that were only placed for entrances into the cluster or its portals.
+  for (unsigned int i = 0; i < neighbour_count; i++) {
+    std::vector<unsigned int>& neighbour_nodes = cluster_nodes_[neighbours[i]];
+
+    for (unsigned int j = static_cast<unsigned int>(neighbour_nodes.size()); j-- > 0;) {
+      const Node& node = nodes_[neighbour_nodes[j]];
+      const bool has_entrance = std::any_of(node.edges_.begin(), node.edges_.end(), [](const Edge& edge) {
+        return !edge.intra_cluster_;
+      });
+
+      if (!has_entrance) {
+        RemoveNode(neighbour_nodes[j]);
+      }
+    }
+  }
+
+  // Places the entrances on each border of the cluster, from the cluster on the left of or above it.
+  AddEntrances(cluster, true);
+  AddEntrances(cluster, false);
+
+  if (column > 0) {
+    AddEntrances(cluster - 1, true);
+  }
+
+  if (row > 0) {
+    AddEntrances(cluster - cluster_columns_, false);
+  }
+
+  AddPortalTransitions(cluster);
+  ConnectCluster(cluster);
+
+  for (unsigned int i = 0; i < neighbour_count; i++) {
+    ConnectCluster(neighbours[i]);
+  }
+
+  ReserveSearch();
+}
+
+void HierarchicalPathfinder::FindPath(Vector2<TileCoordinate> from_tile_position,
+                                      Vector2<TileCoordinate> to_tile_position, TilePath& path) {
+  path.Reset(from_tile_position);
+
+  if (!world_ || from_tile_position == to_tile_position ||
+      from_tile_position.x_ >= world_->map_width() || from_tile_position.y_ >= world_->map_height() ||
+      !world_->CheckTileValidity(to_tile_position, Tile::block_type::partial_block) ||
+      world_->CheckPortalEntrance(to_tile_position)) {
+    return;
+  }
+
+  const unsigned int from_cluster = GetCluster(from_tile_position);
+  const unsigned int to_cluster = GetCluster(to_tile_position);
+
+  goal_exit_distance_ = kNone;
+
+  for (const World::Portal& portal : world_->portals()) {
+    goal_exit_distance_ = std::min(goal_exit_distance_, World::GetManhattanDistance(portal.exit_, to_tile_position));
+  }
+
+  // Paths within a cluster are found without the graph, unless they must leave the cluster or a path through a
+  // portal may be shorter.
+  unsigned int best_cost = kNone;
+
+  if (from_cluster == to_cluster) {
+    SearchCluster(from_cluster, from_tile_position);
+    best_cost = GetLocalDistance(to_tile_position);
+
+    if (best_cost != kNone && best_cost <= GetEstimate(from_tile_position, to_tile_position)) {
+      AppendLocalPath(to_tile_position, path);
+      return;
+    }
+  }
+
+  if (++search_stamp_ == 0) {
+    std::fill(cost_stamps_.begin(), cost_stamps_.end(), 0);
+    std::fill(closed_stamps_.begin(), closed_stamps_.end(), 0);
+    std::fill(goal_stamps_.begin(), goal_stamps_.end(), 0);
+    search_stamp_ = 1;
+  }
+
+  // Moves within a cluster are reversible, so the distances from the destination are those to it.
+  SearchCluster(to_cluster, to_tile_position);
+
+  for (unsigned int node : cluster_nodes_[to_cluster]) {
+    const unsigned int distance = GetLocalDistance(nodes_[node].tile_);
+
+    if (distance != kNone) {
+      goal_costs_[node] = distance;
+      goal_stamps_[node] = search_stamp_;
+    }
+  }
+
+  // The search of the graph starts from the nodes that the starting tile reaches within its cluster.
+  open_nodes_.clear();
+  SearchCluster(from_cluster, from_tile_position);
+
+  for (unsigned int node : cluster_nodes_[from_cluster]) {
+    const unsigned int distance = GetLocalDistance(nodes_[node].tile_);
+
+    if (distance != kNone) {
+      costs_[node] = distance;
+      parents_[node] = kNone;
+      cost_stamps_[node] = search_stamp_;
+      open_nodes_.push_back({distance + heuristic_weight_ * GetEstimate(nodes_[node].tile_, to_tile_position), node});
+      std::push_heap(open_nodes_.begin(), open_nodes_.end(), OpenNodeGreater());
+    }
+  }
+
+  unsigned int last_node = kNone;
+
+  while (!open_nodes_.empty()) {
+    const OpenNode open_node = open_nodes_.front();
+
+    // No node left to expand is estimated to lead to a shorter path than the best found.
+    if (open_node.estimate_ >= best_cost) {
+      break;
+    }
+
+    std::pop_heap(open_nodes_.begin(), open_nodes_.end(), OpenNodeGreater());
+    open_nodes_.pop_back();
+
+    const unsigned int node = open_node.node_;
+
+    if (closed_stamps_[node] == search_stamp_) {
+      continue;
+    }
+
+    closed_stamps_[node] = search_stamp_;
+
+    if (goal_stamps_[node] == search_stamp_ && costs_[node] + goal_costs_[node] < best_cost) {
+      best_cost = costs_[node] + goal_costs_[node];
+      last_node = node;
+    }
+
+    for (const Edge& edge : nodes_[node].edges_) {
+      const unsigned int cost = costs_[node] + edge.cost_;
+
+      if (edge.cost_ == kNone || closed_stamps_[edge.node_] == search_stamp_ ||
+          (cost_stamps_[edge.node_] == search_stamp_ && cost >= costs_[edge.node_])) {
+        continue;
+      }
+
+      costs_[edge.node_] = cost;
+      parents_[edge.node_] = node;
+      cost_stamps_[edge.node_] = search_stamp_;
+      open_nodes_.push_back({cost + heuristic_weight_ * GetEstimate(nodes_[edge.node_].tile_, to_tile_position),
+                             edge.node_});
+      std::push_heap(open_nodes_.begin(), open_nodes_.end(), OpenNodeGreater());
+    }
+  }
+
+  // No path through the graph is shorter than the path within the cluster, if there is one.
+  if (last_node == kNone) {
+    if (best_cost != kNone) {
+      SearchCluster(from_cluster, from_tile_position);
+      AppendLocalPath(to_tile_position, path);
+    }
+
+    return;
+  }
+
+  // Refines the path through the nodes into steps between tiles, from the start.
+  node_path_.clear();
+
+  for (unsigned int node = last_node; node != kNone; node = parents_[node]) {
+    node_path_.push_back(node);
+  }
+
+  Vector2<TileCoordinate> tile = from_tile_position;
+
+  for (auto node = node_path_.rbegin(); node != node_path_.rend(); ++node) {
+    AppendSegment(tile, nodes_[*node].tile_, path);
+    tile = nodes_[*node].tile_;
+  }
+
+  AppendSegment(tile, to_tile_position, path);
+}
+
+unsigned int HierarchicalPathfinder::node_count() const {
+  return static_cast<unsigned int>(nodes_.size() - free_nodes_.size());
+}
+
+unsigned int HierarchicalPathfinder::GetCluster(Vector2<TileCoordinate> tile_position) const {
+  return (tile_position.y_ / kClusterSize) * cluster_columns_ + tile_position.x_ / kClusterSize;
+}
+
+unsigned int HierarchicalPathfinder::AddNode(unsigned int cluster, Vector2<TileCoordinate> tile_position) {
+  // A tile in the corner of a cluster may lie beside entrances on two of its borders.
+  for (unsigned int node : cluster_nodes_[cluster]) {
+    if (nodes_[node].tile_ == tile_position) {
+      return node;
+    }
+  }
+
+  unsigned int node;
+
+  if (free_nodes_.empty()) {
+    node = static_cast<unsigned int>(nodes_.size());
+    nodes_.push_back(Node());
+  } else {
+    node = free_nodes_.back();
+    free_nodes_.pop_back();
+  }
+
+  nodes_[node].tile_ = tile_position;
+  nodes_[node].cluster_ = cluster;
+  nodes_[node].edges_.clear();
+  cluster_nodes_[cluster].push_back(node);
+  max_cluster_node_count_ = std::max(max_cluster_node_count_, static_cast<unsigned int>(cluster_nodes_[cluster].size()));
+
+  return node;
+}
+
+void HierarchicalPathfinder::RemoveNode(unsigned int node) {
+  for (const Edge& edge : nodes_[node].edges_) {
+    std::vector<Edge>& edges = nodes_[edge.node_].edges_;
+    const size_t edge_count = edges.size();
+
+    edges.erase(std::remove_if(edges.begin(), edges.end(), [node](const Edge& other) {
+      return other.node_ == node;
+    }), edges.end());
+    edge_count_ -= static_cast<unsigned int>(edge_count - edges.size());
+  }
+
+  std::vector<unsigned int>& cluster_nodes = cluster_nodes_[nodes_[node].cluster_];
+
+  cluster_nodes.erase(std::find(cluster_nodes.begin(), cluster_nodes.end(), node));
+  edge_count_ -= static_cast<unsigned int>(nodes_[node].edges_.size());
+  nodes_[node].edges_.clear();
+  nodes_[node].cluster_ = kNone;
+  free_nodes_.push_back(node);
+}
+
+void HierarchicalPathfinder::AddEdge(unsigned int from_node, unsigned int to_node, unsigned int cost,
+                                     bool intra_cluster) {
+  std::vector<Edge>& edges = nodes_[from_node].edges_;
+  const auto edge = std::find_if(edges.begin(), edges.end(), [&](const Edge& other) {
+    return other.node_ == to_node && other.intra_cluster_ == intra_cluster;
+  });
+
+  if (edge == edges.end()) {
+    edges.push_back({to_node, cost, intra_cluster});
+    edge_count_++;
+  } else if (edge->cost_ == kNone) {
+    edge->cost_ = cost;
+  }
+}
+
+void HierarchicalPathfinder::AddEntrances(unsigned int cluster, bool vertical) {
+  const unsigned int column = cluster % cluster_columns_;
+  const unsigned int row = cluster / cluster_columns_;
+
+  if (vertical ? column + 1 >= cluster_columns_ : row + 1 >= cluster_rows_) {
+    return;
+  }
+
+  const unsigned int neighbour = vertical ? cluster + 1 : cluster + cluster_columns_;
+  // The direction across the border, and the tile on the near side of it at each position along it.
+  const Vector2<char> direction = vertical ? Vector2<char>::right : Vector2<char>::down;
+  const Vector2<char> reverse_direction = vertical ? Vector2<char>::left : Vector2<char>::up;
+  const unsigned int first = (vertical ? row : column) * kClusterSize;
+  const unsigned int last = std::min(first + kClusterSize, vertical ? world_->map_height() : world_->map_width());
+
+  auto get_tile = [&](unsigned int position) {
+    return vertical ? Vector2<TileCoordinate>((column + 1) * kClusterSize - 1, position)
+                    : Vector2<TileCoordinate>(position, (row + 1) * kClusterSize - 1);
+  };
+
+  // True if the tiles on both sides of the border at a position are open, so the border can be crossed both ways.
+  // A portal's entrance on the border leads elsewhere, so it is not crossed.
+  auto is_crossable = [&](unsigned int position) {
+    const Vector2<TileCoordinate> tile = get_tile(position);
+    const Vector2<TileCoordinate> far_tile = World::GetTileInDirection(tile, direction);
+
+    return (world_->GetExitMask(tile, Tile::block_type::partial_block) & World::GetDirectionBit(direction)) &&
+           (world_->GetExitMask(far_tile, Tile::block_type::partial_block) & World::GetDirectionBit(reverse_direction)) &&
+           world_->GetStepDestination(tile, direction) == far_tile &&
+           world_->GetStepDestination(far_tile, reverse_direction) == tile;
+  };
+
+  auto add_transition = [&](unsigned int position) {
+    const Vector2<TileCoordinate> tile = get_tile(position);
+    const unsigned int near_node = AddNode(cluster, tile);
+    const unsigned int far_node = AddNode(neighbour, World::GetTileInDirection(tile, direction));
+
+    AddEdge(near_node, far_node, 1, false);
+    AddEdge(far_node, near_node, 1, false);
+  };
+
+  // Each run of crossable positions is an entrance.
+  for (unsigned int start = first; start < last;) {
+    if (!is_crossable(start)) {
+      start++;
+      continue;
+    }
+
+    unsigned int end = start;
+
+    while (end + 1 < last && is_crossable(end + 1)) {
+      end++;
+    }
+
+    if (end - start + 1 >= kWideEntranceLength) {
+      add_transition(start);
+      add_transition(end);
+    } else {
+      add_transition((start + end) / 2);
+    }
+
+    start = end + 1;
+  }
+}
+
+void HierarchicalPathfinder::AddPortalTransitions(unsigned int cluster) {
+  for (const World::Portal& portal : world_->portals()) {
+    for (unsigned char code = 0; code < World::kStepDirections.size(); code++) {
+      const Vector2<char> direction = World::kStepDirections[code];
+      // The tile that steps onto the entrance, and the tile past the exit that the step ends on.
+      const Vector2<TileCoordinate> tile =
+          World::GetTileInDirection(portal.entrance_, Vector2<char>(-direction.x_, -direction.y_));
+
+      if (!world_->CheckTileValidity(tile, Tile::block_type::partial_block) ||
+          !(world_->GetExitMask(tile, Tile::block_type::partial_block) & (1 << code))) {
+        continue;
+      }
+
+      const Vector2<TileCoordinate> destination = world_->GetStepDestination(tile, direction);
+      const unsigned int near_cluster = GetCluster(tile);
+      const unsigned int far_cluster = GetCluster(destination);
+
+      if (cluster != kNone && cluster != near_cluster && cluster != far_cluster) {
+        continue;
+      }
+
+      const unsigned int near_node = AddNode(near_cluster, tile);
+      const unsigned int far_node = AddNode(far_cluster, destination);
+
+      // The step cannot be taken back, so the edge back is never followed, and only lets the removal of either
+      // node find the edge between them.
+      AddEdge(near_node, far_node, 1, false);
+      AddEdge(far_node, near_node, kNone, false);
+    }
+  }
+}
+
+void HierarchicalPathfinder::ConnectCluster(unsigned int cluster) {
+  const std::vector<unsigned int>& cluster_nodes = cluster_nodes_[cluster];
+
+  // Removes the edges within the cluster, keeping those across its entrances and through its portals.
+  for (unsigned int node : cluster_nodes) {
+    std::vector<Edge>& edges = nodes_[node].edges_;
+    const size_t edge_count = edges.size();
+
+    edges.erase(std::remove_if(edges.begin(), edges.end(), [](const Edge& edge) {
+      return edge.intra_cluster_;
+    }), edges.end());
+    edge_count_ -= static_cast<unsigned int>(edge_count - edges.size());
+  }
+
+  for (unsigned int node : cluster_nodes) {
+    SearchCluster(cluster, nodes_[node].tile_);
+
+    for (unsigned int other_node : cluster_nodes) {
+      const unsigned int distance = GetLocalDistance(nodes_[other_node].tile_);
+
+      if (other_node != node && distance != kNone) {
+        AddEdge(node, other_node, distance, true);
+      }
+    }
+  }
+}
+
+void HierarchicalPathfinder::SearchCluster(unsigned int cluster, Vector2<TileCoordinate> from_tile_position,
+                                           Vector2<TileCoordinate> to_tile_position) {
+  if (++local_stamp_ == 0) {
+    local_stamps_.fill(0);
+    local_stamp_ = 1;
+  }
+
+  local_origin_ = Vector2<TileCoordinate>((cluster % cluster_columns_) * kClusterSize,
+                                          (cluster / cluster_columns_) * kClusterSize);
+  local_start_ = from_tile_position;
+
+  // Clusters on the right and bottom edges of the map are cut short by them.
+  const unsigned int width = world_->map_width() - local_origin_.x_;
+  const unsigned int height = world_->map_height() - local_origin_.y_;
+
+  local_size_ = Vector2<unsigned int>(width < kClusterSize ? width : kClusterSize,
+                                      height < kClusterSize ? height : kClusterSize);
+
+  unsigned int queue_front = 0;
+  unsigned int queue_back = 0;
+  const unsigned int start = (from_tile_position.y_ - local_origin_.y_) * local_size_.x_ +
+                             from_tile_position.x_ - local_origin_.x_;
+
+  local_distances_[start] = 0;
+  local_stamps_[start] = local_stamp_;
+  local_queue_[queue_back++] = start;
+
+  while (queue_front < queue_back) {
+    const unsigned int index = local_queue_[queue_front++];
+    const Vector2<TileCoordinate> tile(local_origin_.x_ + index % local_size_.x_,
+                                       local_origin_.y_ + index / local_size_.x_);
+
+    if (tile == to_tile_position) {
+      return;
+    }
+
+    const unsigned char exits = world_->GetExitMask(tile, Tile::block_type::partial_block);
+
+    for (unsigned char code = 0; code < World::kStepDirections.size(); code++) {
+      if (!(exits & (1 << code))) {
+        continue;
+      }
+
+      const Vector2<TileCoordinate> neighbour = World::GetTileInDirection(tile, World::kStepDirections[code]);
+
+      // Tiles beyond the left and top edges wrap around to large coordinates, so one test covers every edge.
+      const unsigned int x = static_cast<TileCoordinate>(neighbour.x_ - local_origin_.x_);
+      const unsigned int y = static_cast<TileCoordinate>(neighbour.y_ - local_origin_.y_);
+
+      if (x >= local_size_.x_ || y >= local_size_.y_ ||
+          world_->GetStepDestination(tile, World::kStepDirections[code]) != neighbour) {
+        continue;
+      }
+
+      const unsigned int neighbour_index = y * local_size_.x_ + x;
+
+      if (local_stamps_[neighbour_index] == local_stamp_) {
+        continue;
+      }
+
+      local_distances_[neighbour_index] = local_distances_[index] + 1;
+      local_directions_[neighbour_index] = code;
+      local_stamps_[neighbour_index] = local_stamp_;
+      local_queue_[queue_back++] = neighbour_index;
+    }
+  }
+}
+
+unsigned int HierarchicalPathfinder::GetLocalDistance(Vector2<TileCoordinate> tile_position) const {
+  const unsigned int x = static_cast<TileCoordinate>(tile_position.x_ - local_origin_.x_);
+  const unsigned int y = static_cast<TileCoordinate>(tile_position.y_ - local_origin_.y_);
+
+  if (x >= local_size_.x_ || y >= local_size_.y_) {
+    return kNone;
+  }
+
+  const unsigned int index = y * local_size_.x_ + x;
+
+  return local_stamps_[index] == local_stamp_ ? local_distances_[index] : kNone;
+}
+
+void HierarchicalPathfinder::AppendLocalPath(Vector2<TileCoordinate> to_tile_position, TilePath& path) {
+  unsigned int step_count = 0;
+
+  // Follows the directions that each tile was entered by back to the start of the search.
+  for (Vector2<TileCoordinate> tile = to_tile_position; tile != local_start_;) {
+    const unsigned char code = local_directions_[(tile.y_ - local_origin_.y_) * local_size_.x_ + tile.x_ - local_origin_.x_];
+    const Vector2<char> direction = World::kStepDirections[code];
+
+    local_steps_[step_count++] = code;
+    tile = Vector2<TileCoordinate>(tile.x_ - direction.x_, tile.y_ - direction.y_);
+  }
+
+  while (step_count > 0) {
+    path.PushBack(World::kStepDirections[local_steps_[--step_count]]);
+  }
+}
+
+void HierarchicalPathfinder::AppendSegment(Vector2<TileCoordinate> from_tile_position,
+                                           Vector2<TileCoordinate> to_tile_position, TilePath& path) {
+  if (from_tile_position == to_tile_position) {
+    return;
+  }
+
+  const unsigned char exits = world_->GetExitMask(from_tile_position, Tile::block_type::partial_block);
+
+  // Nodes joined across an entrance or through a portal are a single step apart.
+  for (unsigned char code = 0; code < World::kStepDirections.size(); code++) {
+    if ((exits & (1 << code)) &&
+        world_->GetStepDestination(from_tile_position, World::kStepDirections[code]) == to_tile_position) {
+      path.PushBack(World::kStepDirections[code]);
+      return;
+    }
+  }
+
+  const unsigned int cluster = GetCluster(from_tile_position);
+
+  SearchCluster(cluster, from_tile_position, to_tile_position);
+  AppendLocalPath(to_tile_position, path);
+}
+
+unsigned int HierarchicalPathfinder::GetEstimate(Vector2<TileCoordinate> tile_position,
+                                                 Vector2<TileCoordinate> to_tile_position) const {
+  const unsigned int estimate = World::GetManhattanDistance(tile_position, to_tile_position);
+
+  if (goal_exit_distance_ == kNone) {
+    return estimate;
+  }
+
+  // A path through portals steps next to an entrance, through the portal, and on from next to an exit.
+  unsigned int entrance_distance = kNone;
+
+  for (const World::Portal& portal : world_->portals()) {
+    entrance_distance = std::min(entrance_distance, World::GetManhattanDistance(tile_position, portal.entrance_));
+  }
+
+  const unsigned int portal_estimate = entrance_distance + goal_exit_distance_;
+
+  return std::min(estimate, portal_estimate > 0 ? portal_estimate - 1 : 0);
+}
+
+void HierarchicalPathfinder::ReserveSearch() {
+  // Stamps of new nodes start at zero, which no search uses, so existing stamps stay valid.
+  costs_.resize(nodes_.size());
+  parents_.resize(nodes_.size());
+  cost_stamps_.resize(nodes_.size(), 0);
+  closed_stamps_.resize(nodes_.size(), 0);
+  goal_costs_.resize(nodes_.size());
+  goal_stamps_.resize(nodes_.size(), 0);
+
+  // Every node is expanded once, so the heap never holds more than the starting nodes and one entry per edge.
+  open_nodes_.reserve(edge_count_ + max_cluster_node_count_);
+  node_path_.reserve(nodes_.size());
+}
\ No newline at end of file
@@ -0,0 +1,354 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Vector2.h"
+#include "TileCoordinate.h"
+
+class World;
+class TilePath;
+
+/// <summary>
+/// Finds paths across the map by hierarchical pathfinding (HPA*), so the cost of a path grows with the
+/// number of clusters it crosses rather than the number of tiles in the map.
+///
+/// The map is partitioned into square clusters of tiles. Wherever tiles on either side of the border between
+/// two clusters are open, an entrance is placed, with a node on each side. Each step through a portal is a
+/// transition too, with a node on the tile before the portal and one on the tile it leads to, joined only in
+/// the direction of the step. The distances between the nodes of
+/// each cluster are found when the map is loaded. A path is found by searching the graph of nodes with A*,
+/// from the nodes that the starting tile reaches within its cluster to those that reach the destination, then
+/// refining each step between nodes into tiles with a search confined to a single cluster. Paths are the
+/// shortest through the nodes of the graph, which may be a few steps longer than the shortest through the tiles
+/// where an entrance's node is not on the shortest path. On large maps the search also trades a bounded amount
+/// of path length for speed.
+///
+/// Paths move onto tiles that are at most partially blocking, as Ghosts do. Finding a path does not allocate.
+/// </summary>
+class HierarchicalPathfinder {
+ public:
+  /// <summary>
+  /// The number of tiles along each side of a cluster.
+  /// </summary>
+  static const unsigned int kClusterSize = 16;
+  /// <summary>
+  /// Constructor for the HierarchicalPathfinder class. No paths are found until Build is called.
+  /// </summary>
+  HierarchicalPathfinder(void);
+  /// <summary>
+  /// Places the entrances between every pair of neighbouring clusters, and finds the distances between the
+  /// nodes of each cluster. Called once the World's exit masks have been computed.
+  /// </summary>
+  /// <param name="world">The World whose exit masks are searched. It must outlive any later call.</param>
+  void Build(const World& world);
+  /// <summary>
+  /// Updates the graph after the block type of a tile has changed. The entrances on every border of the
+  /// tile's cluster and the transitions of its portals are placed again, and the distances within it and the
+  /// clusters it is joined to found again, so the cost of an update does not grow with the size of the map.
+  /// </summary>
+  /// <param name="tile_position">The map coordinates of the tile that changed.</param>
+  void UpdateTile(Vector2<TileCoordinate> tile_position);
+  /// <summary>
+  /// Finds a path between two tiles, storing its steps in the given path. The path is left empty if the
+  /// destination cannot be reached.
+  /// </summary>
+  /// <param name="from_tile_position">The map coordinates of the starting tile of the path.</param>
+  /// <param name="to_tile_position">The map coordinates of the destination tile of the path.</param>
+  /// <param name="path">The path that the steps are stored in, replacing any previous steps.</param>
+  void FindPath(Vector2<TileCoordinate> from_tile_position, Vector2<TileCoordinate> to_tile_position, TilePath& path);
+  /// <summary>
+  /// Gets the number of nodes in the graph, which is the number of tiles on either side of every entrance.
+  /// </summary>
+  /// <returns>The number of nodes.</returns>
+  unsigned int node_count(void) const;
+
+ private:
+  /// <summary>
+  /// The number of tiles in a cluster.
+  /// </summary>
+  static const unsigned int kClusterArea = kClusterSize * kClusterSize;
+  /// <summary>
+  /// Entrances at least this many tiles wide have a node pair at each end, and narrower entrances a single
+  /// pair in the middle.
+  /// </summary>
+  static const unsigned int kWideEntranceLength = 6;
+  /// <summary>
+  /// On maps of at least kWeightedSearchArea tiles, the estimated distance remaining is multiplied by this. In
+  /// a large maze the estimate is far shorter than most paths, so the search would expand most of the graph;
+  /// the weighted estimate expands far fewer nodes, and finds paths at most this many times longer than the
+  /// shortest through the graph.
+  /// </summary>
+  static const unsigned int kHeuristicWeight = 2;
+  /// <summary>
+  /// The number of tiles from which a map's searches weight their estimates. Searches of smaller maps expand
+  /// few nodes however they are estimated, so they find the shortest paths through the graph.
+  /// </summary>
+  static const unsigned int kWeightedSearchArea = 128 * 128;
+  /// <summary>
+  /// Marks the absence of a node, and the distance to a tile that could not be reached.
+  /// </summary>
+  static const unsigned int kNone = static_cast<unsigned int>(-1);
+  /// <summary>
+  /// A connection from a node to another node.
+  /// </summary>
+  struct Edge {
+    /// <summary>
+    /// The index of the node that the edge leads to.
+    /// </summary>
+    unsigned int node_;
+    /// <summary>
+    /// The number of steps between the tiles of the nodes, or kNone if the edge cannot be followed and only
+    /// marks the node that has an edge to this one.
+    /// </summary>
+    unsigned int cost_;
+    /// <summary>
+    /// True if the edge is a path within the nodes' cluster, else false for a step across an entrance or
+    /// through a portal.
+    /// </summary>
+    bool intra_cluster_;
+  };
+  /// <summary>
+  /// A tile beside an entrance of its cluster.
+  /// </summary>
+  struct Node {
+    /// <summary>
+    /// The position of the tile.
+    /// </summary>
+    Vector2<TileCoordinate> tile_;
+    /// <summary>
+    /// The index of the node's cluster, or kNone if the node has been removed.
+    /// </summary>
+    unsigned int cluster_;
+    /// <summary>
+    /// The edges to the other nodes of the cluster that can be reached within it, and across the entrances.
+    /// </summary>
+    std::vector<Edge> edges_;
+  };
+  /// <summary>
+  /// A node waiting to be expanded by the search of the graph.
+  /// </summary>
+  struct OpenNode {
+    /// <summary>
+    /// The distance from the start through the node, plus the estimated distance on to the destination.
+    /// </summary>
+    unsigned int estimate_;
+    /// <summary>
+    /// The index of the node.
+    /// </summary>
+    unsigned int node_;
+  };
+  /// <summary>
+  /// Copy constructor for the HierarchicalPathfinder class.
+  /// </summary>
+  /// <param name="reference">The HierarchicalPathfinder reference to copy.</param>
+  HierarchicalPathfinder(HierarchicalPathfinder const& reference);
+  /// <summary>
+  /// Gets the cluster that holds a tile.
+  /// </summary>
+  /// <param name="tile_position">The map coordinates of the tile, which must be in the map.</param>
+  /// <returns>The index of the cluster.</returns>
+  unsigned int GetCluster(Vector2<TileCoordinate> tile_position) const;
+  /// <summary>
+  /// Gets the node of a cluster on a tile, adding one if the cluster has none there.
+  /// </summary>
+  /// <param name="cluster">The index of the cluster.</param>
+  /// <param name="tile_position">The map coordinates of the tile.</param>
+  /// <returns>The index of the node.</returns>
+  unsigned int AddNode(unsigned int cluster, Vector2<TileCoordinate> tile_position);
+  /// <summary>
+  /// Removes a node and every edge to it. Its index is reused by the next node added.
+  /// </summary>
+  /// <param name="node">The index of the node.</param>
+  void RemoveNode(unsigned int node);
+  /// <summary>
+  /// Adds an edge from one node to another, unless there is one of the same kind already. An edge that cannot
+  /// be followed is made followable if it is added again with a cost.
+  /// </summary>
+  /// <param name="from_node">The index of the node that the edge leaves.</param>
+  /// <param name="to_node">The index of the node that the edge leads to.</param>
+  /// <param name="cost">The number of steps between the tiles of the nodes, or kNone.</param>
+  /// <param name="intra_cluster">True for a path within the nodes' cluster, else false.</param>
+  void AddEdge(unsigned int from_node, unsigned int to_node, unsigned int cost, bool intra_cluster);
+  /// <summary>
+  /// Places the entrances on the border between a cluster and the cluster to its right or below it.
+  /// </summary>
+  /// <param name="cluster">The index of the cluster on the left of or above the border.</param>
+  /// <param name="vertical">True for the border with the cluster to the right, else the border with the cluster below.</param>
+  void AddEntrances(unsigned int cluster, bool vertical);
+  /// <summary>
+  /// Places the transitions of the steps through portals that start or end in a cluster.
+  /// </summary>
+  /// <param name="cluster">The index of the cluster, or kNone to place the transitions of every portal.</param>
+  void AddPortalTransitions(unsigned int cluster);
+  /// <summary>
+  /// Finds the distances between every pair of nodes of a cluster within it, replacing any found before.
+  /// </summary>
+  /// <param name="cluster">The index of the cluster.</param>
+  void ConnectCluster(unsigned int cluster);
+  /// <summary>
+  /// Searches a cluster breadth first from a tile, recording the distance to each tile of the cluster
+  /// and the direction it was entered by. Steps through portals are left to the graph, so every step of the
+  /// search can be taken back.
+  /// </summary>
+  /// <param name="cluster">The index of the cluster.</param>
+  /// <param name="from_tile_position">The map coordinates of the tile to search from, which is in the cluster.</param>
+  /// <param name="to_tile_position">
+  /// The map coordinates of a tile that ends the search once it is reached. By default a tile outside every map,
+  /// so the whole cluster is searched.
+  /// </param>
+  void SearchCluster(unsigned int cluster, Vector2<TileCoordinate> from_tile_position,
+                     Vector2<TileCoordinate> to_tile_position = Vector2<TileCoordinate>(kMaxMapDimension, kMaxMapDimension));
+  /// <summary>
+  /// Gets the distance to a tile found by the last search of a cluster.
+  /// </summary>
+  /// <param name="tile_position">The map coordinates of the tile.</param>
+  /// <returns>The number of steps to the tile, or kNone if it is outside the cluster or was not reached.</returns>
+  unsigned int GetLocalDistance(Vector2<TileCoordinate> tile_position) const;
+  /// <summary>
+  /// Adds the steps to a tile found by the last search of a cluster to the end of a path.
+  /// </summary>
+  /// <param name="to_tile_position">The map coordinates of the tile, which the search reached.</param>
+  /// <param name="path">The path that the steps are added to.</param>
+  void AppendLocalPath(Vector2<TileCoordinate> to_tile_position, TilePath& path);
+  /// <summary>
+  /// Adds the steps between two tiles to the end of a path. The tiles are either a single step apart, across a
+  /// border or through a portal, or lie in the same cluster and are connected within it.
+  /// </summary>
+  /// <param name="from_tile_position">The map coordinates of the tile that the steps start from.</param>
+  /// <param name="to_tile_position">The map coordinates of the tile that the steps lead to.</param>
+  /// <param name="path">The path that the steps are added to.</param>
+  void AppendSegment(Vector2<TileCoordinate> from_tile_position, Vector2<TileCoordinate> to_tile_position,
+                     TilePath& path);
+  /// <summary>
+  /// Estimates the distance from a tile to the destination of the current search of the graph. The estimate is
+  /// never longer than the shortest path, whether or not it passes through portals.
+  /// </summary>
+  /// <param name="tile_position">The map coordinates of the tile.</param>
+  /// <param name="to_tile_position">The map coordinates of the destination tile.</param>
+  /// <returns>The estimated number of steps, before it is weighted.</returns>
+  unsigned int GetEstimate(Vector2<TileCoordinate> tile_position, Vector2<TileCoordinate> to_tile_position) const;
+  /// <summary>
+  /// Sizes the buffers of the search of the graph for the current nodes and edges, so searching does not allocate.
+  /// The buffers only grow, so an update rarely reallocates them.
+  /// </summary>
+  void ReserveSearch(void);
+  /// <summary>
+  /// The World whose exit masks are searched. Null until Build is called.
+  /// </summary>
+  const World* world_;
+  /// <summary>
+  /// The weight of the estimates of the searches of the graph: kHeuristicWeight on large maps, else 1.
+  /// </summary>
+  unsigned int heuristic_weight_;
+  /// <summary>
+  /// The number of clusters in each row of clusters.
+  /// </summary>
+  unsigned int cluster_columns_;
+  /// <summary>
+  /// The number of rows of clusters.
+  /// </summary>
+  unsigned int cluster_rows_;
+  /// <summary>
+  /// The nodes of the graph, including removed nodes whose indices are waiting to be reused.
+  /// </summary>
+  std::vector<Node> nodes_;
+  /// <summary>
+  /// The indices of the removed nodes.
+  /// </summary>
+  std::vector<unsigned int> free_nodes_;
+  /// <summary>
+  /// The indices of the nodes of each cluster, row by row.
+  /// </summary>
+  std::vector<std::vector<unsigned int>> cluster_nodes_;
+  /// <summary>
+  /// The number of edges between all of the nodes.
+  /// </summary>
+  unsigned int edge_count_;
+  /// <summary>
+  /// The greatest number of nodes that any cluster has held.
+  /// </summary>
+  unsigned int max_cluster_node_count_;
+  /// <summary>
+  /// The distance from the start of the current search of the graph to each node.
+  /// </summary>
+  std::vector<unsigned int> costs_;
+  /// <summary>
+  /// The node that each node was reached from by the current search of the graph, or kNone for the start.
+  /// </summary>
+  std::vector<unsigned int> parents_;
+  /// <summary>
+  /// The search of the graph that each node's cost was written by. Costs are stale for any other search.
+  /// </summary>
+  std::vector<unsigned int> cost_stamps_;
+  /// <summary>
+  /// The search of the graph that each node was expanded by.
+  /// </summary>
+  std::vector<unsigned int> closed_stamps_;
+  /// <summary>
+  /// The distance from each node of the destination's cluster to the destination.
+  /// </summary>
+  std::vector<unsigned int> goal_costs_;
+  /// <summary>
+  /// The search of the graph that each node's distance to the destination was written by.
+  /// </summary>
+  std::vector<unsigned int> goal_stamps_;
+  /// <summary>
+  /// The distance from the nearest portal exit to the destination of the current search of the graph, or kNone
+  /// if the map has no portals.
+  /// </summary>
+  unsigned int goal_exit_distance_;
+  /// <summary>
+  /// The nodes waiting to be expanded, as a binary heap ordered by their estimates.
+  /// </summary>
+  std::vector<OpenNode> open_nodes_;
+  /// <summary>
+  /// The nodes of the path found by the search of the graph, from the destination back to the start.
+  /// </summary>
+  std::vector<unsigned int> node_path_;
+  /// <summary>
+  /// The current search of the graph. Incremented by every search, so stamps need not be cleared.
+  /// </summary>
+  unsigned int search_stamp_;
+  /// <summary>
+  /// The top left tile of the cluster of the last search of a cluster.
+  /// </summary>
+  Vector2<TileCoordinate> local_origin_;
+  /// <summary>
+  /// The tile that the last search of a cluster started from.
+  /// </summary>
+  Vector2<TileCoordinate> local_start_;
+  /// <summary>
+  /// The number of tiles along each axis of the cluster of the last search of a cluster, which is less than
+  /// kClusterSize for clusters on the right and bottom edges of the map.
+  /// </summary>
+  Vector2<unsigned int> local_size_;
+  /// <summary>
+  /// The distance to each tile of the cluster found by the last search of a cluster, row by row.
+  /// </summary>
+  std::array<unsigned int, kClusterArea> local_distances_;
+  /// <summary>
+  /// The 2-bit code of the direction each tile of the cluster was entered by in the last search of a cluster.
+  /// </summary>
+  std::array<unsigned char, kClusterArea> local_directions_;
+  /// <summary>
+  /// The search of a cluster that each tile's distance was written by.
+  /// </summary>
+  std::array<unsigned int, kClusterArea> local_stamps_;
+  /// <summary>
+  /// The current search of a cluster.
+  /// </summary>
+  unsigned int local_stamp_;
+  /// <summary>
+  /// The tiles waiting to be expanded by a search of a cluster, as indices within the cluster.
+  /// </summary>
+  std::array<unsigned int, kClusterArea> local_queue_;
+  /// <summary>
+  /// The 2-bit codes of the steps of a path within a cluster, from its end back to its start.
+  /// </summary>
+  std::array<unsigned char, kClusterArea> local_steps_;
+};
\ No newline at end of file
@@ -0,0 +1,107 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "Histogram.h"
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  /// <summary>
+  /// Values below this are each counted in their own bucket.
+  /// </summary>
+  const std::uint64_t kExactLimit = 128;
+  /// <summary>
+  /// The number of buckets that each power of two above the exact range is divided into.
+  /// </summary>
+  const unsigned int kBucketsPerPowerOfTwo = 64;
+  /// <summary>
+  /// The number of powers of two above the exact range, which covers every 64-bit value.
+  /// </summary>
+  const unsigned int kPowerOfTwoCount = 64 - 7;
+
+  unsigned int FloorLog2(std::uint64_t value) {
+    unsigned int result = 0;
+
+    while (value >>= 1) {
+      result++;
+    }
+
+    return result;
+  }
+}
+
+Histogram::Histogram(std::uint64_t threshold)
+    : buckets_(kExactLimit + kPowerOfTwoCount * kBucketsPerPowerOfTwo, 0),
+      count_(0),
+      max_(0),
+      threshold_(threshold),
+      over_threshold_count_(0) {}
+
+void Histogram::Record(std::uint64_t value) {
+  buckets_[BucketIndex(value)]++;
+  count_++;
+  max_ = std::max(max_, value);
+
+  if (value > threshold_) {
+    over_threshold_count_++;
+  }
+}
+
+std::uint64_t Histogram::ValueAtPercentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+
+  // The nearest-rank method: the smallest value that at least the given percentage of values are less than or equal to.
+  const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * count_)));
+  std::uint64_t seen = 0;
+
+  for (unsigned int i = 0; i < buckets_.size(); i++) {
+    seen += buckets_[i];
+
+    if (seen >= rank) {
+      // The bucket's upper bound can exceed every recorded value, so it is capped at the maximum.
+      return std::min(BucketHighestValue(i), max_);
+    }
+  }
+
+  return max_;
+}
+
+std::uint64_t Histogram::count() const {
+  return count_;
+}
+
+std::uint64_t Histogram::max() const {
+  return max_;
+}
+
+std::uint64_t Histogram::over_threshold_count() const {
+  return over_threshold_count_;
+}
+
+unsigned int Histogram::BucketIndex(std::uint64_t value) {
+  if (value < kExactLimit) {
+    return static_cast<unsigned int>(value);
+  }
+
+  // Shifts the value so that it lies in [64, 128), keeping its six most significant bits after the leading one.
+  const unsigned int shift = FloorLog2(value) - 6;
+
+  return static_cast<unsigned int>(kExactLimit + (shift - 1) * kBucketsPerPowerOfTwo +
+                                   ((value >> shift) - kBucketsPerPowerOfTwo));
+}
+
+std::uint64_t Histogram::BucketHighestValue(unsigned int index) {
+  if (index < kExactLimit) {
+    return index;
+  }
+
+  const unsigned int shift = (index - kExactLimit) / kBucketsPerPowerOfTwo + 1;
+  const std::uint64_t significand = (index - kExactLimit) % kBucketsPerPowerOfTwo + kBucketsPerPowerOfTwo;
+
+  return ((significand + 1) << shift) - 1;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+/// <summary>
+/// Counts recorded values in logarithmic buckets, in the style of an HDR histogram.
+/// Values below 128 are counted exactly. Larger values are counted in buckets that are 1/64th
+/// of their power of two wide, so any percentile is reported to within about 1.6% of its true value,
+/// however large the range of values. Recording is constant time and never allocates.
+/// </summary>
+class Histogram {
+ public:
+  /// <summary>
+  /// Constructor for the Histogram class.
+  /// </summary>
+  /// <param name="threshold">Values above the threshold are also counted exactly, such as frame times over budget.</param>
+  Histogram(std::uint64_t threshold);
+  /// <summary>
+  /// Records a value.
+  /// </summary>
+  /// <param name="value">The value to record.</param>
+  void Record(std::uint64_t value);
+  /// <summary>
+  /// Gets the value at a percentile of the recorded values, as the highest value in the bucket containing it.
+  /// </summary>
+  /// <param name="percentile">The percentile, between 0 and 100.</param>
+  /// <returns>The value at the percentile, or zero if no values have been recorded.</returns>
+  std::uint64_t ValueAtPercentile(double percentile) const;
+  /// <summary>
+  /// Gets the number of recorded values.
+  /// </summary>
+  /// <returns>The number of recorded values.</returns>
+  std::uint64_t count(void) const;
+  /// <summary>
+  /// Gets the largest recorded value, exactly.
+  /// </summary>
+  /// <returns>The largest recorded value.</returns>
+  std::uint64_t max(void) const;
+  /// <summary>
+  /// Gets the number of recorded values that exceeded the threshold.
+  /// </summary>
+  /// <returns>The number of values over the threshold.</returns>
+  std::uint64_t over_threshold_count(void) const;
+
+ private:
+  /// <summary>
+  /// Gets the index of the bucket that counts a value.
+  /// </summary>
+  /// <param name="value">The value.</param>
+  /// <returns>The index of the bucket.</returns>
+  static unsigned int BucketIndex(std::uint64_t value);
+  /// <summary>
+  /// Gets the highest value counted by a bucket.
+  /// </summary>
+  /// <param name="index">The index of the bucket.</param>
+  /// <returns>The highest value in the bucket.</returns>
+  static std::uint64_t BucketHighestValue(unsigned int index);
+  /// <summary>
+  /// The count of values in each bucket.
+  /// </summary>
+  std::vector<std::uint64_t> buckets_;
+  /// <summary>
+  /// The number of recorded values.
+  /// </summary>
+  std::uint64_t count_;
+  /// <summary>
+  /// The largest recorded value.
+  /// </summary>
+  std::uint64_t max_;
+  /// <summary>
+  /// Values above the threshold are counted.
+  /// </summary>
+  const std::uint64_t threshold_;
+  /// <summary>
+  /// The number of recorded values that exceeded the threshold.
+  /// </summary>
+  std::uint64_t over_threshold_count_;
+};
\ No newline at end of file
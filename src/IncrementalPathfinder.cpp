@@ -0,0 +1,465 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "IncrementalPathfinder.h"
+
+#include <array>
+#include <algorithm>
+#include <cstdlib>
+
+#include "World.h"
+#include "TilePath.h"
+
+namespace {
+  /// <summary>
+  /// The search restarts once the goal has moved this far in total, or the distances kept by moving the root
+  /// have grown this large, so keys stay within 32 bits.
+  /// </summary>
+  const unsigned int kMaxKeyModifier = 1u << 30;
+
+  /// <summary>
+  /// Orders the queue so that the heap holds the lowest key at its front. Equal keys are ordered by tile,
+  /// so the same changes always expand the same tiles.
+  /// </summary>
+  struct OpenTileGreater {
+    template <typename OpenTile>
+    bool operator()(const OpenTile& a, const OpenTile& b) const {
+      return a.key_ != b.key_ ? a.key_ > b.key_ : a.tile_ > b.tile_;
+    }
+  };
+}
+
+const unsigned int IncrementalPathfinder::kInfinity;
+
+IncrementalPathfinder::IncrementalPathfinder()
+    : world_(nullptr),
+      max_valid_block_type_(Tile::block_type::partial_block),
+      width_(0),
+      height_(0),
+      root_(kInfinity),
+      goal_(kInfinity),
+      goal_exit_distance_(kInfinity),
+      key_modifier_(0),
+      serial_(0) {}
+
+void IncrementalPathfinder::Build(const World& world, enum Tile::block_type max_valid_block_type) {
+  world_ = &world;
+  max_valid_block_type_ = max_valid_block_type;
+  width_ = world.map_width();
+  height_ = world.map_height();
+  root_ = kInfinity;
+  goal_ = kInfinity;
+
+  const size_t tile_count = static_cast<size_t>(width_) * height_;
+
+  distances_.assign(tile_count, kInfinity);
+  lookaheads_.assign(tile_count, kInfinity);
+  parents_.assign(tile_count, kInfinity);
+  serials_.assign(tile_count, 0);
+  states_.assign(tile_count, 0);
+  open_tiles_.clear();
+  reached_tiles_.clear();
+  portal_steps_.clear();
+
+  for (const World::Portal& portal : world.portals()) {
+    for (unsigned char code = 0; code < World::kStepDirections.size(); code++) {
+      const Vector2<char> direction = World::kStepDirections[code];
+      const Vector2<TileCoordinate> from_tile =
+          World::GetTileInDirection(portal.entrance_, Vector2<char>(-direction.x_, -direction.y_));
+      const Vector2<TileCoordinate> to_tile = World::GetTileInDirection(portal.exit_, direction);
+
+      if (from_tile.x_ < width_ && from_tile.y_ < height_ && to_tile.x_ < width_ && to_tile.y_ < height_) {
+        portal_steps_.push_back({from_tile.y_ * width_ + from_tile.x_, code, to_tile.y_ * width_ + to_tile.x_});
+      }
+    }
+  }
+}
+
+void IncrementalPathfinder::SetGoal(Vector2<TileCoordinate> goal_tile_position) {
+  if (!world_ || goal_tile_position.x_ >= width_ || goal_tile_position.y_ >= height_) {
+    return;
+  }
+
+  const unsigned int goal = goal_tile_position.y_ * width_ + goal_tile_position.x_;
+
+  if (goal == goal_) {
+    return;
+  }
+
+  // Each estimate to the goal falls by at most the distance the goal moved, which is added to every new key
+  // rather than raising the queued ones.
+  if (goal_ != kInfinity) {
+    key_modifier_ += World::GetManhattanDistance(GetTilePosition(goal_), goal_tile_position);
+  }
+
+  goal_ = goal;
+  goal_exit_distance_ = kInfinity;
+
+  for (const World::Portal& portal : world_->portals()) {
+    goal_exit_distance_ = std::min(goal_exit_distance_, World::GetManhattanDistance(portal.exit_, goal_tile_position));
+  }
+}
+
+void IncrementalPathfinder::UpdateTile(Vector2<TileCoordinate> tile_position) {
+  if (root_ == kInfinity || tile_position.x_ >= width_ || tile_position.y_ >= height_) {
+    return;
+  }
+
+  // Only the cost of steps onto the tile depends on its block type, so only its own lookahead is repaired.
+  const unsigned int tile = tile_position.y_ * width_ + tile_position.x_;
+
+  if (tile != root_) {
+    UpdateLookahead(tile);
+    UpdateQueue(tile);
+  }
+}
+
+void IncrementalPathfinder::FindPath(Vector2<TileCoordinate> from_tile_position, TilePath& path) {
+  path.Reset(from_tile_position);
+
+  if (goal_ == kInfinity || from_tile_position.x_ >= width_ || from_tile_position.y_ >= height_) {
+    return;
+  }
+
+  const unsigned int start = from_tile_position.y_ * width_ + from_tile_position.x_;
+
+  if (root_ == kInfinity || key_modifier_ > kMaxKeyModifier || lookaheads_[start] > kMaxKeyModifier) {
+    Restart(start);
+  }
+
+  Repair();
+
+  // The rest of a shortest path from the root is a shortest path from any tile along it, so the root only
+  // moves once the start has left the path to the goal, or the goal cannot be reached from the root but might
+  // be from the start. The search is only kept if the start was reached through the root, as it is when the
+  // start follows an earlier path.
+  if (start != root_ && !CheckReachedThrough(goal_, start)) {
+    if (CheckReachedThrough(start, root_)) {
+      MoveRoot(start);
+    } else {
+      Restart(start);
+    }
+
+    Repair();
+  }
+
+  if (lookaheads_[goal_] == kInfinity) {
+    return;
+  }
+
+  // The steps are followed back from the goal to the start, then added to the path from its start.
+  path_codes_.clear();
+
+  for (unsigned int tile = goal_; tile != start;) {
+    const unsigned int parent = parents_[tile];
+
+    if (parent == kInfinity || path_codes_.size() >= reached_tiles_.size()) {
+      return;
+    }
+
+    unsigned char code = 0;
+
+    while (code < World::kStepDirections.size() &&
+           (GetStepCost(parent, code) == kInfinity || GetStepDestination(parent, code) != tile)) {
+      code++;
+    }
+
+    // A parent that no step leads from is stale, so no path is given rather than a wrong one.
+    if (code == World::kStepDirections.size()) {
+      return;
+    }
+
+    path_codes_.push_back(code);
+    tile = parent;
+  }
+
+  for (auto code = path_codes_.rbegin(); code != path_codes_.rend() && path.size() < path.capacity(); ++code) {
+    path.PushBack(World::kStepDirections[*code]);
+  }
+}
+
+void IncrementalPathfinder::Restart(unsigned int root) {
+  for (unsigned int tile : reached_tiles_) {
+    distances_[tile] = kInfinity;
+    lookaheads_[tile] = kInfinity;
+    parents_[tile] = kInfinity;
+    serials_[tile] = 0;
+    states_[tile] = 0;
+  }
+
+  reached_tiles_.clear();
+  open_tiles_.clear();
+  serial_ = 0;
+  key_modifier_ = 0;
+  root_ = root;
+
+  lookaheads_[root_] = 0;
+  ListTile(root_);
+  UpdateQueue(root_);
+}
+
+void IncrementalPathfinder::MoveRoot(unsigned int root) {
+  states_[root] |= kKept;
+
+  for (unsigned int tile : reached_tiles_) {
+    MarkReachedThroughRoot(tile);
+  }
+
+  // The dropped tiles are forgotten first, so that none of them finds its lookahead from another.
+  size_t kept_count = 0;
+
+  for (size_t i = 0; i < reached_tiles_.size(); i++) {
+    const unsigned int tile = reached_tiles_[i];
+
+    if (states_[tile] & kKept) {
+      std::swap(reached_tiles_[kept_count++], reached_tiles_[i]);
+      states_[tile] = kListed;
+    } else {
+      distances_[tile] = kInfinity;
+      lookaheads_[tile] = kInfinity;
+      parents_[tile] = kInfinity;
+      serials_[tile] = 0;
+    }
+  }
+
+  // The dropped tiles stay at the end of the list until those next to a kept tile have been queued.
+  const size_t reached_count = reached_tiles_.size();
+
+  root_ = root;
+  parents_[root_] = kInfinity;
+
+  for (size_t i = kept_count; i < reached_count; i++) {
+    const unsigned int tile = reached_tiles_[i];
+
+    UpdateLookahead(tile);
+
+    if (lookaheads_[tile] != kInfinity) {
+      UpdateQueue(tile);
+      reached_tiles_[kept_count++] = tile;
+      states_[tile] = kListed;
+    } else {
+      states_[tile] = 0;
+    }
+  }
+
+  reached_tiles_.resize(kept_count);
+}
+
+bool IncrementalPathfinder::CheckReachedThrough(unsigned int tile, unsigned int ancestor) const {
+  for (size_t i = 0; i <= reached_tiles_.size() && tile != kInfinity; i++) {
+    if (tile == ancestor) {
+      return true;
+    }
+
+    if (tile == root_) {
+      return false;
+    }
+
+    tile = parents_[tile];
+  }
+
+  return false;
+}
+
+void IncrementalPathfinder::MarkReachedThroughRoot(unsigned int tile) {
+  followed_tiles_.clear();
+
+  // A tile whose steps lead back to itself was reached through a distance that has since been lost.
+  unsigned char state = kDropped;
+
+  while (true) {
+    if (states_[tile] & (kKept | kDropped)) {
+      state = states_[tile] & (kKept | kDropped);
+      break;
+    }
+
+    if (parents_[tile] == kInfinity || (states_[tile] & kVisiting)) {
+      break;
+    }
+
+    states_[tile] |= kVisiting;
+    followed_tiles_.push_back(tile);
+    tile = parents_[tile];
+  }
+
+  for (unsigned int followed_tile : followed_tiles_) {
+    states_[followed_tile] = (states_[followed_tile] & kListed) | state;
+  }
+}
+
+void IncrementalPathfinder::ListTile(unsigned int tile) {
+  if (!(states_[tile] & kListed)) {
+    states_[tile] |= kListed;
+    reached_tiles_.push_back(tile);
+  }
+}
+
+Vector2<TileCoordinate> IncrementalPathfinder::GetTilePosition(unsigned int tile) const {
+  return Vector2<TileCoordinate>(tile % width_, tile / width_);
+}
+
+std::uint64_t IncrementalPathfinder::GetKey(unsigned int tile) const {
+  const unsigned int distance = std::min(distances_[tile], lookaheads_[tile]);
+
+  // A tile that has not been reached is ordered after every tile that has.
+  if (distance == kInfinity) {
+    return static_cast<std::uint64_t>(-1);
+  }
+
+  const Vector2<TileCoordinate> position = GetTilePosition(tile);
+  const Vector2<TileCoordinate> goal = GetTilePosition(goal_);
+  unsigned int estimate = World::GetManhattanDistance(position, goal);
+
+  // A path through portals steps next to an entrance, through the portal, and on from next to an exit.
+  if (!portal_steps_.empty()) {
+    unsigned int entrance_distance = kInfinity;
+
+    for (const World::Portal& portal : world_->portals()) {
+      entrance_distance = std::min(entrance_distance, World::GetManhattanDistance(position, portal.entrance_));
+    }
+
+    const unsigned int portal_estimate = entrance_distance + goal_exit_distance_;
+
+    estimate = std::min(estimate, portal_estimate > 0 ? portal_estimate - 1 : 0);
+  }
+
+  return (static_cast<std::uint64_t>(distance + estimate + key_modifier_) << 32) | distance;
+}
+
+unsigned int IncrementalPathfinder::GetStepCost(unsigned int tile, unsigned char code) const {
+  return (world_->GetExitMask(GetTilePosition(tile), max_valid_block_type_) & (1 << code)) ? 1 : kInfinity;
+}
+
+unsigned int IncrementalPathfinder::GetStepDestination(unsigned int tile, unsigned char code) const {
+  const Vector2<TileCoordinate> destination = world_->GetStepDestination(GetTilePosition(tile), World::kStepDirections[code]);
+
+  return destination.x_ < width_ && destination.y_ < height_ ? destination.y_ * width_ + destination.x_ : kInfinity;
+}
+
+void IncrementalPathfinder::UpdateLookahead(unsigned int tile) {
+  lookaheads_[tile] = kInfinity;
+  parents_[tile] = kInfinity;
+
+  ForEachPredecessor(tile, [this, tile](unsigned int predecessor, unsigned char code) {
+    const unsigned int distance = distances_[predecessor];
+
+    if (distance != kInfinity && distance + 1 < lookaheads_[tile] && GetStepCost(predecessor, code) != kInfinity) {
+      lookaheads_[tile] = distance + 1;
+      parents_[tile] = predecessor;
+    }
+  });
+}
+
+template <typename Visit>
+void IncrementalPathfinder::ForEachPredecessor(unsigned int tile, Visit visit) const {
+  const Vector2<TileCoordinate> position = GetTilePosition(tile);
+
+  for (unsigned char code = 0; code < World::kStepDirections.size(); code++) {
+    const Vector2<char> direction = World::kStepDirections[code];
+    const Vector2<TileCoordinate> neighbour =
+        World::GetTileInDirection(position, Vector2<char>(-direction.x_, -direction.y_));
+
+    // A neighbour stepping onto a portal's entrance arrives elsewhere, so it is not a predecessor.
+    if (neighbour.x_ < width_ && neighbour.y_ < height_ &&
+        world_->GetStepDestination(neighbour, direction) == position) {
+      visit(neighbour.y_ * width_ + neighbour.x_, code);
+    }
+  }
+
+  for (const PortalStep& step : portal_steps_) {
+    if (step.to_tile_ == tile) {
+      visit(step.from_tile_, step.code_);
+    }
+  }
+}
+
+void IncrementalPathfinder::UpdateQueue(unsigned int tile) {
+  if (distances_[tile] == lookaheads_[tile]) {
+    serials_[tile] = 0;
+    return;
+  }
+
+  if (serial_ == kInfinity - 1) {
+    RenumberQueue();
+  }
+
+  serials_[tile] = ++serial_;
+  open_tiles_.push_back({GetKey(tile), tile, serial_});
+  std::push_heap(open_tiles_.begin(), open_tiles_.end(), OpenTileGreater());
+}
+
+void IncrementalPathfinder::RenumberQueue() {
+  // Each queued tile has exactly one entry with its serial, so the others can be dropped.
+  open_tiles_.erase(std::remove_if(open_tiles_.begin(), open_tiles_.end(), [this](const OpenTile& open_tile) {
+    return serials_[open_tile.tile_] != open_tile.serial_;
+  }), open_tiles_.end());
+  std::make_heap(open_tiles_.begin(), open_tiles_.end(), OpenTileGreater());
+  serial_ = 0;
+
+  for (OpenTile& open_tile : open_tiles_) {
+    open_tile.serial_ = ++serial_;
+    serials_[open_tile.tile_] = serial_;
+  }
+}
+
+bool IncrementalPathfinder::SkipStaleEntries() {
+  while (!open_tiles_.empty()) {
+    const OpenTile& front = open_tiles_.front();
+
+    if (serials_[front.tile_] == front.serial_) {
+      return true;
+    }
+
+    std::pop_heap(open_tiles_.begin(), open_tiles_.end(), OpenTileGreater());
+    open_tiles_.pop_back();
+  }
+
+  return false;
+}
+
+void IncrementalPathfinder::Repair() {
+  while (SkipStaleEntries() &&
+         (open_tiles_.front().key_ < GetKey(goal_) || lookaheads_[goal_] > distances_[goal_])) {
+    const OpenTile open_tile = open_tiles_.front();
+    const unsigned int tile = open_tile.tile_;
+
+    std::pop_heap(open_tiles_.begin(), open_tiles_.end(), OpenTileGreater());
+    open_tiles_.pop_back();
+    serials_[tile] = 0;
+
+    // The key was found before the goal last moved, so the tile is queued again by its current key.
+    if (open_tile.key_ < GetKey(tile)) {
+      UpdateQueue(tile);
+      continue;
+    }
+
+    const bool distance_fell = distances_[tile] > lookaheads_[tile];
+
+    // A fallen distance can only lower the lookaheads of the tiles stepped onto from the tile, while a risen
+    // one makes the tiles whose best step left it find theirs again.
+    distances_[tile] = distance_fell ? lookaheads_[tile] : kInfinity;
+
+    for (unsigned char code = 0; code < World::kStepDirections.size(); code++) {
+      const unsigned int successor = GetStepDestination(tile, code);
+
+      if (successor == root_ || GetStepCost(tile, code) == kInfinity) {
+        continue;
+      }
+
+      if (distance_fell && distances_[tile] + 1 < lookaheads_[successor]) {
+        lookaheads_[successor] = distances_[tile] + 1;
+        parents_[successor] = tile;
+        ListTile(successor);
+        UpdateQueue(successor);
+      } else if (!distance_fell && parents_[successor] == tile) {
+        UpdateLookahead(successor);
+        UpdateQueue(successor);
+      }
+    }
+
+    if (!distance_fell) {
+      UpdateQueue(tile);
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,303 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "Tile.h"
+#include "Vector2.h"
+#include "TileCoordinate.h"
+
+class World;
+class TilePath;
+
+/// <summary>
+/// Finds shortest paths from an entity to a goal that moves, such as a tile that a Ghost chases, by Moving
+/// Target D* Lite.
+///
+/// The search grows from the entity's tile towards the goal, keeping the distance from the root of the search
+/// to every tile it has reached and the step that each distance arrives by. When the goal moves or a tile's
+/// block type changes, only the tiles whose distances change and that lie between the entity and the goal are
+/// searched again. The rest of a shortest path is a shortest path from any tile along it, so the search keeps
+/// its root while the entity follows its path. Once the entity leaves it, the tiles reached through the
+/// entity's tile keep their distances and only the rest are searched again, so the cost of a path follows the
+/// size of the change rather than the length of the path. The search is rooted at its entity, so each entity
+/// chasing a goal keeps its own pathfinder.
+///
+/// The pathfinder holds four values for every tile of the map. Finding a path does not allocate once the
+/// search has grown to its largest size.
+/// </summary>
+class IncrementalPathfinder {
+ public:
+  /// <summary>
+  /// Constructor for the IncrementalPathfinder class. No paths are found until Build and SetGoal are called.
+  /// </summary>
+  IncrementalPathfinder(void);
+  /// <summary>
+  /// Sizes the pathfinder for the World's map, forgetting any goal. Called once the World has been initialised.
+  /// </summary>
+  /// <param name="world">The World whose exit masks are searched. It must outlive any later call.</param>
+  /// <param name="max_valid_block_type">The most blocking tile type that can still be moved onto, as for
+  /// World::GetExitMask.</param>
+  void Build(const World& world, enum Tile::block_type max_valid_block_type);
+  /// <summary>
+  /// Moves the goal of the paths. The search is repaired for the new goal by the next path.
+  /// </summary>
+  /// <param name="goal_tile_position">The map coordinates of the tile that paths lead to.</param>
+  void SetGoal(Vector2<TileCoordinate> goal_tile_position);
+  /// <summary>
+  /// Marks the distances through a tile for repair, after World::SetBlockType has changed it. The World does
+  /// not know of its incremental pathfinders, so their owners call this.
+  /// </summary>
+  /// <param name="tile_position">The map coordinates of the tile that changed.</param>
+  void UpdateTile(Vector2<TileCoordinate> tile_position);
+  /// <summary>
+  /// Finds a shortest path from a tile to the goal, storing its steps in the given path. If the tile was
+  /// reached by the last search, such as the next tile of the last path, the search is kept and repaired;
+  /// otherwise it starts again from the tile. The path is left empty if the goal cannot be reached.
+  /// </summary>
+  /// <param name="from_tile_position">The map coordinates of the starting tile of the path.</param>
+  /// <param name="path">The path that the steps are stored in, replacing any previous steps.</param>
+  void FindPath(Vector2<TileCoordinate> from_tile_position, TilePath& path);
+
+ private:
+  /// <summary>
+  /// The distance to a tile that has not been found, or cannot be reached, and the index of no tile.
+  /// </summary>
+  static const unsigned int kInfinity = static_cast<unsigned int>(-1);
+  /// <summary>
+  /// Flags held for each tile while the search is moved to a new root.
+  /// </summary>
+  enum TileState : unsigned char {
+    /// <summary>
+    /// The tile is listed in reached_tiles_.
+    /// </summary>
+    kListed = 1,
+    /// <summary>
+    /// The tile is reached through the new root, so its distance is kept.
+    /// </summary>
+    kKept = 2,
+    /// <summary>
+    /// The tile is not reached through the new root, so its distance is searched again.
+    /// </summary>
+    kDropped = 4,
+    /// <summary>
+    /// The tile's steps back towards the root are being followed.
+    /// </summary>
+    kVisiting = 8
+  };
+  /// <summary>
+  /// A tile waiting to be expanded by the search.
+  /// </summary>
+  struct OpenTile {
+    /// <summary>
+    /// The priority of the tile, with the estimated length of a path through it in the upper 32 bits and its
+    /// distance from the root in the lower 32 bits.
+    /// </summary>
+    std::uint64_t key_;
+    /// <summary>
+    /// The index of the tile.
+    /// </summary>
+    unsigned int tile_;
+    /// <summary>
+    /// The number of the push that added the entry. The entry is stale unless the tile was last pushed by it.
+    /// </summary>
+    unsigned int serial_;
+  };
+  /// <summary>
+  /// A step through a portal, from the tile before its entrance to the tile past its exit.
+  /// </summary>
+  struct PortalStep {
+    /// <summary>
+    /// The index of the tile the step starts from.
+    /// </summary>
+    unsigned int from_tile_;
+    /// <summary>
+    /// The 2-bit code of the direction of the step.
+    /// </summary>
+    unsigned char code_;
+    /// <summary>
+    /// The index of the tile the step ends on.
+    /// </summary>
+    unsigned int to_tile_;
+  };
+  /// <summary>
+  /// Copy constructor for the IncrementalPathfinder class.
+  /// </summary>
+  /// <param name="reference">The IncrementalPathfinder reference to copy.</param>
+  IncrementalPathfinder(IncrementalPathfinder const& reference);
+  /// <summary>
+  /// Forgets every tile reached and starts the search again from a tile.
+  /// </summary>
+  /// <param name="root">The index of the tile to search from.</param>
+  void Restart(unsigned int root);
+  /// <summary>
+  /// Moves the root of the search to a tile that it reached. The tiles reached through the new root keep their
+  /// distances, which all include the same distance from the old root. The rest are forgotten, and those next
+  /// to a kept tile are queued to be searched again.
+  /// </summary>
+  /// <param name="root">The index of the new root.</param>
+  void MoveRoot(unsigned int root);
+  /// <summary>
+  /// Finds whether a tile's steps back towards the root pass through another tile.
+  /// </summary>
+  /// <param name="tile">The index of the tile whose steps are followed.</param>
+  /// <param name="ancestor">The index of the tile to look for, which may be the root.</param>
+  /// <returns>True if the steps pass through the other tile, else false.</returns>
+  bool CheckReachedThrough(unsigned int tile, unsigned int ancestor) const;
+  /// <summary>
+  /// Marks whether a tile is reached through the root, by following its steps back until they arrive at the
+  /// root or at a tile already marked. Every tile followed is marked kKept or kDropped.
+  /// </summary>
+  /// <param name="tile">The index of the tile.</param>
+  void MarkReachedThroughRoot(unsigned int tile);
+  /// <summary>
+  /// Lists a tile in reached_tiles_ if it is not listed already.
+  /// </summary>
+  /// <param name="tile">The index of the tile.</param>
+  void ListTile(unsigned int tile);
+  /// <summary>
+  /// Gets the map coordinates of a tile.
+  /// </summary>
+  /// <param name="tile">The index of the tile.</param>
+  /// <returns>The map coordinates of the tile.</returns>
+  Vector2<TileCoordinate> GetTilePosition(unsigned int tile) const;
+  /// <summary>
+  /// Gets the priority of a tile in the search, from its distance from the root and its estimated distance to
+  /// the goal. Steps through portals can make paths shorter than the Manhattan distance, so the estimate is
+  /// also bounded by the distance into the nearest entrance and out of the nearest exit.
+  /// </summary>
+  /// <param name="tile">The index of the tile.</param>
+  /// <returns>The key to order the tile by.</returns>
+  std::uint64_t GetKey(unsigned int tile) const;
+  /// <summary>
+  /// Gets the cost of a step from a tile.
+  /// </summary>
+  /// <param name="tile">The index of the tile that the step leaves.</param>
+  /// <param name="code">The 2-bit code of the direction of the step.</param>
+  /// <returns>1 if the step can be taken, else kInfinity.</returns>
+  unsigned int GetStepCost(unsigned int tile, unsigned char code) const;
+  /// <summary>
+  /// Gets the tile that a step from a tile arrives on.
+  /// </summary>
+  /// <param name="tile">The index of the tile that the step leaves.</param>
+  /// <param name="code">The 2-bit code of the direction of the step.</param>
+  /// <returns>The index of the tile, or kInfinity if the step leaves the map.</returns>
+  unsigned int GetStepDestination(unsigned int tile, unsigned char code) const;
+  /// <summary>
+  /// Finds a tile's distance from the root through its best step onto it, from the distances of the tiles the
+  /// steps leave, and records the tile that the best step leaves as its parent.
+  /// </summary>
+  /// <param name="tile">The index of the tile, which is not the root.</param>
+  void UpdateLookahead(unsigned int tile);
+  /// <summary>
+  /// Calls a function for every tile with a step onto a tile, including steps through portals.
+  /// </summary>
+  /// <param name="tile">The index of the tile that the steps arrive on.</param>
+  /// <param name="visit">Called with the index of each tile and the 2-bit code of its step.</param>
+  template <typename Visit>
+  void ForEachPredecessor(unsigned int tile, Visit visit) const;
+  /// <summary>
+  /// Queues a tile for expansion if its distance and lookahead differ, else drops it from the queue.
+  /// </summary>
+  /// <param name="tile">The index of the tile.</param>
+  void UpdateQueue(unsigned int tile);
+  /// <summary>
+  /// Drops the stale entries of the queue and numbers the queued tiles again from one, before the serials
+  /// wrap around.
+  /// </summary>
+  void RenumberQueue(void);
+  /// <summary>
+  /// Removes stale entries from the front of the queue.
+  /// </summary>
+  /// <returns>True if the queue holds a tile to expand, else false.</returns>
+  bool SkipStaleEntries(void);
+  /// <summary>
+  /// Expands tiles until the lookahead of the goal is known and no queued tile could shorten it.
+  /// </summary>
+  void Repair(void);
+  /// <summary>
+  /// The World whose exit masks are searched. Null until Build is called.
+  /// </summary>
+  const World* world_;
+  /// <summary>
+  /// The most blocking tile type that can still be moved onto.
+  /// </summary>
+  enum Tile::block_type max_valid_block_type_;
+  /// <summary>
+  /// The number of tiles along each row of the map.
+  /// </summary>
+  unsigned int width_;
+  /// <summary>
+  /// The number of rows of the map.
+  /// </summary>
+  unsigned int height_;
+  /// <summary>
+  /// The index of the tile that the search grows from, or kInfinity if no path has been found.
+  /// </summary>
+  unsigned int root_;
+  /// <summary>
+  /// The index of the goal tile, or kInfinity if no goal has been set.
+  /// </summary>
+  unsigned int goal_;
+  /// <summary>
+  /// The distance from the nearest portal's exit to the goal.
+  /// </summary>
+  unsigned int goal_exit_distance_;
+  /// <summary>
+  /// The sum of the distances that the goal has moved since the search began. Added to new keys, so the keys
+  /// queued before the goal moved stay lower bounds without being recomputed.
+  /// </summary>
+  unsigned int key_modifier_;
+  /// <summary>
+  /// The distance from the root to each tile found by the search, row by row. Moving the root keeps the
+  /// distances of the tiles reached through it, so every distance includes the same distance from an
+  /// earlier root.
+  /// </summary>
+  std::vector<unsigned int> distances_;
+  /// <summary>
+  /// The distance from the root to each tile through its best step onto it, from the distances of the tiles
+  /// the steps leave. A tile whose lookahead differs from its distance is queued for repair.
+  /// </summary>
+  std::vector<unsigned int> lookaheads_;
+  /// <summary>
+  /// The index of the tile that each tile's best step leaves, or kInfinity if it has none.
+  /// </summary>
+  std::vector<unsigned int> parents_;
+  /// <summary>
+  /// The number of the push that last queued each tile, or zero if it is not queued.
+  /// </summary>
+  std::vector<unsigned int> serials_;
+  /// <summary>
+  /// The TileState flags of each tile.
+  /// </summary>
+  std::vector<unsigned char> states_;
+  /// <summary>
+  /// The number of the last push. The queue is numbered again before it wraps around.
+  /// </summary>
+  unsigned int serial_;
+  /// <summary>
+  /// The tiles waiting to be expanded, as a binary heap ordered by their keys, including stale entries.
+  /// </summary>
+  std::vector<OpenTile> open_tiles_;
+  /// <summary>
+  /// Every tile whose values may differ from a tile never reached, so moving the root and restarting only
+  /// visit the tiles that the search has touched.
+  /// </summary>
+  std::vector<unsigned int> reached_tiles_;
+  /// <summary>
+  /// The tiles whose steps back towards the root are being followed, kept to avoid allocating.
+  /// </summary>
+  std::vector<unsigned int> followed_tiles_;
+  /// <summary>
+  /// The codes of the steps of a path from the goal back to the root, kept to avoid allocating.
+  /// </summary>
+  std::vector<unsigned char> path_codes_;
+  /// <summary>
+  /// The steps through every portal whose tiles on either side are in the map.
+  /// </summary>
+  std::vector<PortalStep> portal_steps_;
+};
\ No newline at end of file
@@ -0,0 +1,191 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "InputTrace.h"
+
+#include <array>
+#include <string>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include "SDL_scancode.h"
+
+const std::string InputTrace::kFileExtension = ".trace";
+
+namespace {
+  /// <summary>
+  /// The first line of every trace file, which identifies the format and its version.
+  /// </summary>
+  const char* kFormatHeader = "pacman-trace 1";
+  /// <summary>
+  /// The letters that represent each game key in a trace file, in the order of the key bits.
+  /// </summary>
+  const char kKeyLetters[] = {'U', 'D', 'L', 'R', 'E'};
+  /// <summary>
+  /// The scancode of each game key, in the order of the key bits.
+  /// </summary>
+  const std::array<SDL_Scancode, 5> kKeyScancodes {
+    SDL_SCANCODE_UP, SDL_SCANCODE_DOWN, SDL_SCANCODE_LEFT, SDL_SCANCODE_RIGHT, SDL_SCANCODE_ESCAPE
+  };
+}
+
+InputTrace::InputTrace(unsigned int seed)
+    : seed_(seed),
+      frame_count_(0),
+      score_(0),
+      state_hash_(0) {}
+
+InputTrace InputTrace::Load(const std::string& file_path) {
+  std::ifstream file(file_path);
+
+  if (!file.is_open()) {
+    throw std::ios_base::failure("Cannot find/access \"" + file_path + "\"");
+  }
+
+  // Reads a "<field> <value>" header line.
+  auto read_field = [&](const std::string& field) -> std::string {
+    std::string name;
+    std::string value;
+
+    if (!(file >> name >> value) || name != field) {
+      throw std::ios_base::failure("Trace \"" + file_path + "\" is missing its " + field);
+    }
+
+    return value;
+  };
+
+  std::string header;
+  std::getline(file, header);
+
+  if (header != kFormatHeader) {
+    throw std::ios_base::failure("Trace \"" + file_path + "\" is not a supported trace");
+  }
+
+  InputTrace trace(0);
+
+  try {
+    trace.seed_ = static_cast<unsigned int>(std::stoul(read_field("seed")));
+    trace.score_ = static_cast<unsigned short>(std::stoul(read_field("score")));
+    trace.state_hash_ = std::stoull(read_field("state"), nullptr, 16);
+  } catch (const std::logic_error&) {
+    throw std::ios_base::failure("Trace \"" + file_path + "\" has an invalid header");
+  }
+
+  // Every following line is a run: "<frame count> <elapsed ms> <keys>", where keys is '-' for none.
+  Run run {0, 0, 0};
+  std::string keys;
+
+  while (file >> run.frame_count_ >> run.elapsed_millis_ >> keys) {
+    run.keys_ = 0;
+
+    for (char letter : keys) {
+      size_t bit = 0;
+
+      while (bit < sizeof(kKeyLetters) && kKeyLetters[bit] != letter) {
+        bit++;
+      }
+
+      if (bit < sizeof(kKeyLetters)) {
+        run.keys_ |= static_cast<unsigned char>(1 << bit);
+      } else if (letter != '-') {
+        throw std::ios_base::failure("Trace \"" + file_path + "\" has an invalid key \"" + keys + "\"");
+      }
+    }
+
+    trace.runs_.push_back(run);
+    trace.frame_count_ += run.frame_count_;
+  }
+
+  if (!file.eof()) {
+    throw std::ios_base::failure("Trace \"" + file_path + "\" has an invalid run");
+  }
+
+  return trace;
+}
+
+void InputTrace::Save(const std::string& file_path) const {
+  std::ofstream file(file_path);
+
+  if (!file.is_open()) {
+    throw std::ios_base::failure("Cannot create \"" + file_path + "\"");
+  }
+
+  file << kFormatHeader << "\n"
+       << "seed " << seed_ << "\n"
+       << "score " << score_ << "\n"
+       << "state " << std::hex << std::setw(16) << std::setfill('0') << state_hash_ << std::dec << "\n";
+
+  for (const Run& run : runs_) {
+    std::string keys;
+
+    for (size_t bit = 0; bit < sizeof(kKeyLetters); bit++) {
+      if (run.keys_ & (1 << bit)) {
+        keys += kKeyLetters[bit];
+      }
+    }
+
+    file << run.frame_count_ << " " << run.elapsed_millis_ << " " << (keys.empty() ? "-" : keys) << "\n";
+  }
+
+  if (file.fail()) {
+    throw std::ios_base::failure("Cannot write \"" + file_path + "\"");
+  }
+}
+
+void InputTrace::Record(unsigned int elapsed_millis, const Uint8* keystate) {
+  const unsigned char keys = KeysFromKeystate(keystate);
+
+  // Extends the last run while the time step and keys are unchanged, which keeps recordings small.
+  if (!runs_.empty() && runs_.back().elapsed_millis_ == elapsed_millis && runs_.back().keys_ == keys) {
+    runs_.back().frame_count_++;
+  } else {
+    runs_.push_back({1, elapsed_millis, keys});
+  }
+
+  frame_count_++;
+}
+
+void InputTrace::set_result(unsigned short score, std::uint64_t state_hash) {
+  score_ = score;
+  state_hash_ = state_hash;
+}
+
+unsigned char InputTrace::KeysFromKeystate(const Uint8* keystate) {
+  unsigned char keys = 0;
+
+  for (size_t bit = 0; bit < kKeyScancodes.size(); bit++) {
+    if (keystate[kKeyScancodes[bit]]) {
+      keys |= static_cast<unsigned char>(1 << bit);
+    }
+  }
+
+  return keys;
+}
+
+void InputTrace::KeystateFromKeys(unsigned char keys, Uint8* keystate) {
+  for (size_t bit = 0; bit < kKeyScancodes.size(); bit++) {
+    keystate[kKeyScancodes[bit]] = (keys & (1 << bit)) ? 1 : 0;
+  }
+}
+
+unsigned int InputTrace::seed() const {
+  return seed_;
+}
+
+const std::vector<InputTrace::Run>& InputTrace::runs() const {
+  return runs_;
+}
+
+std::uint64_t InputTrace::frame_count() const {
+  return frame_count_;
+}
+
+unsigned short InputTrace::score() const {
+  return score_;
+}
+
+std::uint64_t InputTrace::state_hash() const {
+  return state_hash_;
+}
\ No newline at end of file
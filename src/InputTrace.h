@@ -0,0 +1,137 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "SDL_stdinc.h"
+
+/// <summary>
+/// A recording of a game: its random seed, the time step and game keys of every frame, and the
+/// resulting score and state hash. Replaying the frames through PacMan::Update from the same seed
+/// reproduces the game exactly, so a trace is both a workload and a check of determinism.
+/// Consecutive frames with the same time step and keys are stored as a single run.
+/// </summary>
+class InputTrace {
+ public:
+  /// <summary>
+  /// The keys that affect the game, as bits of a key set.
+  /// </summary>
+  enum key : unsigned char {
+    up = 1, down = 2, left = 4, right = 8, escape = 16
+  };
+  /// <summary>
+  /// Consecutive frames that share a time step and key set.
+  /// </summary>
+  struct Run {
+    /// <summary>
+    /// The number of frames in the run.
+    /// </summary>
+    unsigned int frame_count_;
+    /// <summary>
+    /// The time that each frame advances the game by, in milliseconds.
+    /// </summary>
+    unsigned int elapsed_millis_;
+    /// <summary>
+    /// The keys held during each frame.
+    /// </summary>
+    unsigned char keys_;
+  };
+  /// <summary>
+  /// The file extension of trace files.
+  /// </summary>
+  static const std::string kFileExtension;
+  /// <summary>
+  /// Constructor for the InputTrace class. Starts an empty recording.
+  /// </summary>
+  /// <param name="seed">The random seed that the game was started with.</param>
+  InputTrace(unsigned int seed);
+  /// <summary>
+  /// Reads a trace file.
+  /// Throws std::ios_base::failure if the file cannot be read or is malformed.
+  /// </summary>
+  /// <param name="file_path">The path of the trace file.</param>
+  /// <returns>The trace.</returns>
+  static InputTrace Load(const std::string& file_path);
+  /// <summary>
+  /// Writes the trace to a file.
+  /// Throws std::ios_base::failure if the file cannot be written.
+  /// </summary>
+  /// <param name="file_path">The path of the trace file.</param>
+  void Save(const std::string& file_path) const;
+  /// <summary>
+  /// Appends a frame to the recording.
+  /// </summary>
+  /// <param name="elapsed_millis">The time that the frame advanced the game by.</param>
+  /// <param name="keystate">The state of every key during the frame, indexed by SDL scancode.</param>
+  void Record(unsigned int elapsed_millis, const Uint8* keystate);
+  /// <summary>
+  /// Records the outcome of the game, which a replay must reproduce.
+  /// </summary>
+  /// <param name="score">The final score.</param>
+  /// <param name="state_hash">The final hash of the game state.</param>
+  void set_result(unsigned short score, std::uint64_t state_hash);
+  /// <summary>
+  /// Gets the game keys held in a keyboard state.
+  /// </summary>
+  /// <param name="keystate">The state of every key, indexed by SDL scancode.</param>
+  /// <returns>The set of held game keys.</returns>
+  static unsigned char KeysFromKeystate(const Uint8* keystate);
+  /// <summary>
+  /// Sets a keyboard state to hold exactly the keys in a key set.
+  /// </summary>
+  /// <param name="keys">The set of held game keys.</param>
+  /// <param name="keystate">The state of every key, indexed by SDL scancode, to overwrite.</param>
+  static void KeystateFromKeys(unsigned char keys, Uint8* keystate);
+  /// <summary>
+  /// Gets the random seed that the game was started with.
+  /// </summary>
+  /// <returns>The random seed.</returns>
+  unsigned int seed(void) const;
+  /// <summary>
+  /// Gets the recorded frames.
+  /// </summary>
+  /// <returns>The runs of frames, in order.</returns>
+  const std::vector<Run>& runs(void) const;
+  /// <summary>
+  /// Gets the total number of recorded frames.
+  /// </summary>
+  /// <returns>The number of frames.</returns>
+  std::uint64_t frame_count(void) const;
+  /// <summary>
+  /// Gets the final score of the game.
+  /// </summary>
+  /// <returns>The final score.</returns>
+  unsigned short score(void) const;
+  /// <summary>
+  /// Gets the final hash of the game state.
+  /// </summary>
+  /// <returns>The final state hash.</returns>
+  std::uint64_t state_hash(void) const;
+
+ private:
+  /// <summary>
+  /// The random seed that the game was started with.
+  /// </summary>
+  unsigned int seed_;
+  /// <summary>
+  /// The recorded frames, as runs of identical frames.
+  /// </summary>
+  std::vector<Run> runs_;
+  /// <summary>
+  /// The total number of recorded frames.
+  /// </summary>
+  std::uint64_t frame_count_;
+  /// <summary>
+  /// The final score of the game.
+  /// </summary>
+  unsigned short score_;
+  /// <summary>
+  /// The final hash of the game state.
+  /// </summary>
+  std::uint64_t state_hash_;
+};
\ No newline at end of file
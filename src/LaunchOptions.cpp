@@ -0,0 +1,149 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "LaunchOptions.h"
+
+#include <string>
+#include <stdexcept>
+
+#include "Ghosts.h"
+
+const char* LaunchOptions::kUsage =
+  "Usage: Pac-Man [options]\n"
+  "  --headless               Render offscreen at a fixed time step, as fast as possible.\n"
+  "  --frames <count>         The number of frames simulated by a headless run (default 3600).\n"
+  "  --seed <seed>            The random seed (default: the current time).\n"
+  "  --capture <file>         Writes headless frames to <file>, as Y4M if it ends in .y4m, else raw RGBA.\n"
+  "  --pack-assets            Packs the assets into a pre-decoded archive that later runs load instead.\n"
+  "  --texture-budget <KiB>   Evicts the least recently used textures while they exceed the budget.\n"
+  "  --profile                Shows the profiler overlay from the first frame (toggle with F3).\n"
+  "  --trace <file>           Writes a Chrome trace event timeline of every frame to <file>.\n"
+  "  --report <file>          Writes frame time percentiles to <file> as CSV on exit (and on F4).\n"
+  "  --zero-alloc-test        Fails a headless run if a frame allocates once the game has warmed up.\n"
+  "  --record <file>          Records the seed and input of every frame to <file>, for replay by the benchmarks.\n"
+  "  --ghosts <count>         The number of Ghosts in each level (default 4).\n"
+  "  --maze <width>x<height>  Plays a maze generated from the seed instead of the map in the assets.\n"
+  "  --maze-loops <percent>   The chance that each wall between corridors of the maze is removed (default 10).\n"
+  "  --maze-dots <percent>    The chance that each open tile of the maze holds a Dot (default 100).\n"
+  "  --write-maze <file>      Writes the maze's structure to <file> and exits.\n";
+
+namespace {
+  /// <summary>
+  /// Parses a size option value of the form "<width>x<height>".
+  /// </summary>
+  /// <param name="option">The option that the value belongs to, used in error messages.</param>
+  /// <param name="value">The value to parse.</param>
+  /// <param name="width">Set to the parsed width.</param>
+  /// <param name="height">Set to the parsed height.</param>
+  void ParseSize(const std::string& option, const std::string& value, unsigned int& width, unsigned int& height) {
+    const size_t separator = value.find('x');
+
+    if (separator == std::string::npos) {
+      throw std::invalid_argument("Invalid value \"" + value + "\" for " + option);
+    }
+
+    width = LaunchOptions::ParseUnsigned(option, value.substr(0, separator));
+    height = LaunchOptions::ParseUnsigned(option, value.substr(separator + 1));
+  }
+}
+
+unsigned int LaunchOptions::ParseUnsigned(const std::string& option, const std::string& value) {
+  size_t parsed_length = 0;
+  unsigned long result = 0;
+
+  try {
+    result = std::stoul(value, &parsed_length);
+  } catch (const std::exception&) {
+    parsed_length = 0;
+  }
+
+  if (parsed_length == 0 || parsed_length != value.size()) {
+    throw std::invalid_argument("Invalid value \"" + value + "\" for " + option);
+  }
+
+  return static_cast<unsigned int>(result);
+}
+
+LaunchOptions LaunchOptions::Parse(int argc, char** args) {
+  LaunchOptions options {false, 3600, false, 0, "", false, 0, false, "", "", false, "",
+                          Ghosts::kDefaultCount, {0, 0, 0, MazeGenerator::kDefaultLoopPercent, 100}, ""};
+
+  for (int i = 1; i < argc; i++) {
+    const std::string option = args[i];
+
+    // Retrieves the value that follows an option.
+    auto next_value = [&]() -> std::string {
+      if (i + 1 >= argc) {
+        throw std::invalid_argument("Missing value for " + option);
+      }
+
+      return args[++i];
+    };
+
+    if (option == "--headless") {
+      options.headless_ = true;
+    } else if (option == "--frames") {
+      options.frame_count_ = ParseUnsigned(option, next_value());
+    } else if (option == "--seed") {
+      options.seed_ = ParseUnsigned(option, next_value());
+      options.seed_specified_ = true;
+    } else if (option == "--capture") {
+      options.capture_file_path_ = next_value();
+    } else if (option == "--pack-assets") {
+      options.pack_assets_ = true;
+    } else if (option == "--trace") {
+      options.trace_file_path_ = next_value();
+    } else if (option == "--report") {
+      options.report_file_path_ = next_value();
+    } else if (option == "--record") {
+      options.record_file_path_ = next_value();
+    } else if (option == "--zero-alloc-test") {
+      options.zero_allocation_test_ = true;
+    } else if (option == "--profile") {
+      options.show_profiler_ = true;
+    } else if (option == "--ghosts") {
+      options.ghost_count_ = ParseUnsigned(option, next_value());
+    } else if (option == "--maze") {
+      ParseSize(option, next_value(), options.maze_options_.width_, options.maze_options_.height_);
+    } else if (option == "--maze-loops") {
+      options.maze_options_.loop_percent_ = ParseUnsigned(option, next_value());
+    } else if (option == "--maze-dots") {
+      options.maze_options_.dot_percent_ = ParseUnsigned(option, next_value());
+    } else if (option == "--write-maze") {
+      options.maze_file_path_ = next_value();
+    } else if (option == "--texture-budget") {
+      options.texture_budget_bytes_ = static_cast<size_t>(ParseUnsigned(option, next_value())) * 1024;
+    } else {
+      throw std::invalid_argument("Unrecognised option \"" + option + "\"");
+    }
+  }
+
+  if (!options.capture_file_path_.empty() && !options.headless_) {
+    throw std::invalid_argument("--capture requires --headless");
+  }
+
+  if (options.zero_allocation_test_ && !options.headless_) {
+    throw std::invalid_argument("--zero-alloc-test requires --headless");
+  }
+
+  if (options.ghost_count_ == 0) {
+    throw std::invalid_argument("--ghosts requires at least one Ghost");
+  }
+
+  // Replays simulate the default game, so a recording with another number of Ghosts would not replay.
+  if (!options.record_file_path_.empty() && options.ghost_count_ != Ghosts::kDefaultCount) {
+    throw std::invalid_argument("--record requires the default number of Ghosts");
+  }
+
+  if (!options.maze_file_path_.empty() && options.maze_options_.width_ == 0) {
+    throw std::invalid_argument("--write-maze requires --maze");
+  }
+
+  // Replays play the map in the assets.
+  if (!options.record_file_path_.empty() && options.maze_options_.width_ != 0) {
+    throw std::invalid_argument("--record cannot be combined with --maze");
+  }
+
+  return options;
+}
\ No newline at end of file
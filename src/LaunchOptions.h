@@ -0,0 +1,100 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <string>
+
+#include "MazeGenerator.h"
+
+/// <summary>
+/// The command line options that determine how the game is run.
+/// </summary>
+struct LaunchOptions {
+  /// <summary>
+  /// Parses the command line arguments.
+  /// Throws std::invalid_argument if an argument is unrecognised or malformed.
+  /// </summary>
+  /// <param name="argc">The number of arguments.</param>
+  /// <param name="args">The arguments, including the executable path.</param>
+  /// <returns>The parsed options.</returns>
+  static LaunchOptions Parse(int argc, char** args);
+  /// <summary>
+  /// Parses an unsigned integer option value.
+  /// Throws std::invalid_argument if the value is not a whole unsigned integer.
+  /// </summary>
+  /// <param name="option">The option that the value belongs to, used in error messages.</param>
+  /// <param name="value">The value to parse.</param>
+  /// <returns>The parsed value.</returns>
+  static unsigned int ParseUnsigned(const std::string& option, const std::string& value);
+  /// <summary>
+  /// The usage text listing the available options.
+  /// </summary>
+  static const char* kUsage;
+  /// <summary>
+  /// Renders into an offscreen framebuffer instead of a window, advancing by a fixed time step
+  /// as fast as possible.
+  /// </summary>
+  bool headless_;
+  /// <summary>
+  /// The number of frames simulated by a headless run.
+  /// </summary>
+  unsigned int frame_count_;
+  /// <summary>
+  /// True if a random seed was given, else the seed is taken from the current time.
+  /// </summary>
+  bool seed_specified_;
+  /// <summary>
+  /// The random seed.
+  /// </summary>
+  unsigned int seed_;
+  /// <summary>
+  /// The file that headless frames are captured to. Empty if frames are not captured.
+  /// </summary>
+  std::string capture_file_path_;
+  /// <summary>
+  /// Packs the "assets" folder into the asset archive and exits, instead of running the game.
+  /// </summary>
+  bool pack_assets_;
+  /// <summary>
+  /// The GPU memory budget for textures in bytes. Zero if textures are never evicted.
+  /// </summary>
+  size_t texture_budget_bytes_;
+  /// <summary>
+  /// Shows the profiler overlay from the first frame. The overlay can also be toggled with F3.
+  /// </summary>
+  bool show_profiler_;
+  /// <summary>
+  /// The file that a Chrome trace event timeline is written to. Empty if the game is not traced.
+  /// </summary>
+  std::string trace_file_path_;
+  /// <summary>
+  /// The CSV file that frame time percentiles are written to on exit and when F4 is pressed.
+  /// Empty if the report is only written when F4 is pressed, to the default file.
+  /// </summary>
+  std::string report_file_path_;
+  /// <summary>
+  /// Fails a headless run if any heap allocation is made during a steady-state frame, once the game has warmed up.
+  /// </summary>
+  bool zero_allocation_test_;
+  /// <summary>
+  /// The file that the seed and input of every frame are recorded to, for replay by the benchmarks.
+  /// Empty if the game is not recorded.
+  /// </summary>
+  std::string record_file_path_;
+  /// <summary>
+  /// The number of Ghosts in each level.
+  /// </summary>
+  unsigned int ghost_count_;
+  /// <summary>
+  /// The size, loops and Dots of the generated maze that is played instead of the map in the assets.
+  /// The width is zero if the map in the assets is played. The seed is the random seed of the run.
+  /// </summary>
+  MazeOptions maze_options_;
+  /// <summary>
+  /// Writes the generated maze's structure to this file and exits, instead of running the game.
+  /// Empty if the maze is not written.
+  /// </summary>
+  std::string maze_file_path_;
+};
\ No newline at end of file
@@ -0,0 +1,97 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "LevelArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+LevelArena::LevelArena(size_t block_size)
+    : block_size_(block_size),
+      first_block_(nullptr),
+      current_block_(nullptr),
+      cursor_(nullptr),
+      end_(nullptr),
+      previous_blocks_used_bytes_(0),
+      last_finalizer_(nullptr) {}
+
+LevelArena::~LevelArena() {
+  Release();
+
+  while (first_block_) {
+    Block* next = first_block_->next_;
+    delete[] reinterpret_cast<unsigned char*>(first_block_);
+    first_block_ = next;
+  }
+}
+
+void* LevelArena::Allocate(size_t size, size_t alignment) {
+  // The padding that aligns the cursor.
+  size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(cursor_) % alignment) % alignment;
+
+  if (!cursor_ || size + padding > static_cast<size_t>(end_ - cursor_)) {
+    NextBlock(size + alignment);
+    padding = (alignment - reinterpret_cast<std::uintptr_t>(cursor_) % alignment) % alignment;
+  }
+
+  void* memory = cursor_ + padding;
+  cursor_ += padding + size;
+
+  return memory;
+}
+
+void LevelArena::Release() {
+  while (last_finalizer_) {
+    last_finalizer_->destroy_(last_finalizer_->object_);
+    last_finalizer_ = last_finalizer_->previous_;
+  }
+
+  // The blocks are kept, so the next level is placed in the same memory.
+  current_block_ = first_block_;
+  cursor_ = first_block_ ? BlockData(first_block_) : nullptr;
+  end_ = first_block_ ? cursor_ + first_block_->size_ : nullptr;
+  previous_blocks_used_bytes_ = 0;
+}
+
+size_t LevelArena::used_bytes() const {
+  return current_block_ ? previous_blocks_used_bytes_ + (cursor_ - BlockData(current_block_)) : 0;
+}
+
+void LevelArena::NextBlock(size_t size) {
+  if (current_block_) {
+    previous_blocks_used_bytes_ += cursor_ - BlockData(current_block_);
+  }
+
+  // Reuses the blocks kept by earlier levels, skipping any that are too small for the allocation.
+  Block* block = current_block_ ? current_block_->next_ : first_block_;
+  Block* last_block = current_block_;
+
+  while (block && block->size_ < size) {
+    last_block = block;
+    block = block->next_;
+  }
+
+  if (!block) {
+    const size_t block_size = std::max(block_size_, size);
+
+    // The data follows the header, which is padded to the strictest fundamental alignment.
+    block = reinterpret_cast<Block*>(new unsigned char[sizeof(Block) + alignof(std::max_align_t) + block_size]);
+    block->next_ = nullptr;
+    block->size_ = block_size;
+
+    if (last_block) {
+      last_block->next_ = block;
+    } else {
+      first_block_ = block;
+    }
+  }
+
+  current_block_ = block;
+  cursor_ = BlockData(block);
+  end_ = cursor_ + block->size_;
+}
+
+unsigned char* LevelArena::BlockData(Block* block) {
+  return reinterpret_cast<unsigned char*>(block) + sizeof(Block) + alignof(std::max_align_t);
+}
\ No newline at end of file
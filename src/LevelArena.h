@@ -0,0 +1,171 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+
+/// <summary>
+/// A bump allocator for the objects of a level, such as its tiles, items and entities.
+/// Objects are placed one after another in large blocks and are never freed individually.
+/// Release destroys every object at once and rewinds to the first block, keeping the blocks,
+/// so loading the next level reuses the same memory without allocating.
+/// </summary>
+class LevelArena {
+ public:
+  /// <summary>
+  /// Constructor for the LevelArena class. Blocks are allocated when first needed.
+  /// </summary>
+  /// <param name="block_size">The size of each block in bytes. Larger objects get a block of their own.</param>
+  LevelArena(size_t block_size = kDefaultBlockSize);
+  /// <summary>
+  /// Destructor for the LevelArena class.
+  /// Destroys every object and frees the blocks.
+  /// </summary>
+  ~LevelArena(void);
+  /// <summary>
+  /// Constructs an object in the arena. The object lives until the arena is released.
+  /// </summary>
+  /// <param name="args">The arguments of the object's constructor.</param>
+  /// <returns>The object.</returns>
+  template <typename T, typename... Args>
+  T* Create(Args&&... args);
+  /// <summary>
+  /// Constructs an array of value-initialised objects in the arena. The objects live until the arena is released,
+  /// and must not need destroying.
+  /// </summary>
+  /// <param name="count">The number of objects.</param>
+  /// <returns>The first object.</returns>
+  template <typename T>
+  T* CreateArray(size_t count);
+  /// <summary>
+  /// Reserves uninitialised memory in the arena.
+  /// </summary>
+  /// <param name="size">The number of bytes.</param>
+  /// <param name="alignment">The alignment of the memory, which must be a power of two.</param>
+  /// <returns>The memory.</returns>
+  void* Allocate(size_t size, size_t alignment);
+  /// <summary>
+  /// Destroys every object in the arena, in the reverse order of their creation, and rewinds to the first block.
+  /// </summary>
+  void Release(void);
+  /// <summary>
+  /// Gets the number of bytes used since the arena was last released, including alignment padding.
+  /// </summary>
+  /// <returns>The number of bytes used.</returns>
+  size_t used_bytes(void) const;
+  /// <summary>
+  /// The size of each block if none is given.
+  /// </summary>
+  static const size_t kDefaultBlockSize = 64 * 1024;
+
+ private:
+  /// <summary>
+  /// Copy constructor for the LevelArena class.
+  /// </summary>
+  /// <param name="reference">The LevelArena reference to copy.</param>
+  LevelArena(LevelArena const& reference);
+  /// <summary>
+  /// The header at the start of each block, which links the blocks in order.
+  /// </summary>
+  struct Block {
+    /// <summary>
+    /// The next block, or null if this is the last.
+    /// </summary>
+    Block* next_;
+    /// <summary>
+    /// The number of bytes after the header.
+    /// </summary>
+    size_t size_;
+  };
+  /// <summary>
+  /// Records an object whose destructor must run when the arena is released.
+  /// </summary>
+  struct Finalizer {
+    /// <summary>
+    /// Destroys the object.
+    /// </summary>
+    void (*destroy_)(void* object);
+    /// <summary>
+    /// The object to destroy.
+    /// </summary>
+    void* object_;
+    /// <summary>
+    /// The finalizer of the previously created object, or null if this is the first.
+    /// </summary>
+    Finalizer* previous_;
+  };
+  /// <summary>
+  /// Moves to the next block that can hold an allocation, adding a block if none can.
+  /// </summary>
+  /// <param name="size">The number of bytes needed, including alignment padding.</param>
+  void NextBlock(size_t size);
+  /// <summary>
+  /// Gets the first usable byte of a block.
+  /// </summary>
+  /// <param name="block">The block.</param>
+  /// <returns>The byte after the block's header.</returns>
+  static unsigned char* BlockData(Block* block);
+  /// <summary>
+  /// The size of each block in bytes.
+  /// </summary>
+  const size_t block_size_;
+  /// <summary>
+  /// The first block, or null if nothing has been allocated.
+  /// </summary>
+  Block* first_block_;
+  /// <summary>
+  /// The block that allocations are made from.
+  /// </summary>
+  Block* current_block_;
+  /// <summary>
+  /// The next free byte of the current block.
+  /// </summary>
+  unsigned char* cursor_;
+  /// <summary>
+  /// The byte after the end of the current block.
+  /// </summary>
+  unsigned char* end_;
+  /// <summary>
+  /// The bytes used in the blocks before the current block.
+  /// </summary>
+  size_t previous_blocks_used_bytes_;
+  /// <summary>
+  /// The finalizer of the most recently created object that has a destructor.
+  /// </summary>
+  Finalizer* last_finalizer_;
+};
+
+template <typename T, typename... Args>
+T* LevelArena::Create(Args&&... args) {
+  T* object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+  // Objects without a destructor, such as map chunks, are released with the memory and need no record.
+  if (!std::is_trivially_destructible<T>::value) {
+    Finalizer* finalizer = static_cast<Finalizer*>(Allocate(sizeof(Finalizer), alignof(Finalizer)));
+
+    finalizer->destroy_ = [](void* destroyed) { static_cast<T*>(destroyed)->~T(); };
+    finalizer->object_ = object;
+    finalizer->previous_ = last_finalizer_;
+    last_finalizer_ = finalizer;
+  }
+
+  return object;
+}
+
+template <typename T>
+T* LevelArena::CreateArray(size_t count) {
+  static_assert(std::is_trivially_destructible<T>::value, "Arrays are released without destroying their objects");
+
+  T* objects = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+
+  for (size_t i = 0; i < count; i++) {
+    new (objects + i) T();
+  }
+
+  return objects;
+}
\ No newline at end of file
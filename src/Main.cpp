@@ -4,6 +4,8 @@
 
 #include <time.h>
 #include <iostream>
+#include <fstream>
+#include <stdexcept>
 
 #include "SDL.h"
 #include "SDL_image.h"
@@ -13,17 +15,46 @@
 #include "ResourceManager.h"
 #include "PacMan.h"
 #include "Drawer.h"
+#include "LaunchOptions.h"
+#include "OffscreenFramebuffer.h"
+#include "FrameWriter.h"
+#include "ThreadPool.h"
+#include "AssetArchive.h"
+#include "Profiler.h"
+#include "TraceWriter.h"
+#include "InputTrace.h"
+#include "MazeGenerator.h"
 
 extern const unsigned char kXOffset = 177;
 extern const unsigned char kYOffset = 60;
 
-const unsigned short kWindowWidth = 1024;
-const unsigned short kWindowHeight = 768;
+extern const unsigned short kWindowWidth = 1024;
+extern const unsigned short kWindowHeight = 768;
 const float kUpdateDelay = 1000.f / 60.f;
+// Headless runs advance by the frame time that the windowed game loop settles on.
+const unsigned int kHeadlessStepMillis = 17;
+// The zero allocation test ignores the first frames, which fill caches and grow buffers to their working size.
+const unsigned int kAllocationWarmupFrames = 120;
+
+// Converts the difference between two performance counter values into milliseconds.
+static double GetElapsedMillis(Uint64 start_counter, Uint64 end_counter) {
+	return (end_counter - start_counter) * 1000.0 / SDL_GetPerformanceFrequency();
+}
 
 int main(int argc, char** args) {
-	// Initialises SDL.
-	if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+	auto startup_counter = SDL_GetPerformanceCounter();
+	LaunchOptions options;
+
+	try {
+		options = LaunchOptions::Parse(argc, args);
+	}
+	catch (const std::invalid_argument& e) {
+		std::cerr << e.what() << std::endl << LaunchOptions::kUsage;
+		exit(EXIT_FAILURE);
+	}
+
+	// Initialises SDL. Headless runs do not need a video device.
+	if (SDL_Init(options.headless_ ? 0 : SDL_INIT_VIDEO) < 0) {
 		assert(0 && "Failed to initialize video!");
 		exit(-1);
 	}
@@ -32,70 +63,328 @@ int main(int argc, char** args) {
 	at_quick_exit(SDL_Quit);
 	atexit(SDL_Quit);
 
+	// Packs the assets into an archive, which later runs map instead of decoding each image.
+	if (options.pack_assets_) {
+		IMG_Init(IMG_INIT_PNG);
+
+		try {
+			// Instance generates the asset path that the archive is written to.
+			ResourceManager::Instance();
+			auto archive_path = ResourceManager::GetAssetFilePath(AssetArchive::kFileName);
+			auto entry_count = AssetArchive::Pack(ResourceManager::kAssetPath, archive_path);
+
+			std::cout << "Packed " << entry_count << " assets into " << archive_path << std::endl;
+		}
+		catch (const std::exception& e) {
+			std::cerr << "Exception: " << e.what() << std::endl;
+			exit(EXIT_FAILURE);
+		}
+
+		return 0;
+	}
+
+	if (!options.report_file_path_.empty()) {
+		Profiler::Instance().set_report_file_path(options.report_file_path_);
+	}
+
+	// Shows the profiler overlay from the first frame.
+	if (options.show_profiler_) {
+		Profiler::Instance().ToggleOverlay();
+	}
+
 	// Initialise random seed.
-	srand(static_cast<unsigned int>(time(0)));
-	
-	// Generates viewport with dimension 1024px x 768px.
-	SDL_Window* window = SDL_CreateWindow("Pac-Man", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, kWindowWidth, kWindowHeight, SDL_WINDOW_OPENGL);
-	SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-
-	if (!window) {
-		assert(0 && "Failed to create window!");
-		exit(EXIT_FAILURE);
+	auto seed = options.seed_specified_ ? options.seed_ : static_cast<unsigned int>(time(0));
+	srand(seed);
+
+	// Generates the maze played instead of the map in the assets, from the seed of the run.
+	std::string map_structure;
+
+	if (options.maze_options_.width_ != 0) {
+		options.maze_options_.seed_ = seed;
+
+		try {
+			map_structure = MazeGenerator::Generate(options.maze_options_);
+		}
+		catch (const std::invalid_argument& e) {
+			std::cerr << e.what() << std::endl << LaunchOptions::kUsage;
+			exit(EXIT_FAILURE);
+		}
+
+		// Writes the maze, so it can be inspected or used as a map, instead of running the game.
+		if (!options.maze_file_path_.empty()) {
+			std::ofstream maze_file(options.maze_file_path_, std::ios::binary);
+			maze_file << map_structure;
+
+			if (!maze_file) {
+				std::cerr << "Exception: Failed to write " << options.maze_file_path_ << std::endl;
+				exit(EXIT_FAILURE);
+			}
+
+			std::cout << "Wrote a " << options.maze_options_.width_ << "x" << options.maze_options_.height_
+				<< " maze with seed " << seed << " to " << options.maze_file_path_ << std::endl;
+			return 0;
+		}
 	}
 
-	if (!renderer) {
-		assert(0 && "Failed to create renderer!");
-		exit(EXIT_FAILURE);
+	// Records the input of every frame, so the game can be replayed from the same seed.
+	InputTrace* input_trace = options.record_file_path_.empty() ? nullptr : new InputTrace(seed);
+
+	SDL_Window* window = nullptr;
+	SDL_Renderer* renderer = nullptr;
+	OffscreenFramebuffer* framebuffer = nullptr;
+	FrameWriter* frame_writer = nullptr;
+	TraceWriter* trace_writer = nullptr;
+
+	// Traces every profiled zone from startup onwards, including asset loads.
+	if (!options.trace_file_path_.empty()) {
+		try {
+			trace_writer = new TraceWriter(options.trace_file_path_);
+		}
+		catch (const std::exception& e) {
+			std::cerr << "Exception: " << e.what() << std::endl;
+			exit(EXIT_FAILURE);
+		}
+
+		Profiler::Instance().set_trace_writer(trace_writer);
 	}
 
-	IMG_Init(IMG_INIT_JPG | IMG_INIT_PNG);
+	if (options.headless_) {
+		// Renders into an in-memory framebuffer with dimension 1024px x 768px.
+		try {
+			framebuffer = new OffscreenFramebuffer(kWindowWidth, kWindowHeight);
+
+			if (!options.capture_file_path_.empty()) {
+				frame_writer = new FrameWriter(options.capture_file_path_,
+					FrameWriter::FormatFromFilePath(options.capture_file_path_), kWindowWidth, kWindowHeight,
+					kHeadlessStepMillis);
+			}
+		}
+		catch (const std::exception& e) {
+			std::cerr << "Exception: " << e.what() << std::endl;
+			exit(EXIT_FAILURE);
+		}
+
+		renderer = framebuffer->renderer();
+	} else {
+		// Generates viewport with dimension 1024px x 768px.
+		window = SDL_CreateWindow("Pac-Man", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, kWindowWidth, kWindowHeight, SDL_WINDOW_OPENGL);
+		renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+
+		if (!window) {
+			assert(0 && "Failed to create window!");
+			exit(EXIT_FAILURE);
+		}
+
+		if (!renderer) {
+			assert(0 && "Failed to create renderer!");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	auto renderer_counter = SDL_GetPerformanceCounter();
 
 	if (TTF_Init() == -1) {
 		assert(0 && "Failed to create ttf!");
 		exit(EXIT_FAILURE);
 	}
 
-	// Sets the font used in the game UI.
+	// Workers shared by tasks that can run in parallel, such as decoding images.
+	ThreadPool thread_pool;
+	ResourceManager::PreloadTimings preload_timings;
+
+	// Sets the font used in the game UI, and loads every image before the first frame.
 	try {
+		// Images only need decoding when there is no pre-decoded asset archive.
+		if (!ResourceManager::Instance().OpenArchive()) {
+			IMG_Init(IMG_INIT_PNG);
+		}
+
+		ResourceManager::Instance().set_texture_budget(options.texture_budget_bytes_);
 		ResourceManager::Instance().set_font("Fonts\\Pac-Man.ttf");
+		preload_timings = ResourceManager::Instance().Preload(renderer, thread_pool);
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Exception: " << e.what() << std::endl;
 		exit(EXIT_FAILURE);
 	}
 
+	auto preload_counter = SDL_GetPerformanceCounter();
+
 	auto drawer = new Drawer(renderer);
-	PacMan pacman = PacMan::Instance(drawer);
+	PacMan& pacman = PacMan::Instance(drawer, options.ghost_count_, map_structure);
+
+	auto game_counter = SDL_GetPerformanceCounter();
+
+	// Logs a breakdown of the time taken to start the game.
+	std::cout << "Startup took " << GetElapsedMillis(startup_counter, game_counter) << " ms" << std::endl
+		<< "  SDL and renderer: " << GetElapsedMillis(startup_counter, renderer_counter) << " ms" << std::endl
+		<< "  Font and images: " << GetElapsedMillis(renderer_counter, preload_counter) << " ms ("
+		<< preload_timings.image_count_ << " images; ";
+
+	if (preload_timings.from_archive_) {
+		std::cout << "pre-decoded from " << AssetArchive::kFileName;
+	} else {
+		std::cout << "enumerate " << preload_timings.enumerate_millis_ << " ms, decode " << preload_timings.decode_millis_
+			<< " ms on " << preload_timings.thread_count_ << " threads";
+	}
+
+	std::cout << ", upload " << preload_timings.upload_millis_ << " ms)" << std::endl
+		<< "  Game: " << GetElapsedMillis(preload_counter, game_counter) << " ms" << std::endl;
 
 	auto last_ticks = SDL_GetTicks();
+	auto start_ticks = last_ticks;
 	SDL_Event event;
 
   // Sets the colour to black upon clearing the viewport.
 	SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
 
 	unsigned int elapsed_millis;
+	unsigned int frame = 0;
+	unsigned int allocating_frame_count = 0;
 
 	while (SDL_PollEvent(&event) >= 0) {
-		while ((elapsed_millis = SDL_GetTicks() - last_ticks) < kUpdateDelay) {
-			SDL_Delay(0);
+		if (options.headless_) {
+			// Headless runs advance by a fixed step without waiting, so each run is reproducible.
+			if (frame == options.frame_count_) {
+				break;
+			}
+
+			elapsed_millis = kHeadlessStepMillis;
+		} else {
+			while ((elapsed_millis = SDL_GetTicks() - last_ticks) < kUpdateDelay) {
+				SDL_Delay(0);
+			}
 		}
 
+		auto frame_counter = SDL_GetPerformanceCounter();
+		Profiler::Instance().BeginFrame();
+
 		// Clears the screen to black.
 		SDL_RenderClear(renderer);
-		// Adds game elements to the drawing buffer.
+		// Adds game elements to the drawing batch.
 		pacman.Draw(elapsed_millis);
+		// Sorts the batch and adds it to the drawing buffer.
+		drawer->Flush();
 		// Draws from the buffer.
-		SDL_RenderPresent(renderer);
+		{
+			ScopedTimer timer(ProfileZone::render_present);
+			SDL_RenderPresent(renderer);
+		}
+
+		// Queues the completed frame to be written by the capture thread.
+		if (frame_writer) {
+			frame_writer->Submit(framebuffer->pixels(), framebuffer->pitch());
+		}
+
+		// Evicts textures beyond the budget, now that the frame no longer refers to them.
+		ResourceManager::Instance().EndFrame();
 
-		if (!pacman.Update(elapsed_millis)) {
+		auto keystate = SDL_GetKeyboardState(NULL);
+
+		if (input_trace) {
+			input_trace->Record(elapsed_millis, keystate);
+		}
+
+		if (!pacman.Update(elapsed_millis, keystate)) {
 			break;
 		}
 
+		// Collects the frame's timings for the profiler overlay.
+		Profiler::Instance().EndFrame();
+
+		// Reports every steady-state frame that allocated, which fails the zero allocation test.
+		if (options.zero_allocation_test_ && frame >= kAllocationWarmupFrames && Profiler::Instance().frame_allocations() > 0) {
+			std::cerr << "Frame " << frame << " made " << Profiler::Instance().frame_allocations() << " heap allocations"
+				<< std::endl;
+			allocating_frame_count++;
+		}
+
+		// Marks the whole frame in the trace, so its phases are grouped beneath it.
+		if (trace_writer) {
+			trace_writer->Submit("FRAME", "frame", frame_counter, SDL_GetPerformanceCounter(), SDL_ThreadID());
+		}
+
 		last_ticks = SDL_GetTicks();
+		frame++;
+	}
+
+	if (options.headless_) {
+		auto run_millis = SDL_GetTicks() - start_ticks;
+
+		// Reports the speed of the run relative to real time, and the hash of the final frame.
+		std::cout << "Rendered " << frame << " frames in " << run_millis << " ms ("
+			<< (frame * kHeadlessStepMillis) / static_cast<float>(run_millis > 0 ? run_millis : 1) << "x real time)" << std::endl
+			<< "Final frame hash: " << std::hex << framebuffer->Hash() << std::dec << std::endl;
+
+		auto texture_metrics = ResourceManager::Instance().metrics();
+
+		// Reports the GPU memory used by textures, and how often the budget forced them to be reloaded.
+		std::cout << "Textures: " << texture_metrics.texture_count_ << " loaded, " << texture_metrics.texture_bytes_ / 1024
+			<< " KiB (peak " << texture_metrics.peak_texture_bytes_ / 1024 << " KiB), " << texture_metrics.load_count_
+			<< " loads, " << texture_metrics.eviction_count_ << " evictions" << std::endl;
+
+		auto path_cache_metrics = pacman.path_cache_metrics();
+
+		// Reports how many of the Ghosts' paths were copied from the path cache rather than searched for.
+		std::cout << "Path cache: " << path_cache_metrics.hit_count_ << " hits, " << path_cache_metrics.miss_count_
+			<< " misses, " << path_cache_metrics.eviction_count_ << " evictions" << std::endl;
+
+		auto& frame_histogram = Profiler::Instance().frame_histogram();
+
+		// Reports how many frames took longer to process than the windowed game allows.
+		std::cout << "Frames over budget: " << frame_histogram.over_threshold_count() << " of " << frame_histogram.count()
+			<< " (p99 " << frame_histogram.ValueAtPercentile(99.0) / 1000000.0 << " ms)" << std::endl;
+
+		if (options.zero_allocation_test_) {
+			auto steady_frame_count = frame > kAllocationWarmupFrames ? frame - kAllocationWarmupFrames : 0;
+
+			std::cout << "Zero allocation test " << (allocating_frame_count == 0 ? "passed" : "failed") << ": "
+				<< allocating_frame_count << " of " << steady_frame_count << " steady-state frames allocated" << std::endl;
+		}
+	}
+
+	// Writes the percentiles of the frame, update and present times.
+	if (!options.report_file_path_.empty()) {
+		try {
+			Profiler::Instance().WriteReport();
+		}
+		catch (const std::exception& e) {
+			std::cerr << "Exception: " << e.what() << std::endl;
+		}
+	}
+
+	// Writes the recording with the outcome that a replay must reproduce.
+	if (input_trace) {
+		input_trace->set_result(pacman.score(), pacman.StateHash());
+
+		try {
+			input_trace->Save(options.record_file_path_);
+			std::cout << "Recorded " << input_trace->frame_count() << " frames to " << options.record_file_path_ << std::endl;
+		}
+		catch (const std::exception& e) {
+			std::cerr << "Exception: " << e.what() << std::endl;
+		}
+
+		delete input_trace;
+	}
+
+	// Finishes writing any queued frames and trace events. A capture that could not be written fails the run.
+	bool capture_failed = false;
+
+	if (frame_writer) {
+		try {
+			frame_writer->Close();
+		}
+		catch (const std::exception& e) {
+			std::cerr << "Exception: " << e.what() << std::endl;
+			capture_failed = true;
+		}
 	}
 
+	Profiler::Instance().set_trace_writer(nullptr);
+	delete trace_writer;
+	delete frame_writer;
 	delete drawer;
 
-	return 0;
+	return allocating_frame_count == 0 && !capture_failed ? 0 : EXIT_FAILURE;
 }
\ No newline at end of file
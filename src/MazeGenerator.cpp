@@ -0,0 +1,306 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "MazeGenerator.h"
+
+#include <array>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+
+#include "TileCoordinate.h"
+
+namespace {
+  /// <summary>
+  /// The Ghosts' base and the corridor around it, stamped with its top left corner at kBaseX, kBaseY so the
+  /// Ghosts start and leave the base where the game expects. It matches the base of the map in the assets.
+  /// </summary>
+  const std::array<const char*, 9> kBase {{
+    "xxxx xx xxxx",
+    "x   R  P   x",
+    "x xxx--xxx x",
+    "x x      x x",
+    "  x  H   x  ",
+    "x x      x x",
+    "x xxxxxxxx x",
+    "x          x",
+    "x xxxxxxxx x"
+  }};
+  /// <summary>
+  /// The x-coordinate of the left column of the base.
+  /// </summary>
+  const unsigned int kBaseX = 9;
+  /// <summary>
+  /// The y-coordinate of the top row of the base.
+  /// </summary>
+  const unsigned int kBaseY = 9;
+  /// <summary>
+  /// The number of tiles along each row of the base.
+  /// </summary>
+  const unsigned int kBaseWidth = 12;
+  /// <summary>
+  /// The row that holds the tunnels on the left and right edges of the map.
+  /// </summary>
+  const unsigned int kTunnelY = 13;
+  /// <summary>
+  /// The row that the Avatar starts on, between the tiles kAvatarX and kAvatarX + 1.
+  /// </summary>
+  const unsigned int kAvatarY = 22;
+  /// <summary>
+  /// The left tile of the two that the Avatar starts between.
+  /// </summary>
+  const unsigned int kAvatarX = 14;
+  /// <summary>
+  /// The area of the map in the assets, which has four PowerPellets. Larger mazes have as many per this area.
+  /// </summary>
+  const unsigned int kPowerPelletArea = MazeGenerator::kMinWidth * MazeGenerator::kMinHeight;
+  /// <summary>
+  /// The marker of a tile reached by the search that joins corridors, that is joined to the Avatar's corridors.
+  /// The markers 1 to 4 are the directions back towards them, and 0 a tile that has not been reached.
+  /// </summary>
+  const unsigned char kJoined = 5;
+}
+
+std::string MazeGenerator::Generate(const MazeOptions& options) {
+  const unsigned int width = options.width_;
+  const unsigned int height = options.height_;
+
+  if (width < kMinWidth || height < kMinHeight || width > kMaxMapDimension || height > kMaxMapDimension) {
+    throw std::invalid_argument("A maze must be from " + std::to_string(kMinWidth) + "x" + std::to_string(kMinHeight) +
+                                " to " + std::to_string(kMaxMapDimension) + "x" + std::to_string(kMaxMapDimension) + " tiles");
+  }
+
+  if (options.loop_percent_ > 100 || options.dot_percent_ > 100) {
+    throw std::invalid_argument("The loop and Dot percentages of a maze must be at most 100");
+  }
+
+  // The mt19937 sequence is the same on every platform, and is reduced with % so the mazes are too.
+  std::mt19937 random(options.seed_);
+  std::vector<char> tiles(static_cast<size_t>(width) * height, 'x');
+
+  auto index = [width](unsigned int x, unsigned int y) {
+    return static_cast<size_t>(y) * width + x;
+  };
+
+  // Corridors run through every other tile, two tiles in from the left and right edges and from the top row.
+  const unsigned int cell_columns = (width - 3) / 2;
+  const unsigned int cell_rows = (height + 1) / 2;
+
+  auto cell_tile = [&](unsigned int cell) {
+    return index(2 + (cell % cell_columns) * 2, (cell / cell_columns) * 2);
+  };
+
+  /*
+   * Carves a spanning tree of the lattice with a depth-first search from the Avatar's corridor, which reaches
+   * every corridor by exactly one route. The search is iterative, so large mazes do not overflow the stack.
+   */
+  {
+    std::vector<bool> visited(static_cast<size_t>(cell_columns) * cell_rows, false);
+    std::vector<unsigned int> stack;
+    const unsigned int first_cell = (kAvatarY / 2) * cell_columns + (kAvatarX - 2) / 2;
+
+    visited[first_cell] = true;
+    tiles[cell_tile(first_cell)] = ' ';
+    stack.push_back(first_cell);
+
+    while (!stack.empty()) {
+      const unsigned int cell = stack.back();
+      const unsigned int column = cell % cell_columns;
+      const unsigned int row = cell / cell_columns;
+      std::array<unsigned int, 4> neighbours;
+      unsigned int neighbour_count = 0;
+
+      if (row > 0 && !visited[cell - cell_columns]) {
+        neighbours[neighbour_count++] = cell - cell_columns;
+      }
+
+      if (row + 1 < cell_rows && !visited[cell + cell_columns]) {
+        neighbours[neighbour_count++] = cell + cell_columns;
+      }
+
+      if (column > 0 && !visited[cell - 1]) {
+        neighbours[neighbour_count++] = cell - 1;
+      }
+
+      if (column + 1 < cell_columns && !visited[cell + 1]) {
+        neighbours[neighbour_count++] = cell + 1;
+      }
+
+      if (neighbour_count == 0) {
+        stack.pop_back();
+        continue;
+      }
+
+      const unsigned int next = neighbours[random() % neighbour_count];
+      const size_t from_tile = cell_tile(cell);
+      const size_t to_tile = cell_tile(next);
+
+      // Opens the wall between the corridors, which lies halfway between their tiles.
+      tiles[(from_tile + to_tile) / 2] = ' ';
+      tiles[to_tile] = ' ';
+      visited[next] = true;
+      stack.push_back(next);
+    }
+  }
+
+  // Removes walls between neighbouring corridors by chance, which joins them into loops.
+  for (unsigned int row = 0; row < cell_rows; row++) {
+    for (unsigned int column = 0; column < cell_columns; column++) {
+      const size_t tile = cell_tile(row * cell_columns + column);
+
+      if (column + 1 < cell_columns && random() % 100 < options.loop_percent_) {
+        tiles[tile + 1] = ' ';
+      }
+
+      if (row + 1 < cell_rows && random() % 100 < options.loop_percent_) {
+        tiles[tile + width] = ' ';
+      }
+    }
+  }
+
+  // Stamps the base, and opens the corridors above its exits and the Avatar's starting corridor.
+  for (unsigned int y = 0; y < kBase.size(); y++) {
+    std::copy(kBase[y], kBase[y] + kBaseWidth, tiles.begin() + index(kBaseX, kBaseY + y));
+  }
+
+  tiles[index(kBaseX + 4, kBaseY - 1)] = ' ';
+  tiles[index(kBaseX + 7, kBaseY - 1)] = ' ';
+
+  for (unsigned int x = kAvatarX - 1; x <= kAvatarX + 2; x++) {
+    tiles[index(x, kAvatarY)] = ' ';
+  }
+
+  // Carves the tunnels on both edges, joined by a portal each way at the ends of the row.
+  tiles[index(0, kTunnelY)] = '1';
+  tiles[index(1, kTunnelY)] = 'B';
+  tiles[index(2, kTunnelY)] = ' ';
+  tiles[index(width - 2, kTunnelY)] = 'A';
+  tiles[index(width - 1, kTunnelY)] = '2';
+  tiles[index(width - 3, kTunnelY)] = ' ';
+  tiles[index(width - 4, kTunnelY)] = ' ';
+
+  // The base and the edge columns, which hold the portals, are never carved into.
+  auto is_protected = [&](unsigned int x, unsigned int y) {
+    return (x >= kBaseX && x < kBaseX + kBaseWidth && y >= kBaseY && y < kBaseY + kBase.size()) ||
+           x < 2 || x >= width - 2;
+  };
+
+  /*
+   * The stamps may have cut corridors off from the rest. A breadth-first search spreads from the corridors
+   * joined to the Avatar's, through walls, and whenever it meets a corridor that is not yet joined, carves the
+   * walls it crossed to reach it and joins the corridor, so every open tile can be reached.
+   */
+  {
+    std::vector<unsigned char> markers(tiles.size(), 0);
+    std::vector<size_t> queue;
+    size_t queue_front = 0;
+    std::vector<size_t> flood;
+
+    // Joins every open tile that can be reached from a tile, and queues them to spread from.
+    auto join = [&](size_t first_tile) {
+      markers[first_tile] = kJoined;
+      flood.push_back(first_tile);
+
+      while (!flood.empty()) {
+        const size_t tile = flood.back();
+        const unsigned int x = static_cast<unsigned int>(tile % width);
+        const unsigned int y = static_cast<unsigned int>(tile / width);
+
+        flood.pop_back();
+        queue.push_back(tile);
+
+        for (size_t neighbour : {y > 0 ? tile - width : tile, y + 1 < height ? tile + width : tile,
+                                 x > 0 ? tile - 1 : tile, x + 1 < width ? tile + 1 : tile}) {
+          if (tiles[neighbour] != 'x' && markers[neighbour] != kJoined) {
+            markers[neighbour] = kJoined;
+            flood.push_back(neighbour);
+          }
+        }
+      }
+    };
+
+    join(index(kAvatarX, kAvatarY));
+
+    while (queue_front < queue.size()) {
+      const size_t tile = queue[queue_front++];
+      const unsigned int x = static_cast<unsigned int>(tile % width);
+      const unsigned int y = static_cast<unsigned int>(tile / width);
+
+      // The direction markers 1 to 4 lead back up, down, left and right respectively.
+      const std::array<size_t, 4> neighbours {{
+        y + 1 < height ? tile + width : tile, y > 0 ? tile - width : tile,
+        x + 1 < width ? tile + 1 : tile, x > 0 ? tile - 1 : tile
+      }};
+
+      for (unsigned char direction = 0; direction < 4; direction++) {
+        const size_t neighbour = neighbours[direction];
+
+        if (markers[neighbour] != 0) {
+          continue;
+        }
+
+        if (tiles[neighbour] != 'x') {
+          // Carves the walls crossed on the way back to the joined corridors, then joins the corridor.
+          for (size_t step = tile; markers[step] != kJoined;) {
+            const unsigned char back = markers[step];
+
+            tiles[step] = ' ';
+            markers[step] = kJoined;
+            step = back == 1 ? step - width : back == 2 ? step + width : back == 3 ? step - 1 : step + 1;
+          }
+
+          join(neighbour);
+        } else if (!is_protected(static_cast<unsigned int>(neighbour % width),
+                                 static_cast<unsigned int>(neighbour / width))) {
+          markers[neighbour] = direction + 1;
+          queue.push_back(neighbour);
+        }
+      }
+    }
+  }
+
+  // Places Dots by chance on the open tiles outside of the base, then turns some of them into PowerPellets.
+  std::vector<size_t> dot_tiles;
+
+  for (unsigned int y = 0; y < height; y++) {
+    for (unsigned int x = 0; x < width; x++) {
+      const size_t tile = index(x, y);
+      const bool in_base = x >= kBaseX && x < kBaseX + kBaseWidth && y >= kBaseY && y < kBaseY + kBase.size();
+
+      if (tiles[tile] == ' ' && !in_base && random() % 100 < options.dot_percent_) {
+        tiles[tile] = '.';
+        dot_tiles.push_back(tile);
+      }
+    }
+  }
+
+  // A level ends once its Dots are eaten, so a level without any would end immediately.
+  if (dot_tiles.empty()) {
+    tiles[index(kAvatarX, kAvatarY)] = '.';
+    dot_tiles.push_back(index(kAvatarX, kAvatarY));
+  }
+
+  // At least one Dot is left, so the level does not end when the Avatar has only eaten PowerPellets.
+  const size_t power_pellet_count = std::min<size_t>(
+    std::max<size_t>(4, 4 * static_cast<size_t>(width) * height / kPowerPelletArea), dot_tiles.size() - 1);
+
+  for (size_t i = 0; i < power_pellet_count; i++) {
+    std::swap(dot_tiles[i], dot_tiles[i + random() % (dot_tiles.size() - i)]);
+    tiles[dot_tiles[i]] = 'o';
+  }
+
+  std::string structure;
+  structure.reserve(tiles.size() + height);
+
+  for (unsigned int y = 0; y < height; y++) {
+    if (y > 0) {
+      structure += '\n';
+    }
+
+    structure.append(tiles.begin() + index(0, y), tiles.begin() + index(0, y) + width);
+  }
+
+  return structure;
+}
\ No newline at end of file
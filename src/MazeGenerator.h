@@ -0,0 +1,72 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <string>
+
+/// <summary>
+/// The parameters of a generated maze.
+/// </summary>
+struct MazeOptions {
+  /// <summary>
+  /// The number of tiles along each row.
+  /// </summary>
+  unsigned int width_;
+  /// <summary>
+  /// The number of rows.
+  /// </summary>
+  unsigned int height_;
+  /// <summary>
+  /// The random seed. The same options always generate the same maze.
+  /// </summary>
+  unsigned int seed_;
+  /// <summary>
+  /// The chance, in percent, that each wall left between two corridors is removed. Zero generates a perfect
+  /// maze with a single route between any two tiles, and higher values add loops, down to an open grid at 100.
+  /// </summary>
+  unsigned int loop_percent_;
+  /// <summary>
+  /// The chance, in percent, that each tile the Avatar can reach holds a Dot. At least one Dot is always placed.
+  /// </summary>
+  unsigned int dot_percent_;
+};
+
+/// <summary>
+/// Generates maps in the format of the map's structure file, so maps of any size can be played and measured.
+///
+/// Corridors are carved along a lattice of every other tile by a randomised depth-first search, then walls
+/// between corridors are removed by chance to form loops. The Ghosts' base, the Avatar's starting corridor and
+/// the tunnel row are stamped where the game places the entities, and any corridors the stamps cut off are
+/// joined back to the rest, so every open tile can be reached from every other.
+/// </summary>
+class MazeGenerator {
+ public:
+  /// <summary>
+  /// The narrowest map that can be generated, which is the width of the map in the assets.
+  /// </summary>
+  static const unsigned int kMinWidth = 30;
+  /// <summary>
+  /// The shortest map that can be generated, which is the height of the map in the assets.
+  /// </summary>
+  static const unsigned int kMinHeight = 29;
+  /// <summary>
+  /// The chance in percent that a wall between corridors is removed, unless one is given.
+  /// </summary>
+  static const unsigned int kDefaultLoopPercent = 10;
+  /// <summary>
+  /// Generates a maze.
+  /// Throws std::invalid_argument if the size is outside kMinWidth by kMinHeight to kMaxMapDimension tiles,
+  /// or a percentage is above 100.
+  /// </summary>
+  /// <param name="options">The size, seed and density of the maze.</param>
+  /// <returns>The rows of the maze, separated by line feeds, in the format of the map's structure file.</returns>
+  static std::string Generate(const MazeOptions& options);
+
+ private:
+  /// <summary>
+  /// Prevents construction, as the generator only has static functions.
+  /// </summary>
+  MazeGenerator(void);
+};
\ No newline at end of file
@@ -6,12 +6,34 @@
 #include "GameEntity.h"
 
 #include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <cstdint>
 
 #include "PacMan.h"
 #include "Vector2.h"
+#include "World.h"
 
+namespace {
+	/// <summary>
+	/// The capacity reserved for image file paths, which is enough for the longest image path in the game.
+	/// </summary>
+	const size_t kImageFilePathCapacity = 48;
 
-MovableGameEntity::MovableGameEntity(Vector2<float> initial_position, float speed,
+	/// <summary>
+	/// Gets the sign of a value.
+	/// </summary>
+	/// <param name="value">The value.</param>
+	/// <returns>-1 if the value is negative, 1 if it is positive, else 0.</returns>
+	int Sign(int value) {
+		return (value > 0) - (value < 0);
+	}
+}
+
+const int MovableGameEntity::kSubpixelsPerPixel = 1000;
+const int MovableGameEntity::kContactUnitsPerPixel = 100;
+
+MovableGameEntity::MovableGameEntity(Vector2<float> initial_position, int speed,
 	const std::string& image_file_path)
 		: GameEntity(initial_position, image_file_path),
 	    initial_position_(initial_position),
@@ -20,68 +42,151 @@ MovableGameEntity::MovableGameEntity(Vector2<float> initial_position, float spee
 			 * The casts are to remove errors regarding const-ness and explicitly acknowledging possible loss
 			 * of data in conversion.
 			 */
-			current_tile_(Vector2<unsigned char>(static_cast<unsigned char>(initial_position.x_),
-				                                 static_cast<unsigned char>(initial_position.y_))),
+			current_tile_(Vector2<TileCoordinate>(static_cast<TileCoordinate>(initial_position.x_),
+				                                  static_cast<TileCoordinate>(initial_position.y_))),
 			next_tile_(current_tile_),
-      update_image_flag_(true) {}
+      update_image_flag_(true),
+			subpixel_position_(Vector2<int>::zero),
+			previous_subpixel_position_(Vector2<int>::zero) {
+	// Reserves the capacity up front, so changing the image during play never reallocates.
+	// Static entities never change their image, so they keep short paths without allocating.
+	image_file_path_.reserve(kImageFilePathCapacity);
+
+	set_subpixel_position(Vector2<int>(static_cast<int>(initial_position.x_ * PacMan::kTileSize * kSubpixelsPerPixel),
+	                                   static_cast<int>(initial_position.y_ * PacMan::kTileSize * kSubpixelsPerPixel)));
+	previous_subpixel_position_ = subpixel_position_;
+}
 
 bool MovableGameEntity::CheckIsAtDestination() const {
 	return (current_tile_.x_ == next_tile_.x_) && (current_tile_.y_ == next_tile_.y_);
 }
 
-Vector2<unsigned char> MovableGameEntity::current_tile() const {
+Vector2<TileCoordinate> MovableGameEntity::current_tile() const {
 	return current_tile_;
 }
 
-void MovableGameEntity::UpdatePosition(unsigned int elapsed_millis) {
+Vector2<int> MovableGameEntity::subpixel_position() const {
+	return subpixel_position_;
+}
+
+Vector2<int> MovableGameEntity::previous_subpixel_position() const {
+	return previous_subpixel_position_;
+}
+
+void MovableGameEntity::UpdatePosition(unsigned int elapsed_millis, const World* world) {
+	Move(static_cast<int>(elapsed_millis) * speed_, subpixel_position_, previous_subpixel_position_, current_tile_,
+		next_tile_, world);
+	set_subpixel_position(subpixel_position_);
+}
+
+void MovableGameEntity::Move(int distance_to_move, Vector2<int>& subpixel_position,
+	Vector2<int>& previous_subpixel_position, Vector2<TileCoordinate>& current_tile, Vector2<TileCoordinate>& next_tile,
+	const World* world) {
+	const int tile_subpixels = PacMan::kTileSize * kSubpixelsPerPixel;
 	// The location of the entity's destination tile.
-	Vector2<float> destination(next_tile_.x_, next_tile_.y_);
-	// Converts from the tile position to world position.
-	destination *= static_cast<float>(PacMan::kTileSize);
+	const Vector2<int> destination(next_tile.x_ * tile_subpixels, next_tile.y_ * tile_subpixels);
 
-	auto direction = destination - position_;
-	auto distanceToMove = elapsed_millis * speed_;
+	const int x_offset = destination.x_ - subpixel_position.x_;
+	const int y_offset = destination.y_ - subpixel_position.y_;
+
+	previous_subpixel_position = subpixel_position;
 
 	// True if the distance needed to travel will cause the entity to reach the next tile.
-	if (distanceToMove > direction.GetLength()) {
-		// Teleports the entity across the map from right to left.
-		if (current_tile_ == Vector2<unsigned char>(1, 13)) {
-			SetPositionFromTile(Vector2<unsigned char>(27, 13));
-			next_tile_ = GetTilePosition();
-		// Teleports the entity across the map from left to right.
-		} else if (current_tile_ == Vector2<unsigned char>(28, 13)) {
-			SetPositionFromTile(Vector2<unsigned char>(2, 13));
-			next_tile_ = GetTilePosition();
+	// Movement is along one axis, so the distance to the destination needs no square root.
+	if (distance_to_move > std::abs(x_offset) + std::abs(y_offset)) {
+		// The tile the step actually ends on, which is past a portal's exit if the next tile is its entrance.
+		const Vector2<TileCoordinate> arrival = world && current_tile != next_tile ?
+			world->GetStepDestination(current_tile, Vector2<char>(static_cast<char>(next_tile.x_ - current_tile.x_),
+				static_cast<char>(next_tile.y_ - current_tile.y_))) : next_tile;
+
+		// Teleports the entity through the portal.
+		if (arrival != next_tile) {
+			next_tile = arrival;
+			subpixel_position = Vector2<int>(next_tile.x_ * tile_subpixels, next_tile.y_ * tile_subpixels);
+			// The entity did not cross the map between the portals, so it is not swept across it.
+			previous_subpixel_position = subpixel_position;
 		// Moves the entity to its destination tile.
 		} else {
-			set_position(destination);
+			subpixel_position = destination;
 		}
 
-		current_tile_ = next_tile_;
+		current_tile = next_tile;
 	}
-	// Moves the entity closer to its destination.
+	// Moves the entity closer to its destination, along x and then along y.
 	else {
-		direction.Normalize();
-		position_ += (direction * distanceToMove);
+		const int x_distance = std::min(distance_to_move, std::abs(x_offset));
+		distance_to_move -= x_distance;
+
+		subpixel_position.x_ += Sign(x_offset) * x_distance;
+		subpixel_position.y_ += Sign(y_offset) * distance_to_move;
 	}
 }
 
+void MovableGameEntity::HoldPosition() {
+	previous_subpixel_position_ = subpixel_position_;
+}
+
+bool MovableGameEntity::CheckSweptContact(Vector2<int> from, Vector2<int> to, Vector2<int> other_from,
+	Vector2<int> other_to, int radius) {
+	/*
+	 * The offset between the entities moves in a straight line over the frame, from start to start + sweep.
+	 * Its least squared length is compared with the squared radius without dividing, so the test is exact
+	 * to a hundredth of a pixel. Working in hundredths keeps every product within 64 bits, as entities move
+	 * at most a tile in a frame.
+	 */
+	const int subpixels_per_unit = kSubpixelsPerPixel / kContactUnitsPerPixel;
+
+	const std::int64_t start_x = (other_from.x_ - from.x_) / subpixels_per_unit;
+	const std::int64_t start_y = (other_from.y_ - from.y_) / subpixels_per_unit;
+	const std::int64_t end_x = (other_to.x_ - to.x_) / subpixels_per_unit;
+	const std::int64_t end_y = (other_to.y_ - to.y_) / subpixels_per_unit;
+	const std::int64_t sweep_x = end_x - start_x;
+	const std::int64_t sweep_y = end_y - start_y;
+	const std::int64_t radius_squared = static_cast<std::int64_t>(radius) * radius * kContactUnitsPerPixel * kContactUnitsPerPixel;
+
+	const std::int64_t start_squared = start_x * start_x + start_y * start_y;
+	const std::int64_t sweep_squared = sweep_x * sweep_x + sweep_y * sweep_y;
+	const std::int64_t dot = start_x * sweep_x + start_y * sweep_y;
+
+	// The entities are closest at the start of the frame.
+	if (dot >= 0) {
+		return start_squared < radius_squared;
+	}
+
+	// The entities are closest at the end of the frame.
+	if (-dot >= sweep_squared) {
+		return end_x * end_x + end_y * end_y < radius_squared;
+	}
+
+	// The entities are closest during the frame, at a squared distance of start_squared - dot * dot / sweep_squared.
+	return start_squared * sweep_squared - dot * dot < radius_squared * sweep_squared;
+}
+
 void MovableGameEntity::Reset() {
 	  // Returns the entity back to its initial position.
-	  set_position(initial_position_ * static_cast<float>(PacMan::kTileSize));
+	  set_subpixel_position(Vector2<int>(static_cast<int>(initial_position_.x_ * PacMan::kTileSize * kSubpixelsPerPixel),
+	                                     static_cast<int>(initial_position_.y_ * PacMan::kTileSize * kSubpixelsPerPixel)));
+		previous_subpixel_position_ = subpixel_position_;
 
 		// Sets the current and next tile members to the currently occupied tile. 
 		current_tile_ = GetTilePosition();
 		next_tile_ = current_tile_;
 }
 
-void MovableGameEntity::SetPositionFromTile(Vector2<unsigned char> position) {
-	set_position(position * static_cast<float>(PacMan::kTileSize));
+void MovableGameEntity::SetPositionFromTile(Vector2<TileCoordinate> position) {
+	set_subpixel_position(Vector2<int>(position.x_ * PacMan::kTileSize * kSubpixelsPerPixel,
+	                                   position.y_ * PacMan::kTileSize * kSubpixelsPerPixel));
+}
+
+Vector2<TileCoordinate> MovableGameEntity::GetTilePosition() const {
+	const int tile_subpixels = PacMan::kTileSize * kSubpixelsPerPixel;
+
+	return Vector2<TileCoordinate>(static_cast<TileCoordinate>(subpixel_position_.x_ / tile_subpixels),
+	                               static_cast<TileCoordinate>(subpixel_position_.y_ / tile_subpixels));
 }
 
-Vector2<unsigned char> MovableGameEntity::GetTilePosition() const {
-	// Converts the current position to the corresponding tile values, as floats.
-	Vector2<float> casted_vector(position_.x_ / static_cast<float>(PacMan::kTileSize), position_.y_ / static_cast<float>(PacMan::kTileSize));
-	// Casts the floats to unsigned chars.
-	return Vector2<unsigned char>(static_cast<unsigned char>(casted_vector.x_), static_cast<unsigned char>(casted_vector.y_));
+void MovableGameEntity::set_subpixel_position(Vector2<int> subpixel_position) {
+	subpixel_position_ = subpixel_position;
+	set_position(Vector2<float>(static_cast<float>(subpixel_position.x_) / kSubpixelsPerPixel,
+	                            static_cast<float>(subpixel_position.y_) / kSubpixelsPerPixel));
 }
\ No newline at end of file
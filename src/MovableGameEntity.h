@@ -8,6 +8,7 @@
 
 #include "GameEntity.h"
 #include "Vector2.h"
+#include "TileCoordinate.h"
 
 class World;
 
@@ -21,8 +22,13 @@ class MovableGameEntity : public GameEntity {
 	/// </summary>
 	/// <param name="initial_position">The starting tile position of the entity.</param>
 	/// <param name="image_file_path">The path of the entity's image to add to the drawing buffer.</param>
-	/// <param name="speed">The speed of the entity.</param>
-	MovableGameEntity(Vector2<float> initial_position, float speed, const std::string& image_file_path = "");
+	/// <param name="speed">The speed of the entity in sub-pixels per millisecond.</param>
+	MovableGameEntity(Vector2<float> initial_position, int speed, const std::string& image_file_path = "");
+	/// <summary>
+	/// The number of sub-pixels in a pixel. Movement is integrated in whole sub-pixels, so it is exact
+	/// and identical on every compiler and platform.
+	/// </summary>
+	static const int kSubpixelsPerPixel;
 	/// <summary>
 	/// Resets the position of the entity.
 	/// </summary>
@@ -31,23 +37,60 @@ class MovableGameEntity : public GameEntity {
 	/// Gets the current position in tile coordinates.
 	/// </summary>
 	/// <returns>The current position in tile coordinates.</returns>
-	Vector2<unsigned char>GetTilePosition(void) const;
+	Vector2<TileCoordinate>GetTilePosition(void) const;
 	/// <summary>
 	/// Sets the position of the entity to the location represented by the tile.
 	/// </summary>
 	/// <param name="tile">The coordinates representing the position that the
 	/// entity will be set to.</param>
-	void SetPositionFromTile(Vector2<unsigned char> tile);
+	void SetPositionFromTile(Vector2<TileCoordinate> tile);
 	/// <summary>
 	/// Gets the current_tile_ member.
 	/// </summary>
 	/// <returns>The current_tile_ member.</returns>
-	Vector2<unsigned char> current_tile(void) const;
+	Vector2<TileCoordinate> current_tile(void) const;
 	/// <summary>
 	/// Gets whether the current tie is equal to the next tile.
 	/// </summary>
 	/// <returns>True if the current tile is equal to the next tile, else false.</returns>
 	bool CheckIsAtDestination(void) const;
+	/// <summary>
+	/// Gets the position in sub-pixels, which position() is derived from.
+	/// </summary>
+	/// <returns>The position in sub-pixels.</returns>
+	Vector2<int> subpixel_position(void) const;
+	/// <summary>
+	/// Gets the position in sub-pixels at the start of the last frame, which the entity moved from.
+	/// </summary>
+	/// <returns>The previous position in sub-pixels.</returns>
+	Vector2<int> previous_subpixel_position(void) const;
+	/// <summary>
+	/// Determines whether two entities came within a distance of each other at any point of the last frame.
+	/// Both entities are taken to have moved in a straight line from their previous to their current positions,
+	/// so entities that pass through each other in a long frame are still found to be in contact.
+	/// Positions are compared to a hundredth of a pixel.
+	/// </summary>
+	/// <param name="from">The previous position of the first entity in sub-pixels.</param>
+	/// <param name="to">The current position of the first entity in sub-pixels.</param>
+	/// <param name="other_from">The previous position of the second entity in sub-pixels.</param>
+	/// <param name="other_to">The current position of the second entity in sub-pixels.</param>
+	/// <param name="radius">The distance in pixels that entities must come closer than.</param>
+	/// <returns>True if the entities came closer than the radius, else false.</returns>
+	static bool CheckSweptContact(Vector2<int> from, Vector2<int> to, Vector2<int> other_from, Vector2<int> other_to,
+		int radius);
+	/// <summary>
+	/// Moves a position towards the centre of the next tile, arriving if the distance reaches it.
+	/// Entities arriving at a portal's entrance are moved past its exit, as World::GetStepDestination finds.
+	/// Shared by every moving entity, including those held in arrays rather than as objects.
+	/// </summary>
+	/// <param name="distance_to_move">The distance to move in sub-pixels.</param>
+	/// <param name="subpixel_position">The position in sub-pixels, which is moved.</param>
+	/// <param name="previous_subpixel_position">Set to the position that the move started from.</param>
+	/// <param name="current_tile">The tile being occupied, which becomes the next tile on arrival.</param>
+	/// <param name="next_tile">The tile being moved towards, which is moved past a portal on arrival.</param>
+	/// <param name="world">The World whose portals are passed through, or null if there are none.</param>
+	static void Move(int distance_to_move, Vector2<int>& subpixel_position, Vector2<int>& previous_subpixel_position,
+		Vector2<TileCoordinate>& current_tile, Vector2<TileCoordinate>& next_tile, const World* world);
 
 protected:
 	/// <summary>
@@ -56,7 +99,12 @@ protected:
 	/// </summary>
 	/// <param name="elapsed_millis">The amount of time in milliseconds since the previous
 	/// frame update.</param>
-	void UpdatePosition(unsigned int elapsed_millis);
+	/// <param name="world">The World whose portals are passed through.</param>
+	void UpdatePosition(unsigned int elapsed_millis, const World* world);
+	/// <summary>
+	/// Records that the entity did not move in this frame, in place of UpdatePosition.
+	/// </summary>
+	void HoldPosition(void);
 	/// <summary>
 	/// 
 	/// </summary>
@@ -66,17 +114,17 @@ protected:
 	/// </summary>
 	const Vector2<float> initial_position_;
 	/// <summary>
-	///  The movement speed of the entity
+	///  The movement speed of the entity in sub-pixels per millisecond.
 	/// </summary>
-	float speed_;
+	int speed_;
 	/// <summary>
 	///  The tile that the entity is occupying.
 	/// </summary>
-	Vector2<unsigned char> current_tile_;
+	Vector2<TileCoordinate> current_tile_;
 	/// <summary>
 	/// The tile that the entity is moving towards.
 	/// </summary>
-	Vector2<unsigned char> next_tile_;
+	Vector2<TileCoordinate> next_tile_;
 	/// <summary>
 	/// The direction the entity is moving in.
 	/// </summary>
@@ -86,4 +134,24 @@ protected:
 	/// True if the image needs updating, else false.
 	/// </summary>
 	bool update_image_flag_;
+
+ private:
+	/// <summary>
+	/// Sets the position in sub-pixels, and the drawn position from it.
+	/// </summary>
+	/// <param name="subpixel_position">The position in sub-pixels.</param>
+	void set_subpixel_position(Vector2<int> subpixel_position);
+	/// <summary>
+	/// The position in sub-pixels. Entities move along one axis at a time between tile centres,
+	/// so each update is an integer add and compare.
+	/// </summary>
+	Vector2<int> subpixel_position_;
+	/// <summary>
+	/// The position in sub-pixels at the start of the last frame, which the entity moved from.
+	/// </summary>
+	Vector2<int> previous_subpixel_position_;
+	/// <summary>
+	/// The units per pixel that contact is tested in, which divide kSubpixelsPerPixel.
+	/// </summary>
+	static const int kContactUnitsPerPixel;
 };
\ No newline at end of file
@@ -0,0 +1,66 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "OffscreenFramebuffer.h"
+
+#include <cstdint>
+#include <ios>
+#include <string>
+
+#include "SDL.h"
+
+OffscreenFramebuffer::OffscreenFramebuffer(int width, int height)
+    : surface_(SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888)),
+      renderer_(nullptr) {
+  if (!surface_) {
+    throw std::ios_base::failure(std::string("Failed to create framebuffer: ") + SDL_GetError());
+  }
+
+  renderer_ = SDL_CreateSoftwareRenderer(surface_);
+
+  if (!renderer_) {
+    SDL_FreeSurface(surface_);
+    throw std::ios_base::failure(std::string("Failed to create software renderer: ") + SDL_GetError());
+  }
+}
+
+OffscreenFramebuffer::~OffscreenFramebuffer() {
+  SDL_DestroyRenderer(renderer_);
+  SDL_FreeSurface(surface_);
+}
+
+SDL_Renderer* OffscreenFramebuffer::renderer() const {
+  return renderer_;
+}
+
+const unsigned char* OffscreenFramebuffer::pixels() const {
+  return static_cast<const unsigned char*>(surface_->pixels);
+}
+
+int OffscreenFramebuffer::pitch() const {
+  return surface_->pitch;
+}
+
+int OffscreenFramebuffer::width() const {
+  return surface_->w;
+}
+
+int OffscreenFramebuffer::height() const {
+  return surface_->h;
+}
+
+std::uint64_t OffscreenFramebuffer::Hash() const {
+  std::uint64_t hash = 14695981039346656037ull;
+
+  // Row padding is excluded, as only the visible pixels form the frame.
+  for (int y = 0; y < surface_->h; y++) {
+    const unsigned char* row = pixels() + y * surface_->pitch;
+
+    for (int i = 0; i < surface_->w * 4; i++) {
+      hash = (hash ^ row[i]) * 1099511628211ull;
+    }
+  }
+
+  return hash;
+}
\ No newline at end of file
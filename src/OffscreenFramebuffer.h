@@ -0,0 +1,79 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <cstdint>
+
+struct SDL_Renderer;
+struct SDL_Surface;
+
+/// <summary>
+/// An in-memory 32-bit framebuffer with a software renderer attached, used in place of a window
+/// for headless rendering and frame capture.
+/// Rendering is performed on the CPU by SDL's software blitters. The framebuffer uses the ARGB8888
+/// format that SDL's SIMD alpha blending loops are specialised for, and the blits are integer-only,
+/// so identical game states produce bit-exact frames.
+/// </summary>
+class OffscreenFramebuffer {
+ public:
+  /// <summary>
+  /// Constructor for the OffscreenFramebuffer class.
+  /// Throws if the framebuffer or renderer cannot be created.
+  /// </summary>
+  /// <param name="width">The width of the framebuffer in pixels.</param>
+  /// <param name="height">The height of the framebuffer in pixels.</param>
+  OffscreenFramebuffer(int width, int height);
+  /// <summary>
+  /// Destructor for the OffscreenFramebuffer class.
+  /// Safely releases SDL resources.
+  /// </summary>
+  ~OffscreenFramebuffer(void);
+  /// <summary>
+  /// Gets the renderer that draws into the framebuffer.
+  /// </summary>
+  /// <returns>The software renderer.</returns>
+  SDL_Renderer* renderer(void) const;
+  /// <summary>
+  /// Gets the framebuffer pixels. Each pixel is a native-endian 32-bit ARGB8888 value.
+  /// </summary>
+  /// <returns>The first byte of the top row of pixels.</returns>
+  const unsigned char* pixels(void) const;
+  /// <summary>
+  /// Gets the number of bytes between the starts of consecutive rows.
+  /// </summary>
+  /// <returns>The row pitch in bytes.</returns>
+  int pitch(void) const;
+  /// <summary>
+  /// Gets the width of the framebuffer.
+  /// </summary>
+  /// <returns>The width in pixels.</returns>
+  int width(void) const;
+  /// <summary>
+  /// Gets the height of the framebuffer.
+  /// </summary>
+  /// <returns>The height in pixels.</returns>
+  int height(void) const;
+  /// <summary>
+  /// Generates a 64-bit FNV-1a hash of the visible pixels.
+  /// Used to confirm that two runs produced identical frames.
+  /// </summary>
+  /// <returns>The hash of the current frame.</returns>
+  std::uint64_t Hash(void) const;
+
+ private:
+  /// <summary>
+  /// Copy constructor for the OffscreenFramebuffer class.
+  /// </summary>
+  /// <param name="reference">The OffscreenFramebuffer reference to copy.</param>
+  OffscreenFramebuffer(OffscreenFramebuffer const& reference);
+  /// <summary>
+  /// The surface that holds the pixels.
+  /// </summary>
+  SDL_Surface* surface_;
+  /// <summary>
+  /// The software renderer that draws into the surface.
+  /// </summary>
+  SDL_Renderer* renderer_;
+};
\ No newline at end of file
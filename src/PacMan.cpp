@@ -5,8 +5,9 @@
 #include "PacMan.h"
 
 #include <array>
+#include <algorithm>
 #include <vector>
-#include <sstream>
+#include <cstdio>
 #include <iostream>
 
 #include "SDL.h"
@@ -14,18 +15,26 @@
 #include "MovableGameEntity.h"
 #include "GameEntity.h"
 #include "World.h"
-#include "RedGhost.h"
-#include "CyanGhost.h"
-#include "OrangeGhost.h"
-#include "PinkGhost.h"
-#include "Ghost.h"
+#include "Ghosts.h"
 #include "Vector2.h"
 #include "Drawer.h"
+#include "ResourceManager.h"
+#include "Profiler.h"
 #include "Avatar.h"
 
 // The length of a square tile in pixels.
 const int PacMan::kTileSize = 22;
 
+namespace {
+  /// <summary>
+  /// The Avatar makes contact with a Ghost when they come closer than this many pixels.
+  /// </summary>
+  const int kGhostContactRadius = 10;
+}
+
+// Held as a string, so drawing the lives does not construct one every frame.
+const std::string PacMan::kLivesImageFilePath = "Avatar\\Open-Left.png";
+
 // Prevents regular object construction.
 PacMan::PacMan()
     : 
@@ -34,49 +43,52 @@ PacMan::PacMan()
   score_(0),
   frames_per_second_(0),
   fps_counter_(0),
+  profiler_key_held_(false),
+  report_key_held_(false),
   lives_(0),
   world_(nullptr),
   avatar_(nullptr),
-  ghosts_({}) {
+  ghost_count_(0) {
   return;
 }
 
-PacMan::PacMan(Drawer* drawer)
+PacMan::PacMan(Drawer* drawer, unsigned int ghost_count, const std::string& map_structure)
   : drawer_(drawer),
     game_over_(false),
 	  score_(0),
 	  frames_per_second_(0),
     fps_counter_(0),
+    profiler_key_held_(false),
+    report_key_held_(false),
 	  lives_(3),
 	  world_(new World()),
-    avatar_(new Avatar(Vector2<float>(14.5f, 22.f))),
-    ghosts_({
-      new RedGhost(Vector2<float>(14.5f, 10.f)),
-      new CyanGhost(Vector2<float>(13.f, 13.f)),
-      new PinkGhost(Vector2<float>(14.5f, 13.f)),
-      new OrangeGhost(Vector2<float>(16.f, 13.f))
-    }) {
-  try {
-    world_->Init();
-  }
-  catch (const std::exception& e) {
-    std::cerr << "Exception: " << e.what() << std::endl;
-    exit(EXIT_FAILURE);
-  }
+    avatar_(nullptr),
+    ghost_count_(ghost_count) {
+  world_->set_map_structure(map_structure);
+  LoadLevel();
+}
+
+PacMan::~PacMan() {
+  // Destroys the level's objects before the World that refers to them, once no paths are being planned in them.
+  ghosts_.FinishPaths();
+  level_arena_.Release();
+  delete world_;
 }
 
-PacMan& PacMan::Instance(Drawer* drawer) {
-  static PacMan instance(drawer);
+PacMan& PacMan::Instance(Drawer* drawer, unsigned int ghost_count, const std::string& map_structure) {
+  static PacMan instance(drawer, ghost_count, map_structure);
 
   return instance;
 }
 
-bool PacMan::Update(unsigned int elapsed_millis) {
+bool PacMan::Update(unsigned int elapsed_millis, const Uint8* keystate) {
+  ScopedTimer timer(ProfileZone::pacman_update);
+
   /*
    * Reads keyboard input.
    * Includes the escape key to exit and arrow keys for directions.
    */ 
-  if (!UpdateInput()) {
+  if (!UpdateInput(keystate)) {
     return false;
   }
 
@@ -103,7 +115,7 @@ bool PacMan::Update(unsigned int elapsed_millis) {
 
   // Update MovableGameEntities.
   avatar_->Update(elapsed_millis, world_);
-  Ghost::Update(elapsed_millis, world_, ghosts_);
+  ghosts_.Update(elapsed_millis, world_);
 
   // Check for Avatar intersection with Dots.
   if (world_->CheckDotIntersection(avatar_->position())) {
@@ -115,53 +127,63 @@ bool PacMan::Update(unsigned int elapsed_millis) {
     score_ += 50;
     avatar_->ResetGhostsCaughtInRow();
 
-    Ghost::HandleVulnerableEvent(ghosts_);
+    ghosts_.HandleVulnerableEvent();
   }
 
-  std::vector<Ghost*> claimed_ghosts {};
-  claimed_ghosts.reserve(4);
+  // Reserved for every Ghost when the level is loaded, so claiming Ghosts does not allocate.
+  claimed_ghosts_.clear();
 
-  bool apply_claimed_effects = false;
+  bool healthy_contact = false;
 
-  for (auto& g : ghosts_) {
-    // True if the Avatar has made contact with the Ghost.
-    if ((g->position() - avatar_->position()).GetLength() < 10) {
-      // True if the Ghost is alive and not vulnerable.
-      if (g->state() == Ghost::state::healthy) {
-        // Immediately returns if the player does not have any more lives.
-        if (--lives_ < 1) {
-          return true;
-        }
+  // Files the Ghosts under their tiles, so only those near the Avatar are tested for contact.
+  collision_broadphase_.Clear();
 
-        // Resets the game elements for the next life.
-        Reset();
-        return true;
-      }
+  for (unsigned int i = 0; i < ghosts_.count(); i++) {
+    collision_broadphase_.Insert(i, ghosts_.current_tile(i));
+  }
 
-      // If colliding with a vulnerable Ghost, add it to a buffer.
-      if (g->state() == Ghost::state::vulnerable) {
-        claimed_ghosts.push_back(g);
-        apply_claimed_effects = true;
-      }
+  collision_broadphase_.ForEachNear(avatar_->current_tile(), [&](unsigned int index) {
+    // True if the Avatar made contact with the Ghost at any point during the frame.
+    if (!MovableGameEntity::CheckSweptContact(avatar_->previous_subpixel_position(), avatar_->subpixel_position(),
+        ghosts_.previous_subpixel_position(index), ghosts_.subpixel_position(index), kGhostContactRadius)) {
+      return;
+    }
+
+    // True if the Ghost is alive and not vulnerable.
+    if (ghosts_.state(index) == Ghosts::state::healthy) {
+      healthy_contact = true;
     }
-  }
 
+    // If colliding with a vulnerable Ghost, add it to a buffer.
+    if (ghosts_.state(index) == Ghosts::state::vulnerable) {
+      claimed_ghosts_.push_back(index);
+    }
+  });
 
-  if (apply_claimed_effects) {
-    // Kills all claimed Ghosts.
-    for (auto& g : claimed_ghosts) {
-      // The score increases by 200, 400, 800, 1600.
-      score_ += static_cast<unsigned short>(200 * 1 << avatar_->IncrementGhostsCaughtInRow());
-      g->Die(world_);
+  if (healthy_contact) {
+    // Immediately returns if the player does not have any more lives.
+    if (--lives_ < 1) {
+      return true;
     }
+
+    // Resets the game elements for the next life.
+    Reset();
+    return true;
+  }
+
+  // Kills all claimed Ghosts.
+  for (unsigned int index : claimed_ghosts_) {
+    // The score increases by 200, 400, 800, then 1600 for every further Ghost.
+    const unsigned char ghosts_caught = std::min<unsigned char>(avatar_->IncrementGhostsCaughtInRow(), 3);
+
+    score_ += static_cast<unsigned short>(200 * 1 << ghosts_caught);
+    ghosts_.Die(index, world_);
   }
  	
   return true;
 }
 
-bool PacMan::UpdateInput() {
-  const Uint8 *keystate = SDL_GetKeyboardState(NULL);
-  
+bool PacMan::UpdateInput(const Uint8* keystate) {
   // Updates the movement direction based on keyboard key input.
   if (keystate[SDL_SCANCODE_UP]) {
 	  avatar_->set_direction(Vector2<char>::up, world_);
@@ -173,6 +195,26 @@ bool PacMan::UpdateInput() {
     avatar_->set_direction(Vector2<char>::left, world_);
   }
 
+  // F3 toggles the profiler overlay once per press.
+  if (keystate[SDL_SCANCODE_F3] && !profiler_key_held_) {
+    Profiler::Instance().ToggleOverlay();
+  }
+
+  profiler_key_held_ = keystate[SDL_SCANCODE_F3] != 0;
+
+  // F4 writes the frame time percentiles so far. A failure is reported without ending the game.
+  if (keystate[SDL_SCANCODE_F4] && !report_key_held_) {
+    try {
+      Profiler::Instance().WriteReport();
+      std::cout << "Wrote frame time report to " << Profiler::Instance().report_file_path() << std::endl;
+    }
+    catch (const std::exception& e) {
+      std::cerr << "Exception: " << e.what() << std::endl;
+    }
+  }
+
+  report_key_held_ = keystate[SDL_SCANCODE_F4] != 0;
+
   // Escape Key is used for exiting the application.
   return !keystate[SDL_SCANCODE_ESCAPE];
 }
@@ -183,46 +225,46 @@ bool PacMan::CheckEndGameCondition() const {
 }
 
 void PacMan::Draw(unsigned int elapsed_millis) {
+  ScopedTimer timer(ProfileZone::pacman_draw);
+
   world_->Draw(drawer_, elapsed_millis);
   avatar_->Draw(drawer_);
 
-  for (Ghost* g : ghosts_) {
-    g->Draw(drawer_);
-  }
+  ghosts_.Draw(drawer_);
 
   DrawUI();
+
+  // Reports the previous frame's draw calls and texture switches, the texture memory in use and the path
+  // cache's use to the profiler overlay.
+  Profiler& profiler = Profiler::Instance();
+  const Drawer::FrameStats frame_stats = drawer_->frame_stats();
+  const PathCache::Metrics path_cache_metrics = world_->path_cache_metrics();
+
+  profiler.SetCounter(ProfileCounter::draw_calls, frame_stats.draw_calls_);
+  profiler.SetCounter(ProfileCounter::texture_switches, frame_stats.texture_switches_);
+  profiler.SetCounter(ProfileCounter::texture_kib, ResourceManager::Instance().metrics().texture_bytes_ / 1024);
+  profiler.SetCounter(ProfileCounter::path_cache_hits, path_cache_metrics.hit_count_);
+  profiler.SetCounter(ProfileCounter::path_cache_misses, path_cache_metrics.miss_count_);
+  profiler.DrawOverlay(drawer_);
 }
 
 void PacMan::DrawUI() const
 {
-  // Drawing lives info.
-  std::string livesString;
-  std::stringstream liveStream;
-
-  liveStream << lives_;
-  livesString = liveStream.str();
+  // Text is formatted into a fixed buffer, so drawing the UI does not allocate.
+  char text[32];
 
+  // Drawing lives info.
   for (unsigned char i = 0; i < lives_; i++) {
-    drawer_->Draw("Avatar/Open-Left.png", Vector2<float>(20.f + 40.f * i, 50.f));
+    drawer_->Draw(kLivesImageFilePath, Vector2<float>(20.f + 40.f * i, 50.f), DrawLayer::ui);
   }
 
   // Drawing score text.
-  std::string score_string;
-  std::stringstream score_stream;
-
-  score_stream << score_;
-  score_string = score_stream.str();
-  
-  drawer_->DrawText(score_string.c_str(), Vector2<float>(20.f, 100.f));  
+  std::snprintf(text, sizeof(text), "%u", static_cast<unsigned int>(score_));
+  drawer_->DrawText(text, Vector2<float>(20.f, 100.f));
 
   // Display FPS text.
-  std::string fps_string;
-  std::stringstream fps_stream;
-
-  fps_stream << frames_per_second_;
-  fps_string = fps_stream.str();
-
-  drawer_->DrawText(fps_string.insert(0, "FPS: ").c_str(), Vector2<float>(852.f, 50.f));
+  std::snprintf(text, sizeof(text), "FPS: %u", static_cast<unsigned int>(frames_per_second_));
+  drawer_->DrawText(text, Vector2<float>(852.f, 50.f));
 
   // Display end game text.
   if (game_over_) {
@@ -234,7 +276,85 @@ void PacMan::DrawUI() const
   }
 }
 
+unsigned short PacMan::score() const {
+  return score_;
+}
+
+bool PacMan::game_over() const {
+  return game_over_;
+}
+
+PathCache::Metrics PacMan::path_cache_metrics() const {
+  return world_->path_cache_metrics();
+}
+
+std::uint64_t PacMan::StateHash() const {
+  // FNV-1a over the bytes of each value. Positions are hashed in sub-pixels, so any drift is detected.
+  std::uint64_t hash = 14695981039346656037ull;
+
+  auto add = [&hash](const void* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ static_cast<const unsigned char*>(data)[i]) * 1099511628211ull;
+    }
+  };
+
+  auto add_entity = [&add](const MovableGameEntity* entity) {
+    const Vector2<int> position = entity->subpixel_position();
+    const Vector2<TileCoordinate> tile = entity->current_tile();
+
+    add(&position.x_, sizeof(position.x_));
+    add(&position.y_, sizeof(position.y_));
+    add(&tile.x_, sizeof(tile.x_));
+    add(&tile.y_, sizeof(tile.y_));
+  };
+
+  const unsigned int item_count = world_->GetRemainingItemCount();
+
+  add(&score_, sizeof(score_));
+  add(&lives_, sizeof(lives_));
+  add(&game_over_, sizeof(game_over_));
+  add(&item_count, sizeof(item_count));
+  add_entity(avatar_);
+
+  for (unsigned int i = 0; i < ghosts_.count(); i++) {
+    const Vector2<int> position = ghosts_.subpixel_position(i);
+    const Vector2<TileCoordinate> tile = ghosts_.current_tile(i);
+    const unsigned char state = static_cast<unsigned char>(ghosts_.state(i));
+
+    add(&position.x_, sizeof(position.x_));
+    add(&position.y_, sizeof(position.y_));
+    add(&tile.x_, sizeof(tile.x_));
+    add(&tile.y_, sizeof(tile.y_));
+    add(&state, sizeof(state));
+  }
+
+  return hash;
+}
+
+void PacMan::LoadLevel() {
+  // Destroys every object of the previous level at once, and places the new level in the same memory.
+  // Paths still being planned are written into that memory, so they are finished first.
+  ghosts_.FinishPaths();
+  level_arena_.Release();
+
+  try {
+    world_->Init(level_arena_);
+  }
+  catch (const std::exception& e) {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  avatar_ = level_arena_.Create<Avatar>(Vector2<float>(14.5f, 22.f));
+
+  // Also restores the Ghosts' shared timers, which earlier levels may have left running.
+  ghosts_.Init(level_arena_, ghost_count_, world_->GetMaxPathLength());
+  claimed_ghosts_.reserve(ghost_count_);
+
+  collision_broadphase_.Reserve(level_arena_, ghost_count_);
+}
+
 void PacMan::Reset() {
   avatar_->Reset();
-  Ghost::Reset(world_, ghosts_);
+  ghosts_.Reset();
 }
\ No newline at end of file
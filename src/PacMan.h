@@ -6,12 +6,20 @@
 
 #include <string>
 #include <array>
+#include <vector>
+#include <cstdint>
+
+#include "SDL_stdinc.h"
+
+#include "LevelArena.h"
+#include "CollisionBroadphase.h"
+#include "Ghosts.h"
+#include "PathCache.h"
 
 struct SDL_Surface;
 class Drawer;
 class Avatar;
 class World;
-class Ghost;
 
 /// <summary>
 /// The game manager class.
@@ -22,16 +30,37 @@ class PacMan {
 	/// Creates an instance of this class. Wrapper for the constructor.
 	/// </summary>
 	/// <param name="drawer">Handles the drawing of game entity images and UI.</param>
+	/// <param name="ghost_count">The number of Ghosts, used when the instance is first created.</param>
+	/// <param name="map_structure">The map played, such as a generated maze, used when the instance is first
+	/// created. Empty to play the map in the assets.</param>
 	/// <returns>A pointer to an instance of this class.</returns>
-	static PacMan& Instance(Drawer* drawer);
+	static PacMan& Instance(Drawer* drawer, unsigned int ghost_count = Ghosts::kDefaultCount,
+		const std::string& map_structure = std::string());
+	/// <summary>
+	/// Constructor for the PacMan class. Starts a new game, independent of the instance.
+	/// Used by tools that play many games in one process, such as the benchmarks.
+	/// </summary>
+	/// <param name="drawer">Handles the addition of game entity images to the drawing buffer.
+	/// May be null if the game is never drawn.</param>
+	/// <param name="ghost_count">The number of Ghosts.</param>
+	/// <param name="map_structure">The map played, in the format of the map's structure file.
+	/// Empty to play the map in the assets.</param>
+	PacMan(Drawer* drawer, unsigned int ghost_count = Ghosts::kDefaultCount,
+		const std::string& map_structure = std::string());
+	/// <summary>
+	/// Destructor for the PacMan class.
+	/// Releases the level and the World.
+	/// </summary>
+	~PacMan(void);
   /// <summary>
   /// Updates game entities.
   /// </summary>
 	/// <param name="elapsed_millis">The amount of time in milliseconds since the previous
 	/// frame update.</param>
+	/// <param name="keystate">The state of every key, indexed by SDL scancode, as returned by SDL_GetKeyboardState.</param>
   /// <returns>True is the frame has finished in normal conditions, false if the player
 	/// has manually exited the game.</returns>
-  bool Update(unsigned int elapsed_millis);
+  bool Update(unsigned int elapsed_millis, const Uint8* keystate);
   /// <summary>
   /// Adds images representing game entities to the drawing buffer.
   /// </summary>
@@ -43,26 +72,58 @@ class PacMan {
 	/// </summary>
 	void Reset(void);
 	/// <summary>
+	/// Loads the level from its initial state, creating the map, items, Avatar and Ghosts in the level arena.
+	/// Releases the objects of the previous level first, so reloading reuses their memory without allocating.
+	/// </summary>
+	void LoadLevel(void);
+	/// <summary>
 	/// The length of a square tile in pixels.
 	/// </summary>
 	static const int kTileSize;
+	/// <summary>
+	/// The image drawn for each of the player's remaining lives.
+	/// </summary>
+	static const std::string kLivesImageFilePath;
+	/// <summary>
+	/// Gets the player's score.
+	/// </summary>
+	/// <returns>The player's score.</returns>
+	unsigned short score(void) const;
+	/// <summary>
+	/// Gets whether the game has ended, by clearing the level or losing every life.
+	/// </summary>
+	/// <returns>True if the game has ended, else false.</returns>
+	bool game_over(void) const;
+	/// <summary>
+	/// Gets the counts of how the World's paths have been found in its path cache since the level was loaded.
+	/// </summary>
+	/// <returns>The hit, miss and eviction counts of the path cache.</returns>
+	PathCache::Metrics path_cache_metrics(void) const;
+	/// <summary>
+	/// Hashes the state that updates change: the score, lives, remaining items, and the positions and
+	/// states of the Avatar and Ghosts. Equal between two games that received the same seed and input.
+	/// </summary>
+	/// <returns>The hash of the game state.</returns>
+	std::uint64_t StateHash(void) const;
 
  private:
 	/// <summary>
 	/// Constructor for the PacMan class.
 	/// </summary>
-	/// <param name="drawer">Handles the addition of game entity images to the drawing buffer.</param>
-	PacMan(Drawer* drawer);
+	PacMan(void);
 	/// <summary>
-	/// Constructor for the PacMan class.
+	/// Copy constructor for the PacMan class.
 	/// </summary>
-	PacMan(void);
+	/// <param name="reference">The PacMan reference to copy.</param>
+	PacMan(PacMan const& reference);
   /// <summary>
   /// Handles keyboard inputs for Avatar movement and escaping the application.
-	/// Includes arrow keys for 4-directional movement and escape to exit the game.
+	/// Includes arrow keys for 4-directional movement, F3 to toggle the profiler overlay,
+	/// F4 to write the frame time report and escape to exit the game.
   /// </summary>
+  /// <param name="keystate">The state of every key, indexed by SDL scancode.</param>
   /// <returns>True if a movement key is pressed and false if the escape key is pressed.</returns>
-  bool UpdateInput(void);
+  bool UpdateInput(const Uint8* keystate);
   /// <summary>
   /// Cehcks whether the game's end conditions have been met, returning the result. 
   /// </summary>
@@ -81,6 +142,14 @@ class PacMan {
 	/// </summary>
 	int fps_counter_;
 	/// <summary>
+	/// True while the key that toggles the profiler overlay is held, so each press toggles it once.
+	/// </summary>
+	bool profiler_key_held_;
+	/// <summary>
+	/// True while the key that writes the frame time report is held, so each press writes it once.
+	/// </summary>
+	bool report_key_held_;
+	/// <summary>
 	/// Determines whether the game has ended.
 	/// True if the game has ended, else false.
 	/// </summary>
@@ -102,13 +171,29 @@ class PacMan {
 	/// </summary>
 	unsigned short frames_per_second_;
 	/// <summary>
-	/// Holds the Avatar instance.
+	/// Holds the objects of the current level: its tiles, items, Avatar and Ghosts.
+	/// </summary>
+	LevelArena level_arena_;
+	/// <summary>
+	/// Finds the Ghosts near the Avatar, from the tiles that they occupy. Reserved in the level arena.
+	/// </summary>
+	CollisionBroadphase collision_broadphase_;
+	/// <summary>
+	/// Holds the Avatar instance. Owned by the level arena.
 	/// </summary>
 	Avatar* avatar_;
 	/// <summary>
-	/// Holds Ghost instances.
+	/// Holds every Ghost. Their data is owned by the level arena.
+	/// </summary>
+	Ghosts ghosts_;
+	/// <summary>
+	/// The number of Ghosts created for each level.
+	/// </summary>
+	unsigned int ghost_count_;
+	/// <summary>
+	/// The indices of the vulnerable Ghosts that the Avatar contacted in the current frame.
 	/// </summary>
-	std::array<Ghost*, 4> ghosts_;
+	std::vector<unsigned int> claimed_ghosts_;
 	/// <summary>
 	/// The World - responsible for map/path generation and determining whether tiles are
 	/// blockages for entities.
@@ -0,0 +1,189 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "PathCache.h"
+
+#include <algorithm>
+
+#include "LevelArena.h"
+#include "TilePath.h"
+
+namespace {
+  /// <summary>
+  /// The number of steps packed into each byte.
+  /// </summary>
+  const unsigned int kStepsPerByte = 4;
+}
+
+PathCache::PathCache()
+    : newest_(kNone),
+      oldest_(kNone),
+      free_entry_(kNone),
+      blocks_(nullptr),
+      next_blocks_(nullptr),
+      free_block_(kNone),
+      free_block_count_(0),
+      hit_count_(0),
+      miss_count_(0),
+      eviction_count_(0),
+      entry_count_(0) {}
+
+void PathCache::Reserve(LevelArena& arena) {
+  blocks_ = arena.CreateArray<unsigned char>(kBlockSize * kBlockCount);
+  next_blocks_ = arena.CreateArray<unsigned short>(kBlockCount);
+
+  for (unsigned int i = 0; i < kBlockCount; i++) {
+    next_blocks_[i] = static_cast<unsigned short>(i + 1 < kBlockCount ? i + 1 : kNone);
+  }
+
+  free_block_ = 0;
+  free_block_count_ = kBlockCount;
+
+  for (unsigned int i = 0; i < kEntryCount; i++) {
+    entries_[i].newer_ = static_cast<unsigned short>(i + 1 < kEntryCount ? i + 1 : kNone);
+  }
+
+  free_entry_ = 0;
+  newest_ = oldest_ = kNone;
+  hit_count_ = 0;
+  miss_count_ = 0;
+  eviction_count_ = 0;
+  entry_count_ = 0;
+}
+
+bool PathCache::Find(Vector2<TileCoordinate> from_tile_position, Vector2<TileCoordinate> to_tile_position,
+                     enum Tile::block_type max_valid_block_type, TilePath& path) {
+  const std::uint64_t tiles = PackTiles(from_tile_position, to_tile_position);
+
+  for (unsigned short entry = newest_; entry != kNone; entry = entries_[entry].older_) {
+    const Entry& cached = entries_[entry];
+
+    if (cached.tiles_ != tiles || cached.max_valid_block_type_ != max_valid_block_type) {
+      continue;
+    }
+
+    path.Reset(from_tile_position);
+
+    // Every block but the last is full, so each is appended on a byte boundary.
+    unsigned int remaining_steps = cached.step_count_;
+
+    for (unsigned short block = cached.first_block_; remaining_steps > 0; block = next_blocks_[block]) {
+      const unsigned int step_count = std::min(remaining_steps, kBlockSize * kStepsPerByte);
+
+      path.AppendSteps(blocks_ + block * kBlockSize, step_count);
+      remaining_steps -= step_count;
+    }
+
+    if (entry != newest_) {
+      Unlink(entry);
+      LinkNewest(entry);
+    }
+
+    hit_count_++;
+    return true;
+  }
+
+  miss_count_++;
+  return false;
+}
+
+void PathCache::Store(Vector2<TileCoordinate> from_tile_position, Vector2<TileCoordinate> to_tile_position,
+                      enum Tile::block_type max_valid_block_type, const TilePath& path) {
+  const unsigned int step_count = path.size();
+  const unsigned int block_steps = kBlockSize * kStepsPerByte;
+  const unsigned int block_count = (step_count + block_steps - 1) / block_steps;
+
+  if (!blocks_ || step_count >= path.capacity() || block_count > kBlockCount) {
+    return;
+  }
+
+  while (free_entry_ == kNone || free_block_count_ < block_count) {
+    RemoveOldest();
+    eviction_count_++;
+  }
+
+  const unsigned short entry = free_entry_;
+  Entry& cached = entries_[entry];
+
+  free_entry_ = cached.newer_;
+  cached.tiles_ = PackTiles(from_tile_position, to_tile_position);
+  cached.max_valid_block_type_ = max_valid_block_type;
+  cached.step_count_ = step_count;
+  cached.first_block_ = block_count > 0 ? free_block_ : kNone;
+
+  // The path's blocks are taken from the front of the unused list, which they already link in order.
+  unsigned short block = free_block_;
+
+  for (unsigned int i = 0; i < block_count; i++) {
+    path.CopySteps(i * block_steps, std::min(step_count - i * block_steps, block_steps), blocks_ + block * kBlockSize);
+    free_block_ = next_blocks_[block];
+
+    if (i + 1 == block_count) {
+      next_blocks_[block] = kNone;
+    }
+
+    block = free_block_;
+  }
+
+  free_block_count_ -= block_count;
+  LinkNewest(entry);
+  entry_count_++;
+}
+
+void PathCache::Clear() {
+  while (oldest_ != kNone) {
+    RemoveOldest();
+  }
+}
+
+PathCache::Metrics PathCache::metrics() const {
+  return {hit_count_, miss_count_, eviction_count_, entry_count_};
+}
+
+std::uint64_t PathCache::PackTiles(Vector2<TileCoordinate> from_tile_position, Vector2<TileCoordinate> to_tile_position) {
+  return static_cast<std::uint64_t>(from_tile_position.x_) | static_cast<std::uint64_t>(from_tile_position.y_) << 16 |
+         static_cast<std::uint64_t>(to_tile_position.x_) << 32 | static_cast<std::uint64_t>(to_tile_position.y_) << 48;
+}
+
+void PathCache::Unlink(unsigned short entry) {
+  const Entry& cached = entries_[entry];
+
+  (cached.newer_ != kNone ? entries_[cached.newer_].older_ : newest_) = cached.older_;
+  (cached.older_ != kNone ? entries_[cached.older_].newer_ : oldest_) = cached.newer_;
+}
+
+void PathCache::LinkNewest(unsigned short entry) {
+  Entry& cached = entries_[entry];
+
+  cached.newer_ = kNone;
+  cached.older_ = newest_;
+  (newest_ != kNone ? entries_[newest_].newer_ : oldest_) = entry;
+  newest_ = entry;
+}
+
+void PathCache::RemoveOldest() {
+  const unsigned short entry = oldest_;
+  Entry& cached = entries_[entry];
+
+  Unlink(entry);
+
+  // The path's blocks are returned to the front of the unused list as a whole chain.
+  if (cached.first_block_ != kNone) {
+    unsigned short last_block = cached.first_block_;
+    unsigned int block_count = 1;
+
+    while (next_blocks_[last_block] != kNone) {
+      last_block = next_blocks_[last_block];
+      block_count++;
+    }
+
+    next_blocks_[last_block] = free_block_;
+    free_block_ = cached.first_block_;
+    free_block_count_ += block_count;
+  }
+
+  cached.newer_ = free_entry_;
+  free_entry_ = entry;
+  entry_count_--;
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "Tile.h"
+#include "Vector2.h"
+#include "TileCoordinate.h"
+
+class LevelArena;
+class TilePath;
+
+/// <summary>
+/// Keeps the most recently found paths, so that paths asked for again are copied rather than searched for.
+/// Ghosts ask for the same paths often, as each revives on its home tile and sets out for one of a few tiles.
+///
+/// Each path is keyed by its start and destination, packed into 64 bits, and by the most blocking tile type
+/// it may move onto. Its steps are stored at 2 bits per step, as TilePath stores them, in a chain of fixed
+/// size blocks reserved in the level arena. Once every entry or block is in use, the least recently used
+/// paths are evicted to make room, so the cache never allocates after the level is loaded.
+/// </summary>
+class PathCache {
+ public:
+  /// <summary>
+  /// Counts of how the cache has been used since the level was loaded.
+  /// </summary>
+  struct Metrics {
+    /// <summary>
+    /// The number of paths found in the cache.
+    /// </summary>
+    unsigned long long hit_count_;
+    /// <summary>
+    /// The number of paths that were not in the cache.
+    /// </summary>
+    unsigned long long miss_count_;
+    /// <summary>
+    /// The number of paths evicted to make room for others.
+    /// </summary>
+    unsigned long long eviction_count_;
+    /// <summary>
+    /// The number of paths held.
+    /// </summary>
+    unsigned int entry_count_;
+  };
+  /// <summary>
+  /// Constructor for the PathCache class. Nothing is cached until Reserve is called.
+  /// </summary>
+  PathCache(void);
+  /// <summary>
+  /// Reserves the storage of the steps in the level arena, forgetting every path and count. The storage
+  /// lives until the arena is released.
+  /// </summary>
+  /// <param name="arena">The arena that the storage is reserved in.</param>
+  void Reserve(LevelArena& arena);
+  /// <summary>
+  /// Copies a cached path into the given path and marks it as the most recently used, if it is held.
+  /// Counts a hit or a miss.
+  /// </summary>
+  /// <param name="from_tile_position">The map coordinates of the starting tile of the path.</param>
+  /// <param name="to_tile_position">The map coordinates of the destination tile of the path.</param>
+  /// <param name="max_valid_block_type">The most blocking tile type that the path may move onto.</param>
+  /// <param name="path">The path that the steps are stored in, replacing any previous steps. Unchanged if the
+  /// path is not held.</param>
+  /// <returns>True if the path was held, else false.</returns>
+  bool Find(Vector2<TileCoordinate> from_tile_position, Vector2<TileCoordinate> to_tile_position,
+            enum Tile::block_type max_valid_block_type, TilePath& path);
+  /// <summary>
+  /// Stores the remaining steps of a path as the most recently used, evicting the least recently used paths
+  /// until it fits. Paths that might have been cut short by the capacity of the path, and paths longer than
+  /// the whole cache, are not stored.
+  /// </summary>
+  /// <param name="from_tile_position">The map coordinates of the starting tile of the path.</param>
+  /// <param name="to_tile_position">The map coordinates of the destination tile of the path.</param>
+  /// <param name="max_valid_block_type">The most blocking tile type that the path may move onto.</param>
+  /// <param name="path">The path to store, which is left unchanged.</param>
+  void Store(Vector2<TileCoordinate> from_tile_position, Vector2<TileCoordinate> to_tile_position,
+             enum Tile::block_type max_valid_block_type, const TilePath& path);
+  /// <summary>
+  /// Forgets every path, such as after a tile's block type has changed. The counts are kept.
+  /// </summary>
+  void Clear(void);
+  /// <summary>
+  /// Gets the counts of how the cache has been used. Safe to call while paths are found on another thread.
+  /// </summary>
+  /// <returns>The counts.</returns>
+  Metrics metrics(void) const;
+
+ private:
+  /// <summary>
+  /// The greatest number of paths held.
+  /// </summary>
+  static const unsigned int kEntryCount = 64;
+  /// <summary>
+  /// The number of bytes of steps in each block, which holds 4 steps per byte.
+  /// </summary>
+  static const unsigned int kBlockSize = 64;
+  /// <summary>
+  /// The number of blocks of steps, shared between every path held.
+  /// </summary>
+  static const unsigned int kBlockCount = 1024;
+  /// <summary>
+  /// The index of no entry or block, which ends each list.
+  /// </summary>
+  static const unsigned short kNone = static_cast<unsigned short>(-1);
+  /// <summary>
+  /// A cached path.
+  /// </summary>
+  struct Entry {
+    /// <summary>
+    /// The coordinates of the start and destination of the path, 16 bits each.
+    /// </summary>
+    std::uint64_t tiles_;
+    /// <summary>
+    /// The most blocking tile type that the path may move onto.
+    /// </summary>
+    enum Tile::block_type max_valid_block_type_;
+    /// <summary>
+    /// The number of steps of the path.
+    /// </summary>
+    unsigned int step_count_;
+    /// <summary>
+    /// The index of the first block of the path's steps, or kNone if it has no steps.
+    /// </summary>
+    unsigned short first_block_;
+    /// <summary>
+    /// The index of the next more recently used entry, or of the next unused entry if the entry is unused.
+    /// </summary>
+    unsigned short newer_;
+    /// <summary>
+    /// The index of the next less recently used entry.
+    /// </summary>
+    unsigned short older_;
+  };
+  /// <summary>
+  /// Copy constructor for the PathCache class.
+  /// </summary>
+  /// <param name="reference">The PathCache reference to copy.</param>
+  PathCache(PathCache const& reference);
+  /// <summary>
+  /// Packs the start and destination of a path into the key of its entry.
+  /// </summary>
+  /// <param name="from_tile_position">The map coordinates of the starting tile of the path.</param>
+  /// <param name="to_tile_position">The map coordinates of the destination tile of the path.</param>
+  /// <returns>The packed coordinates.</returns>
+  static std::uint64_t PackTiles(Vector2<TileCoordinate> from_tile_position, Vector2<TileCoordinate> to_tile_position);
+  /// <summary>
+  /// Removes an entry from the list of used entries.
+  /// </summary>
+  /// <param name="entry">The index of the entry.</param>
+  void Unlink(unsigned short entry);
+  /// <summary>
+  /// Adds an entry to the list of used entries as the most recently used.
+  /// </summary>
+  /// <param name="entry">The index of the entry.</param>
+  void LinkNewest(unsigned short entry);
+  /// <summary>
+  /// Removes the least recently used entry, returning it and its blocks to the unused lists.
+  /// </summary>
+  void RemoveOldest(void);
+  /// <summary>
+  /// The cached paths.
+  /// </summary>
+  std::array<Entry, kEntryCount> entries_;
+  /// <summary>
+  /// The index of the most recently used entry, or kNone if no entry is used.
+  /// </summary>
+  unsigned short newest_;
+  /// <summary>
+  /// The index of the least recently used entry, or kNone if no entry is used.
+  /// </summary>
+  unsigned short oldest_;
+  /// <summary>
+  /// The index of the first unused entry, or kNone if every entry is used.
+  /// </summary>
+  unsigned short free_entry_;
+  /// <summary>
+  /// The steps of the paths, kBlockSize bytes per block. Null until Reserve is called.
+  /// </summary>
+  unsigned char* blocks_;
+  /// <summary>
+  /// The index of the block after each block in its path, or in the list of unused blocks.
+  /// </summary>
+  unsigned short* next_blocks_;
+  /// <summary>
+  /// The index of the first unused block, or kNone if every block is used.
+  /// </summary>
+  unsigned short free_block_;
+  /// <summary>
+  /// The number of unused blocks.
+  /// </summary>
+  unsigned int free_block_count_;
+  /// <summary>
+  /// The number of paths found in the cache. The counts are atomic, so they may be read from any thread.
+  /// </summary>
+  std::atomic<unsigned long long> hit_count_;
+  /// <summary>
+  /// The number of paths that were not in the cache.
+  /// </summary>
+  std::atomic<unsigned long long> miss_count_;
+  /// <summary>
+  /// The number of paths evicted to make room for others.
+  /// </summary>
+  std::atomic<unsigned long long> eviction_count_;
+  /// <summary>
+  /// The number of paths held.
+  /// </summary>
+  std::atomic<unsigned int> entry_count_;
+};
\ No newline at end of file
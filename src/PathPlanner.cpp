@@ -0,0 +1,93 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "PathPlanner.h"
+
+#include <thread>
+#include <mutex>
+
+#include "LevelArena.h"
+#include "TilePath.h"
+#include "World.h"
+
+PathPlanner::PathPlanner()
+    : requests_(nullptr),
+      capacity_(0),
+      first_request_(0),
+      queued_request_count_(0),
+      unfinished_request_count_(0),
+      stopping_(false) {
+  worker_ = std::thread(&PathPlanner::Run, this);
+}
+
+PathPlanner::~PathPlanner() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+
+  request_queued_.notify_all();
+  worker_.join();
+}
+
+void PathPlanner::Reserve(LevelArena& arena, unsigned int capacity) {
+  Finish();
+
+  requests_ = arena.CreateArray<Request>(capacity);
+  capacity_ = capacity;
+  first_request_ = 0;
+}
+
+void PathPlanner::Submit(World* world, Vector2<TileCoordinate> from_tile_position,
+                         Vector2<TileCoordinate> to_tile_position, TilePath* path) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // A full queue is drained rather than grown, so submitting never allocates.
+    if (queued_request_count_ == capacity_) {
+      requests_finished_.wait(lock, [this] { return unfinished_request_count_ == 0; });
+    }
+
+    requests_[(first_request_ + queued_request_count_) % capacity_] = {world, from_tile_position, to_tile_position, path};
+    queued_request_count_++;
+    unfinished_request_count_++;
+  }
+
+  request_queued_.notify_one();
+}
+
+void PathPlanner::Finish() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  requests_finished_.wait(lock, [this] { return unfinished_request_count_ == 0; });
+}
+
+void PathPlanner::Run() {
+  while (true) {
+    Request request;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      request_queued_.wait(lock, [this] { return stopping_ || queued_request_count_ > 0; });
+
+      // Remaining requests are finished before the worker stops.
+      if (queued_request_count_ == 0) {
+        return;
+      }
+
+      request = requests_[first_request_];
+      first_request_ = (first_request_ + 1) % capacity_;
+      queued_request_count_--;
+    }
+
+    request.world_->GetPath(request.from_tile_position_, request.to_tile_position_, *request.path_);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if (--unfinished_request_count_ == 0) {
+        requests_finished_.notify_all();
+      }
+    }
+  }
+}
\ No newline at end of file
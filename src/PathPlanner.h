@@ -0,0 +1,131 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Vector2.h"
+#include "TileCoordinate.h"
+
+class LevelArena;
+class TilePath;
+class World;
+
+/// <summary>
+/// Finds paths on a worker thread, so that a burst of path requests does not stall the frame.
+///
+/// Requests are queued in a ring reserved in the level arena and answered in the order they were submitted.
+/// The planner does not decide when a path is used: callers wait for the planner with Finish at a tick of
+/// their choosing, so a game plays out the same however long the paths take to find.
+///
+/// While a request is unfinished, the worker calls World::GetPath, so the World's paths must not be found or
+/// changed on any other thread until Finish returns.
+/// </summary>
+class PathPlanner {
+ public:
+  /// <summary>
+  /// Constructor for the PathPlanner class. Starts the worker thread, which waits for requests.
+  /// </summary>
+  PathPlanner(void);
+  /// <summary>
+  /// Destructor for the PathPlanner class.
+  /// Finishes every submitted request before the worker is joined.
+  /// </summary>
+  ~PathPlanner(void);
+  /// <summary>
+  /// Reserves the queue of requests in the level arena. The queue lives until the arena is released, so the
+  /// planner must be finished before then.
+  /// </summary>
+  /// <param name="arena">The arena that the queue is reserved in.</param>
+  /// <param name="capacity">The greatest number of requests waiting for the worker at once.</param>
+  void Reserve(LevelArena& arena, unsigned int capacity);
+  /// <summary>
+  /// Queues a request for a path. If the queue is full, waits for every queued request to finish first.
+  /// </summary>
+  /// <param name="world">Finds the path.</param>
+  /// <param name="from_tile_position">The map coordinates of the starting tile of the path.</param>
+  /// <param name="to_tile_position">The map coordinates of the destination tile of the path.</param>
+  /// <param name="path">The path that the steps are stored in, which must not be used until Finish returns.</param>
+  void Submit(World* world, Vector2<TileCoordinate> from_tile_position, Vector2<TileCoordinate> to_tile_position,
+              TilePath* path);
+  /// <summary>
+  /// Blocks until every submitted request has finished.
+  /// </summary>
+  void Finish(void);
+
+ private:
+  /// <summary>
+  /// A request for a path.
+  /// </summary>
+  struct Request {
+    /// <summary>
+    /// Finds the path.
+    /// </summary>
+    World* world_;
+    /// <summary>
+    /// The map coordinates of the starting tile of the path.
+    /// </summary>
+    Vector2<TileCoordinate> from_tile_position_;
+    /// <summary>
+    /// The map coordinates of the destination tile of the path.
+    /// </summary>
+    Vector2<TileCoordinate> to_tile_position_;
+    /// <summary>
+    /// The path that the steps are stored in.
+    /// </summary>
+    TilePath* path_;
+  };
+  /// <summary>
+  /// Copy constructor for the PathPlanner class.
+  /// </summary>
+  /// <param name="reference">The PathPlanner reference to copy.</param>
+  PathPlanner(PathPlanner const& reference);
+  /// <summary>
+  /// The body of the worker thread. Answers requests until the planner is destroyed.
+  /// </summary>
+  void Run(void);
+  /// <summary>
+  /// The ring of requests waiting for the worker. Null until Reserve is called.
+  /// </summary>
+  Request* requests_;
+  /// <summary>
+  /// The number of requests that the ring holds.
+  /// </summary>
+  unsigned int capacity_;
+  /// <summary>
+  /// The index of the oldest request waiting for the worker.
+  /// </summary>
+  unsigned int first_request_;
+  /// <summary>
+  /// The number of requests waiting for the worker.
+  /// </summary>
+  unsigned int queued_request_count_;
+  /// <summary>
+  /// The number of requests that have been submitted but have not yet finished.
+  /// </summary>
+  unsigned int unfinished_request_count_;
+  /// <summary>
+  /// Set when the worker should stop once the queue is empty.
+  /// </summary>
+  bool stopping_;
+  /// <summary>
+  /// Guards the queue, the unfinished request count and the stopping flag.
+  /// </summary>
+  std::mutex mutex_;
+  /// <summary>
+  /// Signals the worker that a request has been queued or that the planner is stopping.
+  /// </summary>
+  std::condition_variable request_queued_;
+  /// <summary>
+  /// Signals waiting threads that every submitted request has finished.
+  /// </summary>
+  std::condition_variable requests_finished_;
+  /// <summary>
+  /// The worker thread, which is started last, once every other member is initialised.
+  /// </summary>
+  std::thread worker_;
+};
\ No newline at end of file
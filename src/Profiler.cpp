@@ -0,0 +1,396 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "Profiler.h"
+
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ios>
+#include <cstdio>
+
+#include "SDL.h"
+
+#include "Drawer.h"
+#include "Vector2.h"
+#include "TraceWriter.h"
+#include "AllocationTracker.h"
+
+namespace {
+  /// <summary>
+  /// The number of bits that the zone is shifted by in a sample payload.
+  /// </summary>
+  const unsigned int kZoneShift = 56;
+  /// <summary>
+  /// Masks the duration in a sample payload.
+  /// </summary>
+  const std::uint64_t kDurationMask = (1ull << kZoneShift) - 1;
+  /// <summary>
+  /// The frame time that the game aims for, 1/60th of a second, in nanoseconds.
+  /// </summary>
+  const std::uint64_t kFrameBudgetNanos = 1000000000ull / 60;
+  /// <summary>
+  /// The top left corner of the overlay.
+  /// </summary>
+  const int kOverlayX = 187;
+  const int kOverlayY = 70;
+  /// <summary>
+  /// The height of a line of overlay text.
+  /// </summary>
+  const int kLineHeight = 22;
+  /// <summary>
+  /// The width of each bar and the height of the frame time graph, in pixels.
+  /// The graph's full height represents twice the frame budget.
+  /// </summary>
+  const int kGraphBarWidth = 4;
+  const int kGraphHeight = 60;
+}
+
+Profiler::Profiler()
+    : write_index_(0),
+      read_index_(0),
+      nanos_per_tick_(1000000000.0 / SDL_GetPerformanceFrequency()),
+      last_frame_counter_(0),
+      frame_start_counter_(0),
+      last_allocation_count_(0),
+      current_nanos_({}),
+      current_calls_({}),
+      last_calls_({}),
+      zone_history_({}),
+      frame_history_({}),
+      allocation_history_({}),
+      counters_({}),
+      history_index_(0),
+      history_count_(0),
+      overlay_visible_(false),
+      trace_writer_(nullptr),
+      frame_histogram_(kFrameBudgetNanos),
+      update_histogram_(kFrameBudgetNanos),
+      present_histogram_(kFrameBudgetNanos),
+      report_file_path_("frame_times.csv") {
+  for (auto& sample : ring_) {
+    sample.sequence_.store(0, std::memory_order_relaxed);
+    sample.payload_.store(0, std::memory_order_relaxed);
+  }
+}
+
+Profiler& Profiler::Instance() {
+  static Profiler instance;
+
+  return instance;
+}
+
+void Profiler::Record(ProfileZone zone, std::uint64_t start_counter, std::uint64_t end_counter) {
+  // Reserves a slot. If the reader has fallen a full ring behind, the oldest timing is overwritten.
+  const std::uint64_t index = write_index_.fetch_add(1, std::memory_order_relaxed);
+  Sample& sample = ring_[index & (kRingCapacity - 1)];
+
+  // Invalidates the slot while the payload is replaced, so a reader cannot pair the new payload with the old sequence.
+  sample.sequence_.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  sample.payload_.store((static_cast<std::uint64_t>(zone) << kZoneShift) | ((end_counter - start_counter) & kDurationMask),
+                        std::memory_order_relaxed);
+  sample.sequence_.store(index + 1, std::memory_order_release);
+
+  if (TraceWriter* trace_writer = trace_writer_.load(std::memory_order_acquire)) {
+    trace_writer->Submit(zone_name(zone), zone_category(zone), start_counter, end_counter, SDL_ThreadID());
+  }
+}
+
+void Profiler::EndFrame() {
+  const std::uint64_t frame_counter = SDL_GetPerformanceCounter();
+  const std::uint64_t allocation_count = AllocationTracker::allocation_count();
+  const std::uint64_t write_index = write_index_.load(std::memory_order_acquire);
+
+  // Timings that have already been overwritten are skipped.
+  if (write_index - read_index_ > kRingCapacity) {
+    read_index_ = write_index - kRingCapacity;
+  }
+
+  for (; read_index_ < write_index; read_index_++) {
+    const Sample& sample = ring_[read_index_ & (kRingCapacity - 1)];
+
+    // Skips timings that are still being written, or that were overwritten while being read.
+    if (sample.sequence_.load(std::memory_order_acquire) != read_index_ + 1) {
+      continue;
+    }
+
+    const std::uint64_t payload = sample.payload_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (sample.sequence_.load(std::memory_order_relaxed) != read_index_ + 1) {
+      continue;
+    }
+
+    const unsigned int zone = static_cast<unsigned int>(payload >> kZoneShift);
+
+    if (zone < kZoneCount) {
+      current_nanos_[zone] += static_cast<std::uint64_t>((payload & kDurationMask) * nanos_per_tick_);
+      current_calls_[zone]++;
+    }
+  }
+
+  // Moves the frame's totals into the history, replacing the oldest frame.
+  for (unsigned int zone = 0; zone < kZoneCount; zone++) {
+    zone_history_[zone][history_index_] = current_nanos_[zone];
+    last_calls_[zone] = current_calls_[zone];
+    current_nanos_[zone] = 0;
+    current_calls_[zone] = 0;
+  }
+
+  frame_history_[history_index_] = static_cast<std::uint64_t>((frame_counter - last_frame_counter_) * nanos_per_tick_);
+  last_frame_counter_ = frame_counter;
+
+  allocation_history_[history_index_] = allocation_count - last_allocation_count_;
+  last_allocation_count_ = allocation_count;
+
+  frame_histogram_.Record(static_cast<std::uint64_t>((frame_counter - frame_start_counter_) * nanos_per_tick_));
+  update_histogram_.Record(zone_history_[static_cast<unsigned int>(ProfileZone::pacman_update)][history_index_]);
+  present_histogram_.Record(zone_history_[static_cast<unsigned int>(ProfileZone::render_present)][history_index_]);
+
+  history_index_ = (history_index_ + 1) % kHistoryLength;
+  history_count_ = std::min(history_count_ + 1, kHistoryLength);
+}
+
+void Profiler::BeginFrame() {
+  frame_start_counter_ = SDL_GetPerformanceCounter();
+
+  // The first frame is timed from when it began, rather than from startup.
+  if (last_frame_counter_ == 0) {
+    last_frame_counter_ = frame_start_counter_;
+    last_allocation_count_ = AllocationTracker::allocation_count();
+  }
+}
+
+void Profiler::WriteReport() const {
+  std::ofstream report(report_file_path_);
+
+  // Handle file not accessible error.
+  if (report.fail()) {
+    throw std::ios_base::failure("Cannot create \"" + report_file_path_ + "\"");
+  }
+
+  const std::array<std::pair<const char*, const Histogram*>, 3> rows {{
+    {"frame", &frame_histogram_}, {"update", &update_histogram_}, {"present", &present_histogram_}
+  }};
+
+  report << std::fixed << std::setprecision(3)
+         << "metric,count,p50_ms,p90_ms,p99_ms,p99.9_ms,max_ms,over_budget,budget_ms\n";
+
+  for (auto& row : rows) {
+    const Histogram& histogram = *row.second;
+
+    report << row.first << ',' << histogram.count() << ','
+           << histogram.ValueAtPercentile(50.0) / 1000000.0 << ','
+           << histogram.ValueAtPercentile(90.0) / 1000000.0 << ','
+           << histogram.ValueAtPercentile(99.0) / 1000000.0 << ','
+           << histogram.ValueAtPercentile(99.9) / 1000000.0 << ','
+           << histogram.max() / 1000000.0 << ','
+           << histogram.over_threshold_count() << ','
+           << kFrameBudgetNanos / 1000000.0 << '\n';
+  }
+
+  if (report.fail()) {
+    throw std::ios_base::failure("Cannot write \"" + report_file_path_ + "\"");
+  }
+}
+
+Profiler::Stats Profiler::zone_stats(ProfileZone zone) const {
+  const unsigned int z = static_cast<unsigned int>(zone);
+
+  return CalculateStats(zone_history_[z], last_calls_[z]);
+}
+
+Profiler::Stats Profiler::frame_stats() const {
+  return CalculateStats(frame_history_, 1);
+}
+
+Profiler::Stats Profiler::allocation_stats() const {
+  return CalculateStats(allocation_history_, 1);
+}
+
+std::uint64_t Profiler::frame_allocations() const {
+  return allocation_history_[(history_index_ + kHistoryLength - 1) % kHistoryLength];
+}
+
+Profiler::Stats Profiler::CalculateStats(const std::array<std::uint64_t, kHistoryLength>& history,
+                                         unsigned int last_calls) const {
+  if (history_count_ == 0) {
+    return {0, 0, 0, 0};
+  }
+
+  // Before the history is full, only the slots written so far are considered.
+  std::array<std::uint64_t, kHistoryLength> sorted;
+  std::copy(history.begin(), history.begin() + history_count_, sorted.begin());
+
+  std::uint64_t total = 0;
+
+  for (unsigned int i = 0; i < history_count_; i++) {
+    total += sorted[i];
+  }
+
+  // The nearest-rank 99th percentile.
+  const unsigned int p99_rank = (history_count_ * 99 + 99) / 100 - 1;
+  std::nth_element(sorted.begin(), sorted.begin() + p99_rank, sorted.begin() + history_count_);
+
+  return {
+    history[(history_index_ + kHistoryLength - 1) % kHistoryLength],
+    total / history_count_,
+    sorted[p99_rank],
+    last_calls
+  };
+}
+
+void Profiler::SetCounter(ProfileCounter counter, std::uint64_t value) {
+  counters_[static_cast<unsigned int>(counter)] = value;
+}
+
+const char* Profiler::counter_name(ProfileCounter counter) {
+  switch (counter) {
+    case ProfileCounter::draw_calls:
+      return "DRAWS";
+    case ProfileCounter::texture_switches:
+      return "TEX SW";
+    case ProfileCounter::texture_kib:
+      return "VRAM KB";
+    case ProfileCounter::path_cache_hits:
+      return "PATH HIT";
+    case ProfileCounter::path_cache_misses:
+      return "PATH MISS";
+  }
+
+  return "";
+}
+
+const char* Profiler::zone_name(ProfileZone zone) {
+  switch (zone) {
+    case ProfileZone::pacman_update:
+      return "UPDATE";
+    case ProfileZone::ghost_update:
+      return "GHOSTS";
+    case ProfileZone::world_get_path:
+      return "PATHS";
+    case ProfileZone::world_check_dot_intersection:
+      return "DOTS";
+    case ProfileZone::pacman_draw:
+      return "DRAW";
+    case ProfileZone::drawer_draw_text:
+      return "TEXT";
+    case ProfileZone::render_present:
+      return "PRESENT";
+    case ProfileZone::asset_load:
+      return "LOADS";
+  }
+
+  return "";
+}
+
+const char* Profiler::zone_category(ProfileZone zone) {
+  switch (zone) {
+    case ProfileZone::pacman_update:
+    case ProfileZone::ghost_update:
+    case ProfileZone::world_check_dot_intersection:
+      return "update";
+    case ProfileZone::world_get_path:
+      return "path";
+    case ProfileZone::pacman_draw:
+    case ProfileZone::drawer_draw_text:
+      return "draw";
+    case ProfileZone::render_present:
+      return "present";
+    case ProfileZone::asset_load:
+      return "asset";
+  }
+
+  return "";
+}
+
+void Profiler::set_trace_writer(TraceWriter* trace_writer) {
+  trace_writer_.store(trace_writer, std::memory_order_release);
+}
+
+void Profiler::set_report_file_path(const std::string& report_file_path) {
+  report_file_path_ = report_file_path;
+}
+
+const std::string& Profiler::report_file_path() const {
+  return report_file_path_;
+}
+
+const Histogram& Profiler::frame_histogram() const {
+  return frame_histogram_;
+}
+
+void Profiler::DrawOverlay(const Drawer* drawer) const {
+  if (!overlay_visible_) {
+    return;
+  }
+
+  const int graph_y = kOverlayY + (kZoneCount + 3 + kCounterCount) * kLineHeight + 8;
+
+  // Darkens the map behind the overlay so the text is readable.
+  drawer->DrawRect({kOverlayX - 5, kOverlayY - 5, static_cast<int>(kHistoryLength) * kGraphBarWidth + 10,
+                    graph_y + kGraphHeight + 5 - (kOverlayY - 5)}, {0, 0, 0, 192}, DrawLayer::overlay);
+
+  // Lists the rolling average and 99th percentile of each zone, in microseconds, followed by the frame time.
+  // Lines are formatted into a fixed buffer, so drawing the overlay does not allocate.
+  char line[64];
+  std::snprintf(line, sizeof(line), "%-8s%9s%9s%6s", "ZONE", "AVG US", "P99 US", "CALLS");
+  drawer->DrawText(line, Vector2<float>(kOverlayX, kOverlayY), {252, 252, 0}, DrawLayer::overlay);
+
+  for (unsigned int zone = 0; zone <= kZoneCount; zone++) {
+    const bool frame_line = zone == kZoneCount;
+    const Stats stats = frame_line ? frame_stats() : zone_stats(static_cast<ProfileZone>(zone));
+
+    std::snprintf(line, sizeof(line), "%-8s%9.1f%9.1f%6u", frame_line ? "FRAME" : zone_name(static_cast<ProfileZone>(zone)),
+                  stats.average_ / 1000.0, stats.p99_ / 1000.0, stats.last_calls_);
+    drawer->DrawText(line, Vector2<float>(kOverlayX, kOverlayY + (zone + 1) * kLineHeight), {252, 252, 255},
+                     DrawLayer::overlay);
+  }
+
+  // Lists the average, 99th percentile and most recent number of heap allocations per frame.
+  const Stats allocations = allocation_stats();
+  std::snprintf(line, sizeof(line), "%-8s%9.1f%9llu%6llu", "ALLOCS", static_cast<double>(allocations.average_),
+                static_cast<unsigned long long>(allocations.p99_),
+                static_cast<unsigned long long>(allocations.last_));
+  drawer->DrawText(line, Vector2<float>(kOverlayX, kOverlayY + (kZoneCount + 2) * kLineHeight),
+                   allocations.last_ > 0 ? SDL_Color {252, 0, 0} : SDL_Color {252, 252, 255}, DrawLayer::overlay);
+
+  // Lists the most recent value of each counter.
+  for (unsigned int counter = 0; counter < kCounterCount; counter++) {
+    std::snprintf(line, sizeof(line), "%-10s%16llu", counter_name(static_cast<ProfileCounter>(counter)),
+                  static_cast<unsigned long long>(counters_[counter]));
+    drawer->DrawText(line, Vector2<float>(kOverlayX, kOverlayY + (kZoneCount + 3 + counter) * kLineHeight),
+                     {252, 252, 255}, DrawLayer::overlay);
+  }
+
+  // Graphs the recent frame times, oldest on the left. Frames over budget are shown in red.
+  const SDL_Rect budget_line {kOverlayX, graph_y + kGraphHeight / 2, static_cast<int>(kHistoryLength) * kGraphBarWidth, 1};
+  drawer->DrawRect(budget_line, {252, 252, 255, 96}, DrawLayer::overlay);
+
+  for (unsigned int i = 0; i < history_count_; i++) {
+    const unsigned int history_slot = (history_index_ + kHistoryLength - history_count_ + i) % kHistoryLength;
+    const std::uint64_t frame_nanos = frame_history_[history_slot];
+    const int bar_height = static_cast<int>(std::min<std::uint64_t>(frame_nanos * kGraphHeight / (kFrameBudgetNanos * 2),
+                                                                    kGraphHeight));
+    const SDL_Color bar_colour = frame_nanos > kFrameBudgetNanos ? SDL_Color {252, 0, 0, 255} : SDL_Color {0, 252, 0, 255};
+
+    drawer->DrawRect({kOverlayX + static_cast<int>(i) * kGraphBarWidth, graph_y + kGraphHeight - bar_height,
+                      kGraphBarWidth - 1, bar_height}, bar_colour, DrawLayer::overlay);
+  }
+}
+
+void Profiler::ToggleOverlay() {
+  overlay_visible_ = !overlay_visible_;
+}
+
+ScopedTimer::ScopedTimer(ProfileZone zone)
+    : zone_(zone),
+      start_counter_(SDL_GetPerformanceCounter()) {}
+
+ScopedTimer::~ScopedTimer() {
+  Profiler::Instance().Record(zone_, start_counter_, SDL_GetPerformanceCounter());
+}
\ No newline at end of file
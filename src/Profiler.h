@@ -0,0 +1,337 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+#include "Histogram.h"
+
+class Drawer;
+class TraceWriter;
+
+/// <summary>
+/// The sections of a frame that are timed by the profiler.
+/// </summary>
+enum class ProfileZone : unsigned char {
+  pacman_update, ghost_update, world_get_path, world_check_dot_intersection, pacman_draw, drawer_draw_text,
+  render_present, asset_load
+};
+
+/// <summary>
+/// The values that the game reports to the profiler once per frame, which the overlay lists below the zones.
+/// </summary>
+enum class ProfileCounter : unsigned char {
+  draw_calls, texture_switches, texture_kib, path_cache_hits, path_cache_misses
+};
+
+/// <summary>
+/// Records nanosecond timings of the profiled zones and aggregates them per frame.
+/// Timings may be recorded from any thread without locking. They are written into a ring buffer,
+/// which the game loop drains once per frame to maintain a rolling history of each zone.
+/// While a trace writer is attached, every timing is also submitted to it as a trace event.
+/// The frame, update and present times of every frame are also kept in histograms, which can be
+/// written to a CSV report of their percentiles. The number of heap allocations made in each frame is
+/// counted by the AllocationTracker and kept alongside the timings.
+/// </summary>
+class Profiler {
+ public:
+  /// <summary>
+  /// Rolling statistics of a per-frame value over the frames in the history. The value is a time in nanoseconds
+  /// for a zone or the whole frame, and a count for allocations.
+  /// </summary>
+  struct Stats {
+    /// <summary>
+    /// The value in the most recent frame.
+    /// </summary>
+    std::uint64_t last_;
+    /// <summary>
+    /// The mean value per frame.
+    /// </summary>
+    std::uint64_t average_;
+    /// <summary>
+    /// The 99th percentile of the value per frame.
+    /// </summary>
+    std::uint64_t p99_;
+    /// <summary>
+    /// The number of times the zone was entered in the most recent frame.
+    /// </summary>
+    unsigned int last_calls_;
+  };
+  /// <summary>
+  /// Retrieves a singleton instance of the Profiler class.
+  /// </summary>
+  /// <returns>A singleton instance of the Profiler class.</returns>
+  static Profiler& Instance(void);
+  /// <summary>
+  /// Records a single timing of a zone, and submits it to the attached trace writer. Safe to call from any thread.
+  /// </summary>
+  /// <param name="zone">The zone that was timed.</param>
+  /// <param name="start_counter">The performance counter value when the zone was entered.</param>
+  /// <param name="end_counter">The performance counter value when the zone was left.</param>
+  void Record(ProfileZone zone, std::uint64_t start_counter, std::uint64_t end_counter);
+  /// <summary>
+  /// Ends the current frame. Drains the timings recorded during the frame into the history,
+  /// along with the time since the previous frame ended. Must be called from a single thread.
+  /// </summary>
+  void EndFrame(void);
+  /// <summary>
+  /// Begins the current frame, once the game loop has finished waiting for it.
+  /// The time until EndFrame is the frame's busy time, which is recorded in the frame histogram.
+  /// </summary>
+  void BeginFrame(void);
+  /// <summary>
+  /// Writes the p50, p90, p99, p99.9 and maximum frame, update and present times to the report file as CSV,
+  /// with the number of frames in which each exceeded the 1/60 s budget.
+  /// Throws if the file cannot be written.
+  /// </summary>
+  void WriteReport(void) const;
+  /// <summary>
+  /// Gets the rolling statistics of a zone.
+  /// </summary>
+  /// <param name="zone">The zone to get statistics for.</param>
+  /// <returns>The rolling statistics of the zone.</returns>
+  Stats zone_stats(ProfileZone zone) const;
+  /// <summary>
+  /// Gets the rolling statistics of the time between frames.
+  /// </summary>
+  /// <returns>The rolling statistics of the frame time.</returns>
+  Stats frame_stats(void) const;
+  /// <summary>
+  /// Gets the rolling statistics of the number of heap allocations made per frame.
+  /// </summary>
+  /// <returns>The rolling statistics of the allocation count.</returns>
+  Stats allocation_stats(void) const;
+  /// <summary>
+  /// Gets the number of heap allocations made during the most recent frame, on any thread.
+  /// </summary>
+  /// <returns>The number of allocations.</returns>
+  std::uint64_t frame_allocations(void) const;
+  /// <summary>
+  /// Sets the value of a counter, which the overlay shows until it is next set.
+  /// </summary>
+  /// <param name="counter">The counter to set.</param>
+  /// <param name="value">The value of the counter.</param>
+  void SetCounter(ProfileCounter counter, std::uint64_t value);
+  /// <summary>
+  /// Gets the display name of a counter.
+  /// </summary>
+  /// <param name="counter">The counter to name.</param>
+  /// <returns>The display name of the counter.</returns>
+  static const char* counter_name(ProfileCounter counter);
+  /// <summary>
+  /// Gets the display name of a zone.
+  /// </summary>
+  /// <param name="zone">The zone to name.</param>
+  /// <returns>The display name of the zone.</returns>
+  static const char* zone_name(ProfileZone zone);
+  /// <summary>
+  /// Gets the trace event category of a zone, which groups zones by the phase of the frame they belong to.
+  /// </summary>
+  /// <param name="zone">The zone to categorise.</param>
+  /// <returns>The trace event category of the zone.</returns>
+  static const char* zone_category(ProfileZone zone);
+  /// <summary>
+  /// Attaches a trace writer that every subsequent timing is submitted to, or detaches it.
+  /// Timings must not be recorded on other threads while the writer is being detached.
+  /// </summary>
+  /// <param name="trace_writer">The trace writer, or nullptr to stop tracing.</param>
+  void set_trace_writer(TraceWriter* trace_writer);
+  /// <summary>
+  /// Sets the file that the histogram report is written to.
+  /// </summary>
+  /// <param name="report_file_path">The path of the CSV file.</param>
+  void set_report_file_path(const std::string& report_file_path);
+  /// <summary>
+  /// Gets the file that the histogram report is written to.
+  /// </summary>
+  /// <returns>The path of the CSV file.</returns>
+  const std::string& report_file_path(void) const;
+  /// <summary>
+  /// Gets the histogram of the busy time of each frame, in nanoseconds.
+  /// </summary>
+  /// <returns>The histogram of frame times.</returns>
+  const Histogram& frame_histogram(void) const;
+  /// <summary>
+  /// Adds the overlay, showing each zone's statistics, the counters and a graph of recent frame times, to the
+  /// drawing batch.
+  /// Does nothing if the overlay is hidden.
+  /// </summary>
+  /// <param name="drawer">Draws the overlay.</param>
+  void DrawOverlay(const Drawer* drawer) const;
+  /// <summary>
+  /// Shows the overlay if it is hidden, else hides it.
+  /// </summary>
+  void ToggleOverlay(void);
+  /// <summary>
+  /// The number of profiled zones.
+  /// </summary>
+  static const unsigned int kZoneCount = 8;
+  /// <summary>
+  /// The number of counters.
+  /// </summary>
+  static const unsigned int kCounterCount = 5;
+  /// <summary>
+  /// The number of frames that rolling statistics are calculated over.
+  /// </summary>
+  static const unsigned int kHistoryLength = 120;
+
+ private:
+  /// <summary>
+  /// Constructor for the Profiler class.
+  /// </summary>
+  Profiler(void);
+  /// <summary>
+  /// Copy constructor for the Profiler class.
+  /// </summary>
+  /// <param name="reference">The Profiler reference to copy.</param>
+  Profiler(Profiler const& reference);
+  /// <summary>
+  /// Calculates rolling statistics from a history of per-frame values.
+  /// </summary>
+  /// <param name="history">The per-frame values.</param>
+  /// <param name="last_calls">The number of calls in the most recent frame.</param>
+  /// <returns>The rolling statistics.</returns>
+  Stats CalculateStats(const std::array<std::uint64_t, kHistoryLength>& history, unsigned int last_calls) const;
+  /// <summary>
+  /// A timing in the ring buffer.
+  /// </summary>
+  struct Sample {
+    /// <summary>
+    /// One more than the index of the timing written to this slot, published after the payload.
+    /// A reader only accepts the payload if the sequence matches the index it expects.
+    /// </summary>
+    std::atomic<std::uint64_t> sequence_;
+    /// <summary>
+    /// The zone in the top 8 bits, and the duration in performance counter ticks in the remaining bits.
+    /// </summary>
+    std::atomic<std::uint64_t> payload_;
+  };
+  /// <summary>
+  /// The number of timings the ring buffer holds. Must be a power of two.
+  /// </summary>
+  static const unsigned int kRingCapacity = 4096;
+  /// <summary>
+  /// The ring buffer of timings that have not yet been drained.
+  /// </summary>
+  std::array<Sample, kRingCapacity> ring_;
+  /// <summary>
+  /// The index of the next timing to be written. Reserved atomically by each writer.
+  /// </summary>
+  std::atomic<std::uint64_t> write_index_;
+  /// <summary>
+  /// The index of the next timing to be drained.
+  /// </summary>
+  std::uint64_t read_index_;
+  /// <summary>
+  /// The number of nanoseconds in a performance counter tick.
+  /// </summary>
+  double nanos_per_tick_;
+  /// <summary>
+  /// The performance counter value when the previous frame ended. Zero until the first frame begins.
+  /// </summary>
+  std::uint64_t last_frame_counter_;
+  /// <summary>
+  /// The performance counter value when the current frame began.
+  /// </summary>
+  std::uint64_t frame_start_counter_;
+  /// <summary>
+  /// The allocation count when the previous frame ended.
+  /// </summary>
+  std::uint64_t last_allocation_count_;
+  /// <summary>
+  /// The total time spent in each zone during the frame being recorded, in nanoseconds.
+  /// </summary>
+  std::array<std::uint64_t, kZoneCount> current_nanos_;
+  /// <summary>
+  /// The number of times each zone was entered during the frame being recorded.
+  /// </summary>
+  std::array<unsigned int, kZoneCount> current_calls_;
+  /// <summary>
+  /// The number of times each zone was entered during the most recent frame.
+  /// </summary>
+  std::array<unsigned int, kZoneCount> last_calls_;
+  /// <summary>
+  /// The time spent in each zone per frame, for the most recent frames.
+  /// </summary>
+  std::array<std::array<std::uint64_t, kHistoryLength>, kZoneCount> zone_history_;
+  /// <summary>
+  /// The time between frames, for the most recent frames.
+  /// </summary>
+  std::array<std::uint64_t, kHistoryLength> frame_history_;
+  /// <summary>
+  /// The number of heap allocations, for the most recent frames.
+  /// </summary>
+  std::array<std::uint64_t, kHistoryLength> allocation_history_;
+  /// <summary>
+  /// The most recently set value of each counter.
+  /// </summary>
+  std::array<std::uint64_t, kCounterCount> counters_;
+  /// <summary>
+  /// The index in the histories that the next frame is written to.
+  /// </summary>
+  unsigned int history_index_;
+  /// <summary>
+  /// The number of frames in the histories, up to kHistoryLength.
+  /// </summary>
+  unsigned int history_count_;
+  /// <summary>
+  /// True if the overlay is drawn.
+  /// </summary>
+  bool overlay_visible_;
+  /// <summary>
+  /// The trace writer that timings are submitted to. Null while not tracing.
+  /// </summary>
+  std::atomic<TraceWriter*> trace_writer_;
+  /// <summary>
+  /// The busy time of every frame, excluding the wait for the next frame, in nanoseconds.
+  /// </summary>
+  Histogram frame_histogram_;
+  /// <summary>
+  /// The time spent updating the game, in nanoseconds, for every frame.
+  /// </summary>
+  Histogram update_histogram_;
+  /// <summary>
+  /// The time spent presenting, in nanoseconds, for every frame.
+  /// </summary>
+  Histogram present_histogram_;
+  /// <summary>
+  /// The file that the histogram report is written to.
+  /// </summary>
+  std::string report_file_path_;
+};
+
+/// <summary>
+/// Times a zone from construction until the end of the enclosing scope.
+/// </summary>
+class ScopedTimer {
+ public:
+  /// <summary>
+  /// Constructor for the ScopedTimer class. Starts timing the zone.
+  /// </summary>
+  /// <param name="zone">The zone to time.</param>
+  ScopedTimer(ProfileZone zone);
+  /// <summary>
+  /// Destructor for the ScopedTimer class. Records the time spent in the zone.
+  /// </summary>
+  ~ScopedTimer(void);
+
+ private:
+  /// <summary>
+  /// Copy constructor for the ScopedTimer class.
+  /// </summary>
+  /// <param name="reference">The ScopedTimer reference to copy.</param>
+  ScopedTimer(ScopedTimer const& reference);
+  /// <summary>
+  /// The zone being timed.
+  /// </summary>
+  ProfileZone zone_;
+  /// <summary>
+  /// The performance counter value when the zone was entered.
+  /// </summary>
+  std::uint64_t start_counter_;
+};
\ No newline at end of file
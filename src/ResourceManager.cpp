@@ -5,17 +5,63 @@
 #include "ResourceManager.h"
 
 #include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
 #include <ios>
 #include <iostream>
+#include <fstream>
+#include <iterator>
 
 #include "SDL_ttf.h"
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include "SDL_image.h"
 
-std::unordered_map<std::string, SDL_Texture*> ResourceManager::textures_ {};
+#include "ThreadPool.h"
+#include "AssetArchive.h"
+#include "Profiler.h"
+
+std::vector<ResourceManager::Slot> ResourceManager::slots_ {};
+std::vector<std::uint32_t> ResourceManager::free_slots_ {};
+std::unordered_map<std::string, std::uint32_t> ResourceManager::slot_indices_ {};
+std::unordered_map<std::string, TTF_Font*> ResourceManager::fonts_ {};
 TTF_Font* ResourceManager::font_ = nullptr;
+ResourceManager::Metrics ResourceManager::metrics_ {0, 0, 0, 0, 0, 0, 0};
+unsigned int ResourceManager::frame_ = 0;
+AssetArchive* ResourceManager::archive_ = nullptr;
 std::string ResourceManager::kAssetPath;
 
+#ifdef _WIN32
+static const char kPathSeparator = '\\';
+#else
+static const char kPathSeparator = '/';
+#endif
+
+// Converts the difference between two performance counter values into milliseconds.
+static double GetElapsedMillis(Uint64 start_counter, Uint64 end_counter) {
+  return (end_counter - start_counter) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+// Creates a texture from the pre-decoded pixels of an archived image, without any conversion.
+static ResourceManager::Texture CreateArchivedTexture(const AssetArchive::Entry& entry, SDL_Renderer* renderer) {
+  ScopedTimer timer(ProfileZone::asset_load);
+
+  SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                           entry.width_, entry.height_);
+
+  if (texture == NULL || SDL_UpdateTexture(texture, NULL, entry.data_, entry.width_ * 4) != 0) {
+    SDL_DestroyTexture(texture);
+    throw std::ios_base::failure("Cannot create texture for \"" + entry.name_ + "\"");
+  }
+
+  // Matches the blending of textures created from decoded images, which all have an alpha channel.
+  SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+  return {texture, entry.width_, entry.height_, 0};
+}
+
 // Prevents regular object construction.
 ResourceManager::ResourceManager() {
   return;
@@ -23,13 +69,18 @@ ResourceManager::ResourceManager() {
 
 ResourceManager::~ResourceManager() {
   // Releases font resources.
-  if (font_ != nullptr) {
-    TTF_CloseFont(font_);
+  for (auto& f : fonts_) {
+    TTF_CloseFont(f.second);
   }
 
+  // Unmaps the archive once the fonts, which are read from it, have been closed.
+  delete archive_;
+
   // Reeases texture resources.
-  for (auto& t : textures_) {
-    SDL_DestroyTexture(t.second);
+  for (auto& slot : slots_) {
+    if (slot.texture_.texture_ != nullptr) {
+      SDL_DestroyTexture(slot.texture_.texture_);
+    }
   }
 
   // Closes active SDL subsystems.
@@ -39,24 +90,39 @@ ResourceManager::~ResourceManager() {
 
 ResourceManager& ResourceManager::Instance() {
   static ResourceManager instance;
-  
-  try {
-    GenerateAssetPath();
-  } catch (const std::exception& e) {
-    std::cerr << e.what() << std::endl;
-    exit(EXIT_FAILURE);
+
+  // The asset path only needs to be generated once.
+  if (kAssetPath.empty()) {
+    try {
+      GenerateAssetPath();
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << std::endl;
+      exit(EXIT_FAILURE);
+    }
   }
 
   return instance;
 }
 
 void ResourceManager::GenerateAssetPath() {
+#ifdef _WIN32
   char result[MAX_PATH]{};
   // Compatible with Windows OS.
   auto str_result = std::string(result, GetModuleFileName(NULL, result, MAX_PATH));
+#else
+  // SDL locates the executable's directory on other platforms, such as headless Linux servers.
+  char* base_path = SDL_GetBasePath();
+
+  if (!base_path) {
+    throw std::ios_base::failure("Cannot locate the executable directory");
+  }
+
+  auto str_result = std::string(base_path);
+  SDL_free(base_path);
+#endif
 
-  // Removes the file name from the absolute file path.
-  str_result.erase(str_result.begin() + str_result.rfind("\\"), str_result.end());
+  // Removes the file name (or trailing separator) from the absolute file path.
+  str_result.erase(str_result.begin() + str_result.rfind(kPathSeparator), str_result.end());
 
 
   auto project_dir_pos = str_result.rfind("pacman");
@@ -65,45 +131,289 @@ void ResourceManager::GenerateAssetPath() {
   }
 
   str_result.replace(str_result.begin() + str_result.rfind("pacman")+6, str_result.end(),
-    "\\assets\\");
+    std::string(1, kPathSeparator) + "assets" + kPathSeparator);
 
   kAssetPath = str_result;
 }
 
-SDL_Texture* ResourceManager::GetTexture(std::string file_path, SDL_Renderer* renderer) {
+std::string ResourceManager::GetAssetFilePath(const std::string& file_path) {
+  std::string result = kAssetPath + file_path;
+
+#ifndef _WIN32
+  // Asset paths are written with Windows separators throughout the game.
+  std::replace(result.begin(), result.end(), '\\', kPathSeparator);
+#endif
+
+  return result;
+}
+
+bool ResourceManager::OpenArchive() {
+  const std::string archive_path = GetAssetFilePath(AssetArchive::kFileName);
+
+  if (archive_ == nullptr && std::filesystem::exists(archive_path)) {
+    archive_ = new AssetArchive(archive_path);
+  }
+
+  return archive_ != nullptr;
+}
+
+std::string ResourceManager::ReadFile(const std::string& file_path) const {
+  const AssetArchive::Entry* entry = archive_ ? archive_->Find(file_path) : nullptr;
+
+  if (entry) {
+    return std::string(reinterpret_cast<const char*>(entry->data_), entry->size_);
+  }
+
+  std::ifstream file(GetAssetFilePath(file_path), std::ios::binary);
+
+  // Handle file not accessible error.
+  if (file.fail()) {
+    throw std::ios_base::failure("Cannot find/access \"" + kAssetPath + file_path + "\"");
+  }
+
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+ResourceManager::TextureHandle ResourceManager::Acquire(const std::string& file_path, SDL_Renderer* renderer) {
   // Searches in cache for the requested texture.
-  auto texture_iter = ResourceManager::textures_.find(file_path);
+  auto slot_iter = slot_indices_.find(file_path);
+
+  if (slot_iter != slot_indices_.end()) {
+    return {slot_iter->second, slots_[slot_iter->second].generation_};
+  }
 
   // Inserts texture if not already present in cache.
-  if (texture_iter == textures_.end()) {
-    SDL_Surface* s = IMG_Load((kAssetPath + file_path).c_str());
+  return Insert(file_path, LoadTexture(file_path, renderer));
+}
+
+const ResourceManager::Texture* ResourceManager::Resolve(TextureHandle handle) {
+  if (handle.index_ >= slots_.size() || slots_[handle.index_].generation_ != handle.generation_) {
+    metrics_.stale_handle_count_++;
+    return nullptr;
+  }
+
+  Slot& slot = slots_[handle.index_];
+  slot.last_used_frame_ = frame_;
 
-    // Handles file being unable to load.
-    if (s == NULL) {
-      throw std::ios_base::failure("Cannot find/access \"" + kAssetPath + file_path + "\"");
+  return &slot.texture_;
+}
+
+const ResourceManager::Texture& ResourceManager::GetTexture(const std::string& file_path, SDL_Renderer* renderer) {
+  // A handle that has just been acquired is never stale.
+  return *Resolve(Acquire(file_path, renderer));
+}
+
+void ResourceManager::EndFrame() {
+  if (metrics_.texture_budget_bytes_ > 0 && metrics_.texture_bytes_ > metrics_.texture_budget_bytes_) {
+    // Textures used this frame are the working set, so only older textures are candidates.
+    std::vector<std::uint32_t> candidates;
+
+    for (auto& entry : slot_indices_) {
+      if (slots_[entry.second].last_used_frame_ != frame_) {
+        candidates.push_back(entry.second);
+      }
     }
 
-    SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s);
-    SDL_FreeSurface(s);
+    // Evicts the least recently used first. Ties are broken by slot so eviction is deterministic.
+    std::sort(candidates.begin(), candidates.end(), [](std::uint32_t a, std::uint32_t b) {
+      return slots_[a].last_used_frame_ != slots_[b].last_used_frame_ ?
+        slots_[a].last_used_frame_ < slots_[b].last_used_frame_ : a < b;
+    });
+
+    for (auto index : candidates) {
+      if (metrics_.texture_bytes_ <= metrics_.texture_budget_bytes_) {
+        break;
+      }
 
-    textures_.insert({file_path, t});
+      Evict(index);
+    }
   }
 
-  return textures_[file_path];
+  frame_++;
+}
+
+ResourceManager::Texture ResourceManager::LoadTexture(const std::string& file_path, SDL_Renderer* renderer) {
+  // Creates the texture from the archive without decoding, if the archive contains it.
+  const AssetArchive::Entry* entry = archive_ ? archive_->Find(file_path) : nullptr;
+
+  if (entry && entry->type_ == AssetArchive::entry_type::image) {
+    return CreateArchivedTexture(*entry, renderer);
+  }
+
+  ScopedTimer timer(ProfileZone::asset_load);
+  SDL_Surface* s = IMG_Load(GetAssetFilePath(file_path).c_str());
+
+  // Handles file being unable to load.
+  if (s == NULL) {
+    throw std::ios_base::failure("Cannot find/access \"" + kAssetPath + file_path + "\"");
+  }
+
+  // The dimensions are cached alongside the texture so that drawing never needs to query them.
+  Texture t {SDL_CreateTextureFromSurface(renderer, s), s->w, s->h, 0};
+  SDL_FreeSurface(s);
+
+  return t;
+}
+
+ResourceManager::TextureHandle ResourceManager::Insert(const std::string& file_path, Texture texture) {
+  std::uint32_t index;
+
+  if (free_slots_.empty()) {
+    index = static_cast<std::uint32_t>(slots_.size());
+    slots_.push_back({{nullptr, 0, 0, 0}, "", 0, 0, 0});
+  } else {
+    index = free_slots_.back();
+    free_slots_.pop_back();
+  }
+
+  // Estimates the GPU memory from the format the renderer stores the texture in.
+  Uint32 format = SDL_PIXELFORMAT_ARGB8888;
+  SDL_QueryTexture(texture.texture_, &format, NULL, NULL, NULL);
+
+  Slot& slot = slots_[index];
+  texture.id_ = index;
+  slot.texture_ = texture;
+  slot.file_path_ = file_path;
+  slot.byte_size_ = static_cast<size_t>(texture.width_) * texture.height_ * SDL_BYTESPERPIXEL(format);
+  slot.last_used_frame_ = frame_;
+  slot_indices_.insert({file_path, index});
+
+  metrics_.texture_count_++;
+  metrics_.texture_bytes_ += slot.byte_size_;
+  metrics_.peak_texture_bytes_ = std::max(metrics_.peak_texture_bytes_, metrics_.texture_bytes_);
+  metrics_.load_count_++;
+
+  return {index, slot.generation_};
+}
+
+void ResourceManager::Evict(std::uint32_t index) {
+  Slot& slot = slots_[index];
+
+  SDL_DestroyTexture(slot.texture_.texture_);
+  slot_indices_.erase(slot.file_path_);
+
+  metrics_.texture_count_--;
+  metrics_.texture_bytes_ -= slot.byte_size_;
+  metrics_.eviction_count_++;
+
+  slot.texture_ = {nullptr, 0, 0, 0};
+  slot.file_path_.clear();
+  slot.byte_size_ = 0;
+  slot.generation_++;
+  free_slots_.push_back(index);
+}
+
+ResourceManager::PreloadTimings ResourceManager::Preload(SDL_Renderer* renderer, ThreadPool& thread_pool) {
+  PreloadTimings timings {archive_ != nullptr, 0, thread_pool.thread_count(), 0.0, 0.0, 0.0};
+  auto start_counter = SDL_GetPerformanceCounter();
+
+  // The archive holds every image pre-decoded and sorted by path, so textures are created directly from it.
+  if (archive_) {
+    timings.thread_count_ = 0;
+
+    for (auto& entry : archive_->entries()) {
+      if (entry.type_ == AssetArchive::entry_type::image && slot_indices_.find(entry.name_) == slot_indices_.end()) {
+        Insert(entry.name_, CreateArchivedTexture(entry, renderer));
+        timings.image_count_++;
+      }
+    }
+
+    timings.upload_millis_ = GetElapsedMillis(start_counter, SDL_GetPerformanceCounter());
+
+    return timings;
+  }
+
+  // Finds every image, keyed by its path relative to the "assets" folder with the separators used by the game.
+  std::vector<std::string> file_paths;
+
+  for (auto& entry : std::filesystem::recursive_directory_iterator(kAssetPath)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".png") {
+      auto file_path = entry.path().lexically_relative(kAssetPath).string();
+      std::replace(file_path.begin(), file_path.end(), '/', '\\');
+      file_paths.push_back(file_path);
+    }
+  }
+
+  // Sorted so that texture identifiers are assigned in the same order on every run.
+  std::sort(file_paths.begin(), file_paths.end());
+
+  auto enumerated_counter = SDL_GetPerformanceCounter();
+  timings.enumerate_millis_ = GetElapsedMillis(start_counter, enumerated_counter);
+
+  // Decodes the images in parallel. Each task only writes to its own element.
+  std::vector<SDL_Surface*> surfaces(file_paths.size(), nullptr);
+
+  for (size_t i = 0; i < file_paths.size(); i++) {
+    thread_pool.Submit([&file_paths, &surfaces, i] {
+      ScopedTimer timer(ProfileZone::asset_load);
+      surfaces[i] = IMG_Load(GetAssetFilePath(file_paths[i]).c_str());
+    });
+  }
+
+  thread_pool.Wait();
+
+  auto decoded_counter = SDL_GetPerformanceCounter();
+  timings.decode_millis_ = GetElapsedMillis(enumerated_counter, decoded_counter);
+
+  // Creates the textures on this thread, as a renderer may only be used by the thread that created it.
+  for (size_t i = 0; i < file_paths.size(); i++) {
+    // Handles file being unable to load, releasing the remaining decoded images.
+    if (surfaces[i] == NULL) {
+      for (size_t j = i + 1; j < surfaces.size(); j++) {
+        SDL_FreeSurface(surfaces[j]);
+      }
+
+      throw std::ios_base::failure("Cannot find/access \"" + kAssetPath + file_paths[i] + "\"");
+    }
+
+    if (slot_indices_.find(file_paths[i]) == slot_indices_.end()) {
+      Insert(file_paths[i], {SDL_CreateTextureFromSurface(renderer, surfaces[i]), surfaces[i]->w, surfaces[i]->h, 0});
+      timings.image_count_++;
+    }
+
+    SDL_FreeSurface(surfaces[i]);
+  }
+
+  timings.upload_millis_ = GetElapsedMillis(decoded_counter, SDL_GetPerformanceCounter());
+
+  return timings;
 }
 
 void ResourceManager::set_font(const std::string& font_file_path) {
-  // CLoses the currently active font.
-  TTF_CloseFont(font_);
+  // Switches to a font that has already been opened without reloading it.
+  auto font_iter = fonts_.find(font_file_path);
 
-  font_ = TTF_OpenFont((kAssetPath + font_file_path).c_str(), 19);
+  if (font_iter != fonts_.end()) {
+    font_ = font_iter->second;
+    return;
+  }
+
+  TTF_Font* font = nullptr;
+  const AssetArchive::Entry* entry = archive_ ? archive_->Find(font_file_path) : nullptr;
+
+  // The archived font is read in place from the mapped archive, which outlives the font.
+  if (entry) {
+    font = TTF_OpenFontRW(SDL_RWFromConstMem(entry->data_, static_cast<int>(entry->size_)), 1, 19);
+  } else {
+    font = TTF_OpenFont(GetAssetFilePath(font_file_path).c_str(), 19);
+  }
 
   // Error if font cannot be located.
-  if (!font_) {
+  if (!font) {
     throw std::ios_base::failure("Cannot find/access \"" + kAssetPath + font_file_path + "\"");
   }
+
+  font_ = fonts_.insert({font_file_path, font}).first->second;
 }
 
 TTF_Font* ResourceManager::font() const {
   return font_;
+}
+
+void ResourceManager::set_texture_budget(size_t texture_budget_bytes) {
+  metrics_.texture_budget_bytes_ = texture_budget_bytes;
+}
+
+ResourceManager::Metrics ResourceManager::metrics() const {
+  return metrics_;
 }
\ No newline at end of file
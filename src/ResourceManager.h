@@ -5,18 +5,119 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 #include <string>
+#include <cstdint>
 
 #include "SDL_ttf.h"
 
 struct SDL_Renderer;
 struct SDL_Texture;
+class ThreadPool;
+class AssetArchive;
 
 /// <summary>
 ///  Handles the SDL resources caching and retrieval.
 /// </summary>
 class ResourceManager {
  public:
+  /// <summary>
+  /// A cached texture along with the data needed to draw it, so it never needs to be queried.
+  /// </summary>
+  struct Texture {
+    /// <summary>
+    /// The SDL texture.
+    /// </summary>
+    SDL_Texture* texture_;
+    /// <summary>
+    /// The width of the texture in pixels.
+    /// </summary>
+    int width_;
+    /// <summary>
+    /// The height of the texture in pixels.
+    /// </summary>
+    int height_;
+    /// <summary>
+    /// A unique identifier of the texture's slot in the registry. Used to order textures deterministically.
+    /// </summary>
+    unsigned int id_;
+  };
+  /// <summary>
+  /// Refers to a texture in the registry. A handle becomes stale once its texture is evicted,
+  /// after which resolving it fails rather than returning a different texture that reuses the slot.
+  /// </summary>
+  struct TextureHandle {
+    /// <summary>
+    /// The index of the texture's slot in the registry.
+    /// </summary>
+    std::uint32_t index_;
+    /// <summary>
+    /// The generation of the slot when the handle was issued.
+    /// </summary>
+    std::uint32_t generation_;
+  };
+  /// <summary>
+  /// Usage metrics of the texture registry, which can be queried at any time.
+  /// </summary>
+  struct Metrics {
+    /// <summary>
+    /// The number of textures currently loaded.
+    /// </summary>
+    unsigned int texture_count_;
+    /// <summary>
+    /// The estimated GPU memory used by the loaded textures, in bytes.
+    /// </summary>
+    size_t texture_bytes_;
+    /// <summary>
+    /// The highest value texture_bytes_ has reached.
+    /// </summary>
+    size_t peak_texture_bytes_;
+    /// <summary>
+    /// The GPU memory budget in bytes. Zero if textures are never evicted.
+    /// </summary>
+    size_t texture_budget_bytes_;
+    /// <summary>
+    /// The number of textures created, including textures reloaded after eviction.
+    /// </summary>
+    unsigned long long load_count_;
+    /// <summary>
+    /// The number of textures evicted to stay within the budget.
+    /// </summary>
+    unsigned long long eviction_count_;
+    /// <summary>
+    /// The number of times a stale handle was resolved.
+    /// </summary>
+    unsigned long long stale_handle_count_;
+  };
+  /// <summary>
+  /// A breakdown of the time spent preloading textures.
+  /// </summary>
+  struct PreloadTimings {
+    /// <summary>
+    /// True if the images were read pre-decoded from the asset archive, else they were decoded from the "assets" folder.
+    /// </summary>
+    bool from_archive_;
+    /// <summary>
+    /// The number of images that were preloaded.
+    /// </summary>
+    unsigned int image_count_;
+    /// <summary>
+    /// The number of threads that images were decoded on. Zero when read from the asset archive.
+    /// </summary>
+    unsigned int thread_count_;
+    /// <summary>
+    /// The time taken to find the images in the "assets" folder.
+    /// </summary>
+    double enumerate_millis_;
+    /// <summary>
+    /// The time taken to decode every image.
+    /// </summary>
+    double decode_millis_;
+    /// <summary>
+    /// The time taken to create textures from the decoded images.
+    /// </summary>
+    double upload_millis_;
+  };
   static std::string kAssetPath;
   /// <summary>
   /// Retrieves a singleton instance of the ResourceManager class.
@@ -24,16 +125,70 @@ class ResourceManager {
   /// <returns>A singleton instance of the ResourceManager class.</returns>
   static ResourceManager& Instance(void);
   /// <summary>
-  /// Gets the texture from the cache with the specified file path.
-  /// If the texture is not already present, it is placed into the cache.
-  /// Returns NULL on error.
+  /// Gets the absolute path of an asset, using the separators of the current platform.
+  /// </summary>
+  /// <param name="file_path">The path of the asset, relative to the "assets" folder.</param>
+  /// <returns>The absolute path of the asset.</returns>
+  static std::string GetAssetFilePath(const std::string& file_path);
+  /// <summary>
+  /// Maps the asset archive, if one has been packed into the "assets" folder.
+  /// Assets are then read from the archive instead of being loaded and decoded individually.
+  /// Throws if the archive exists but cannot be read.
+  /// </summary>
+  /// <returns>True if the archive was opened, else assets are loaded from the "assets" folder.</returns>
+  bool OpenArchive(void);
+  /// <summary>
+  /// Reads the contents of an asset file, from the asset archive if it is open.
+  /// Throws if the file cannot be read.
+  /// </summary>
+  /// <param name="file_path">The path of the file, relative to the "assets" folder.</param>
+  /// <returns>The contents of the file.</returns>
+  std::string ReadFile(const std::string& file_path) const;
+  /// <summary>
+  /// Gets a handle to the texture with the specified file path.
+  /// If the texture is not already loaded, it is loaded into the registry.
+  /// Throws if the file cannot be loaded.
+  /// </summary>
+  /// <param name="file_path">The path of the file to retrieve.</param>
+  /// <param name="renderer">Renders the SDL_Surface and SDL_Texture components.</param>
+  /// <returns>A handle to the texture.</returns>
+  TextureHandle Acquire(const std::string& file_path, SDL_Renderer* renderer);
+  /// <summary>
+  /// Gets the texture that a handle refers to, marking it as used in the current frame.
+  /// The returned pointer is valid until the next texture is loaded.
+  /// </summary>
+  /// <param name="handle">The handle to resolve.</param>
+  /// <returns>The texture, or nullptr if the handle is stale.</returns>
+  const Texture* Resolve(TextureHandle handle);
+  /// <summary>
+  /// Gets the texture with the specified file path, loading it if it is not already loaded,
+  /// and marks it as used in the current frame. The returned reference is valid until the next texture is loaded.
+  /// Throws if the file cannot be loaded.
   /// </summary>
   /// <param name="file_path">The path of the file to retrieve.</param>
   /// <param name="renderer">Renders the SDL_Sirface and SDL_Texture components.</param>
-  /// <returns></returns>
-  SDL_Texture* GetTexture(std::string file_path, SDL_Renderer* renderer);
+  /// <returns>The cached texture and its dimensions.</returns>
+  const Texture& GetTexture(const std::string& file_path, SDL_Renderer* renderer);
+  /// <summary>
+  /// Ends the current frame. If the loaded textures exceed the budget, the least recently used textures
+  /// that were not used in this frame are evicted. Must be called once nothing refers to textures drawn
+  /// this frame, i.e. after the frame is presented.
+  /// </summary>
+  void EndFrame(void);
+  /// <summary>
+  /// Loads every image in the "assets" folder into the cache, so no image is loaded mid-frame.
+  /// If the asset archive is open, textures are created directly from its pre-decoded pixels.
+  /// Otherwise, images are decoded in parallel on the thread pool, then textures are created on the calling thread,
+  /// which must be the thread that created the renderer.
+  /// Throws if an image cannot be loaded.
+  /// </summary>
+  /// <param name="renderer">Renders the SDL_Surface and SDL_Texture components.</param>
+  /// <param name="thread_pool">Decodes the images.</param>
+  /// <returns>A breakdown of the time spent preloading.</returns>
+  PreloadTimings Preload(SDL_Renderer* renderer, ThreadPool& thread_pool);
   /// <summary>
   /// Sets the path of the font file to be set as the game's active font.
+  /// Fonts are opened once and kept, so switching back to a font does not reload it.
   /// </summary>
   /// <param name="font_file_path">The path of the font to load into the game.</param>
   void set_font(const std::string& font_file_path);
@@ -42,6 +197,16 @@ class ResourceManager {
   /// </summary>
   /// <returns>The active font.</returns>
   TTF_Font* font(void) const;
+  /// <summary>
+  /// Sets the GPU memory budget. Textures are evicted at the end of a frame while the budget is exceeded.
+  /// </summary>
+  /// <param name="texture_budget_bytes">The budget in bytes, or zero to never evict textures.</param>
+  void set_texture_budget(size_t texture_budget_bytes);
+  /// <summary>
+  /// Gets the usage metrics of the texture registry.
+  /// </summary>
+  /// <returns>The usage metrics.</returns>
+  Metrics metrics(void) const;
 
  private:
   /// <summary>
@@ -63,11 +228,80 @@ class ResourceManager {
   /// </summary>
   static void GenerateAssetPath(void);
   /// <summary>
-  /// Stores the file path (key) with the Texture pointer (value).
+  /// A slot in the texture registry.
+  /// </summary>
+  struct Slot {
+    /// <summary>
+    /// The loaded texture. Null if the slot is free.
+    /// </summary>
+    Texture texture_;
+    /// <summary>
+    /// The path of the texture's file, used to remove it from the path lookup on eviction.
+    /// </summary>
+    std::string file_path_;
+    /// <summary>
+    /// The estimated GPU memory used by the texture, in bytes.
+    /// </summary>
+    size_t byte_size_;
+    /// <summary>
+    /// Incremented each time the slot is freed, which makes existing handles to it stale.
+    /// </summary>
+    std::uint32_t generation_;
+    /// <summary>
+    /// The frame in which the texture was last used.
+    /// </summary>
+    unsigned int last_used_frame_;
+  };
+  /// <summary>
+  /// Loads a texture from the asset archive if it contains it, else from the "assets" folder.
+  /// Throws if the file cannot be loaded.
+  /// </summary>
+  /// <param name="file_path">The path of the file to load.</param>
+  /// <param name="renderer">Renders the SDL_Surface and SDL_Texture components.</param>
+  /// <returns>The texture and its dimensions.</returns>
+  static Texture LoadTexture(const std::string& file_path, SDL_Renderer* renderer);
+  /// <summary>
+  /// Places a loaded texture into a free slot of the registry.
+  /// </summary>
+  /// <param name="file_path">The path of the texture's file.</param>
+  /// <param name="texture">The loaded texture. Its identifier is assigned here.</param>
+  /// <returns>A handle to the texture.</returns>
+  static TextureHandle Insert(const std::string& file_path, Texture texture);
+  /// <summary>
+  /// Destroys the texture in a slot and frees the slot, making existing handles to it stale.
   /// </summary>
-  static std::unordered_map<std::string, SDL_Texture*> textures_;
+  /// <param name="index">The index of the slot.</param>
+  static void Evict(std::uint32_t index);
+  /// <summary>
+  /// The slots of the texture registry, indexed by handle.
+  /// </summary>
+  static std::vector<Slot> slots_;
+  /// <summary>
+  /// The indices of free slots, reused before the registry grows.
+  /// </summary>
+  static std::vector<std::uint32_t> free_slots_;
+  /// <summary>
+  /// Stores the file path (key) with the index of its slot (value).
+  /// </summary>
+  static std::unordered_map<std::string, std::uint32_t> slot_indices_;
+  /// <summary>
+  /// Stores the font file path (key) with the opened font (value).
+  /// </summary>
+  static std::unordered_map<std::string, TTF_Font*> fonts_;
   /// <summary>
   /// Stores the font that is to be applied to in-game text.
   /// </summary>
   static TTF_Font* font_;
+  /// <summary>
+  /// The usage metrics of the texture registry.
+  /// </summary>
+  static Metrics metrics_;
+  /// <summary>
+  /// The number of frames that have ended, used to determine which textures were least recently used.
+  /// </summary>
+  static unsigned int frame_;
+  /// <summary>
+  /// The mapped asset archive, or nullptr if assets are loaded from the "assets" folder.
+  /// </summary>
+  static AssetArchive* archive_;
 };
\ No newline at end of file
@@ -0,0 +1,87 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "ThreadPool.h"
+
+#include <functional>
+#include <thread>
+#include <mutex>
+
+ThreadPool::ThreadPool(unsigned int thread_count)
+    : unfinished_task_count_(0),
+      stopping_(false) {
+  if (thread_count == 0) {
+    thread_count = std::thread::hardware_concurrency();
+  }
+
+  // hardware_concurrency may return zero if the value cannot be determined.
+  if (thread_count == 0) {
+    thread_count = 1;
+  }
+
+  for (unsigned int i = 0; i < thread_count; i++) {
+    workers_.emplace_back(&ThreadPool::Run, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+
+  task_queued_.notify_all();
+
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Submit(std::function<void(void)> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+    unfinished_task_count_++;
+  }
+
+  task_queued_.notify_one();
+}
+
+void ThreadPool::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  tasks_finished_.wait(lock, [this] { return unfinished_task_count_ == 0; });
+}
+
+unsigned int ThreadPool::thread_count() const {
+  return static_cast<unsigned int>(workers_.size());
+}
+
+void ThreadPool::Run() {
+  while (true) {
+    std::function<void(void)> task;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_queued_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+
+      // Remaining tasks are finished before the worker stops.
+      if (tasks_.empty()) {
+        return;
+      }
+
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    task();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if (--unfinished_task_count_ == 0) {
+        tasks_finished_.notify_all();
+      }
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/// <summary>
+/// A fixed set of worker threads that run submitted tasks.
+/// </summary>
+class ThreadPool {
+ public:
+  /// <summary>
+  /// Constructor for the ThreadPool class.
+  /// </summary>
+  /// <param name="thread_count">The number of worker threads. If zero, one thread is created
+  /// for each hardware thread.</param>
+  ThreadPool(unsigned int thread_count = 0);
+  /// <summary>
+  /// Destructor for the ThreadPool class.
+  /// Finishes all submitted tasks before the workers are joined.
+  /// </summary>
+  ~ThreadPool(void);
+  /// <summary>
+  /// Queues a task to be run on a worker thread.
+  /// </summary>
+  /// <param name="task">The task to run.</param>
+  void Submit(std::function<void(void)> task);
+  /// <summary>
+  /// Blocks until every submitted task has finished.
+  /// </summary>
+  void Wait(void);
+  /// <summary>
+  /// Gets the number of worker threads.
+  /// </summary>
+  /// <returns>The number of worker threads.</returns>
+  unsigned int thread_count(void) const;
+
+ private:
+  /// <summary>
+  /// Copy constructor for the ThreadPool class.
+  /// </summary>
+  /// <param name="reference">The ThreadPool reference to copy.</param>
+  ThreadPool(ThreadPool const& reference);
+  /// <summary>
+  /// The body of each worker thread. Runs tasks until the pool is destroyed.
+  /// </summary>
+  void Run(void);
+  /// <summary>
+  /// Tasks waiting for a worker, in submission order.
+  /// </summary>
+  std::deque<std::function<void(void)>> tasks_;
+  /// <summary>
+  /// The number of tasks that have been submitted but have not yet finished.
+  /// </summary>
+  unsigned int unfinished_task_count_;
+  /// <summary>
+  /// Set when the workers should stop once the queue is empty.
+  /// </summary>
+  bool stopping_;
+  /// <summary>
+  /// Guards the task queue, the unfinished task count and the stopping flag.
+  /// </summary>
+  std::mutex mutex_;
+  /// <summary>
+  /// Signals the workers that a task has been queued or that the pool is stopping.
+  /// </summary>
+  std::condition_variable task_queued_;
+  /// <summary>
+  /// Signals waiting threads that every submitted task has finished.
+  /// </summary>
+  std::condition_variable tasks_finished_;
+  /// <summary>
+  /// The worker threads.
+  /// </summary>
+  std::vector<std::thread> workers_;
+};
\ No newline at end of file
@@ -0,0 +1,18 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+/// <summary>
+/// The type of each coordinate of a tile position in map space. Every tile position in the game is a
+/// Vector2 of this type, so this is the one place that bounds the size of a map. Stepping off the top or
+/// left edge of a map wraps around to the largest coordinate, so a map may be at most kMaxMapDimension
+/// tiles along each axis, which keeps that coordinate outside of it.
+/// </summary>
+typedef unsigned short TileCoordinate;
+
+/// <summary>
+/// The greatest number of tiles along either axis of a map.
+/// </summary>
+const unsigned int kMaxMapDimension = static_cast<TileCoordinate>(-1);
\ No newline at end of file
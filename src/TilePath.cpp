@@ -0,0 +1,121 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "TilePath.h"
+
+#include <array>
+#include <algorithm>
+#include <cstring>
+
+#include "LevelArena.h"
+#include "World.h"
+
+namespace {
+  /// <summary>
+  /// Gets the 2-bit code of a direction, which is its index in World::kStepDirections.
+  /// </summary>
+  /// <param name="direction">The direction: up, down, left or right.</param>
+  /// <returns>The code of the direction.</returns>
+  unsigned char EncodeStep(Vector2<char> direction) {
+    unsigned char code = 0;
+
+    while (code + 1u < World::kStepDirections.size() && World::kStepDirections[code] != direction) {
+      code++;
+    }
+
+    return code;
+  }
+}
+
+TilePath::TilePath()
+    : steps_(nullptr),
+      capacity_(0),
+      front_(0),
+      back_(0),
+      front_tile_(Vector2<TileCoordinate>::zero) {}
+
+void TilePath::Reserve(LevelArena& arena, unsigned int max_step_count) {
+  const size_t byte_count = (max_step_count + kStepsPerByte - 1) / kStepsPerByte;
+
+  steps_ = static_cast<unsigned char*>(arena.Allocate(byte_count, 1));
+  std::memset(steps_, 0, byte_count);
+  capacity_ = max_step_count;
+  front_ = back_ = 0;
+}
+
+void TilePath::Reset(Vector2<TileCoordinate> start_tile) {
+  front_ = back_ = 0;
+  front_tile_ = start_tile;
+}
+
+void TilePath::PushBack(Vector2<char> direction) {
+  if (back_ >= capacity_) {
+    return;
+  }
+
+  const unsigned int shift = (back_ % kStepsPerByte) * 2;
+  unsigned char& byte = steps_[back_ / kStepsPerByte];
+
+  byte = static_cast<unsigned char>((byte & ~(3 << shift)) | (EncodeStep(direction) << shift));
+  back_++;
+}
+
+void TilePath::AppendSteps(const unsigned char* packed_steps, unsigned int step_count) {
+  step_count = std::min(step_count, capacity_ - back_);
+
+  // Steps that start on a byte boundary are copied a byte at a time.
+  if (back_ % kStepsPerByte == 0) {
+    std::memcpy(steps_ + back_ / kStepsPerByte, packed_steps, (step_count + kStepsPerByte - 1) / kStepsPerByte);
+    back_ += step_count;
+    return;
+  }
+
+  for (unsigned int i = 0; i < step_count; i++) {
+    const unsigned char code = (packed_steps[i / kStepsPerByte] >> ((i % kStepsPerByte) * 2)) & 3;
+
+    PushBack(World::kStepDirections[code]);
+  }
+}
+
+void TilePath::CopySteps(unsigned int first_step, unsigned int step_count, unsigned char* packed_steps) const {
+  const unsigned int begin = front_ + first_step;
+  const unsigned int byte_count = (step_count + kStepsPerByte - 1) / kStepsPerByte;
+
+  if (begin % kStepsPerByte == 0) {
+    std::memcpy(packed_steps, steps_ + begin / kStepsPerByte, byte_count);
+    return;
+  }
+
+  std::memset(packed_steps, 0, byte_count);
+
+  for (unsigned int i = 0; i < step_count; i++) {
+    const unsigned char code = (steps_[(begin + i) / kStepsPerByte] >> (((begin + i) % kStepsPerByte) * 2)) & 3;
+
+    packed_steps[i / kStepsPerByte] |= static_cast<unsigned char>(code << ((i % kStepsPerByte) * 2));
+  }
+}
+
+Vector2<TileCoordinate> TilePath::PopFront(const World& world) {
+  const unsigned int shift = (front_ % kStepsPerByte) * 2;
+  const unsigned char code = (steps_[front_ / kStepsPerByte] >> shift) & 3;
+  const Vector2<TileCoordinate> neighbour = World::GetTileInDirection(front_tile_, World::kStepDirections[code]);
+
+  front_++;
+  // The entity moves onto the neighbour, and is carried past the portal's exit if it is an entrance.
+  front_tile_ = world.GetStepDestination(front_tile_, World::kStepDirections[code]);
+
+  return neighbour;
+}
+
+bool TilePath::empty() const {
+  return front_ == back_;
+}
+
+unsigned int TilePath::size() const {
+  return back_ - front_;
+}
+
+unsigned int TilePath::capacity() const {
+  return capacity_;
+}
\ No newline at end of file
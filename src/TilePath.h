@@ -0,0 +1,103 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include "Vector2.h"
+#include "TileCoordinate.h"
+
+class LevelArena;
+class World;
+
+/// <summary>
+/// A path across the map, stored as the direction of each step at 2 bits per step.
+/// The storage is reserved once in the level arena, so setting and following paths never allocates. It is
+/// sized for the longest path in the map, or for fewer steps where a path may be cut short and continued
+/// later, as Ghosts' paths are. Steps are read in order from the front.
+/// </summary>
+class TilePath {
+ public:
+  /// <summary>
+  /// Constructor for the TilePath class. The path has no capacity until Reserve is called.
+  /// </summary>
+  TilePath(void);
+  /// <summary>
+  /// Reserves storage for a number of steps in the level arena. The storage lives until the arena is released.
+  /// </summary>
+  /// <param name="arena">The arena that the storage is reserved in.</param>
+  /// <param name="max_step_count">The greatest number of steps in a path.</param>
+  void Reserve(LevelArena& arena, unsigned int max_step_count);
+  /// <summary>
+  /// Removes every step and starts a new path.
+  /// </summary>
+  /// <param name="start_tile">The tile that the path starts from, which is not a step of the path.</param>
+  void Reset(Vector2<TileCoordinate> start_tile);
+  /// <summary>
+  /// Adds a step to the end of the path. Steps beyond the capacity are ignored.
+  /// </summary>
+  /// <param name="direction">The direction of the step: up, down, left or right.</param>
+  void PushBack(Vector2<char> direction);
+  /// <summary>
+  /// Adds steps to the end of the path, packed at 2 bits per step as the path stores them. Steps beyond the
+  /// capacity are ignored.
+  /// </summary>
+  /// <param name="packed_steps">The packed steps, starting from the low bits of the first byte.</param>
+  /// <param name="step_count">The number of steps to add.</param>
+  void AppendSteps(const unsigned char* packed_steps, unsigned int step_count);
+  /// <summary>
+  /// Copies remaining steps of the path into a buffer, packed at 2 bits per step as the path stores them.
+  /// </summary>
+  /// <param name="first_step">The number of remaining steps to skip before the first step copied.</param>
+  /// <param name="step_count">The number of steps to copy, which must not run past the end of the path.</param>
+  /// <param name="packed_steps">The buffer, which must hold at least step_count / 4 bytes, rounded up.</param>
+  void CopySteps(unsigned int first_step, unsigned int step_count, unsigned char* packed_steps) const;
+  /// <summary>
+  /// Removes the first step of the path. The path must not be empty.
+  /// </summary>
+  /// <param name="world">The World whose portals the path passes through.</param>
+  /// <returns>The neighbouring tile that the step leads to, which is a portal's entrance if the step
+  /// passes through it.</returns>
+  Vector2<TileCoordinate> PopFront(const World& world);
+  /// <summary>
+  /// Gets whether every step has been taken.
+  /// </summary>
+  /// <returns>True if the path has no remaining steps, else false.</returns>
+  bool empty(void) const;
+  /// <summary>
+  /// Gets the number of remaining steps.
+  /// </summary>
+  /// <returns>The number of remaining steps.</returns>
+  unsigned int size(void) const;
+  /// <summary>
+  /// Gets the greatest number of steps that the path can hold.
+  /// </summary>
+  /// <returns>The capacity in steps.</returns>
+  unsigned int capacity(void) const;
+
+ private:
+  /// <summary>
+  /// The number of steps packed into each byte.
+  /// </summary>
+  static const unsigned int kStepsPerByte = 4;
+  /// <summary>
+  /// The packed steps. Step i occupies bits 2 * (i % 4) and up of byte i / 4.
+  /// </summary>
+  unsigned char* steps_;
+  /// <summary>
+  /// The greatest number of steps that the path can hold.
+  /// </summary>
+  unsigned int capacity_;
+  /// <summary>
+  /// The index of the first remaining step.
+  /// </summary>
+  unsigned int front_;
+  /// <summary>
+  /// The index after the last step.
+  /// </summary>
+  unsigned int back_;
+  /// <summary>
+  /// The tile that the first remaining step starts from.
+  /// </summary>
+  Vector2<TileCoordinate> front_tile_;
+};
\ No newline at end of file
@@ -0,0 +1,108 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#include "TraceWriter.h"
+
+#include <string>
+#include <vector>
+#include <ios>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+
+#include "SDL.h"
+
+// Wakes the writer for every few frames' worth of events, rather than for each event.
+const size_t TraceWriter::kBatchSize = 1024;
+
+TraceWriter::TraceWriter(const std::string& file_path)
+    : file_(file_path, std::ios::binary),
+      start_counter_(SDL_GetPerformanceCounter()),
+      micros_per_tick_(1000000.0 / SDL_GetPerformanceFrequency()),
+      closing_(false) {
+  // Handle file not accessible error.
+  if (file_.fail()) {
+    throw std::ios_base::failure("Cannot create \"" + file_path + "\"");
+  }
+
+  file_.setf(std::ios::fixed);
+  file_.precision(3);
+
+  // Names the thread that created the writer, which is the game loop's thread. Every event follows it, preceded by a comma.
+  file_ << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << SDL_ThreadID()
+        << ",\"args\":{\"name\":\"Game loop\"}}";
+
+  queued_events_.reserve(kBatchSize);
+  thread_ = std::thread(&TraceWriter::Run, this);
+}
+
+TraceWriter::~TraceWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closing_ = true;
+  }
+
+  events_queued_.notify_one();
+  thread_.join();
+
+  file_ << "\n]}\n";
+}
+
+void TraceWriter::Submit(const char* name, const char* category, std::uint64_t start_counter,
+                         std::uint64_t end_counter, unsigned long thread_id) {
+  bool batch_ready;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queued_events_.push_back({name, category, start_counter, end_counter, thread_id});
+    batch_ready = queued_events_.size() == kBatchSize;
+  }
+
+  if (batch_ready) {
+    events_queued_.notify_one();
+  }
+}
+
+void TraceWriter::Run() {
+  std::vector<Event> events;
+  events.reserve(kBatchSize);
+
+  while (true) {
+    bool closing;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+
+      // Also wakes periodically, so a trace of a slow session is written as it runs.
+      events_queued_.wait_for(lock, std::chrono::milliseconds(250), [this] {
+        return closing_ || queued_events_.size() >= kBatchSize;
+      });
+
+      // Swaps buffers, so the game keeps queuing into the capacity left by the previous batch.
+      events.swap(queued_events_);
+      closing = closing_;
+    }
+
+    WriteEvents(events);
+    events.clear();
+
+    // All queued events are written before the writer stops.
+    if (closing) {
+      return;
+    }
+  }
+}
+
+void TraceWriter::WriteEvents(const std::vector<Event>& events) {
+  // Writes complete events, with times in microseconds relative to the start of the trace.
+  for (auto& event : events) {
+    file_ << ",\n{\"name\":\"" << event.name_ << "\",\"cat\":\"" << event.category_ << "\",\"ph\":\"X\",\"ts\":"
+          << static_cast<std::int64_t>(event.start_counter_ - start_counter_) * micros_per_tick_ << ",\"dur\":"
+          << (event.end_counter_ - event.start_counter_) * micros_per_tick_ << ",\"pid\":1,\"tid\":"
+          << event.thread_id_ << "}";
+  }
+
+  file_.flush();
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+/// <author>
+/// Joshua Bradley
+/// </author>
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+/// <summary>
+/// Writes timed events to a file in the Chrome trace event format, which can be opened in
+/// chrome://tracing or the Perfetto UI. Events are formatted and written on a background thread,
+/// so submitting an event only appends it to a buffer.
+/// </summary>
+class TraceWriter {
+ public:
+  /// <summary>
+  /// Constructor for the TraceWriter class. Creates the file and starts the writer thread.
+  /// Throws if the file cannot be created.
+  /// </summary>
+  /// <param name="file_path">The path of the trace file to create.</param>
+  TraceWriter(const std::string& file_path);
+  /// <summary>
+  /// Destructor for the TraceWriter class.
+  /// Writes every submitted event and completes the file before the writer thread is joined.
+  /// No thread may submit events once destruction has begun.
+  /// </summary>
+  ~TraceWriter(void);
+  /// <summary>
+  /// Queues a completed event to be written. Safe to call from any thread.
+  /// </summary>
+  /// <param name="name">The name of the event. Must remain valid until the writer is destroyed.</param>
+  /// <param name="category">The category of the event. Must remain valid until the writer is destroyed.</param>
+  /// <param name="start_counter">The performance counter value when the event began.</param>
+  /// <param name="end_counter">The performance counter value when the event ended.</param>
+  /// <param name="thread_id">The SDL thread ID of the thread that the event occurred on.</param>
+  void Submit(const char* name, const char* category, std::uint64_t start_counter, std::uint64_t end_counter,
+              unsigned long thread_id);
+
+ private:
+  /// <summary>
+  /// Copy constructor for the TraceWriter class.
+  /// </summary>
+  /// <param name="reference">The TraceWriter reference to copy.</param>
+  TraceWriter(TraceWriter const& reference);
+  /// <summary>
+  /// A completed event waiting to be written.
+  /// </summary>
+  struct Event {
+    /// <summary>
+    /// The name of the event.
+    /// </summary>
+    const char* name_;
+    /// <summary>
+    /// The category of the event.
+    /// </summary>
+    const char* category_;
+    /// <summary>
+    /// The performance counter value when the event began.
+    /// </summary>
+    std::uint64_t start_counter_;
+    /// <summary>
+    /// The performance counter value when the event ended.
+    /// </summary>
+    std::uint64_t end_counter_;
+    /// <summary>
+    /// The SDL thread ID of the thread that the event occurred on.
+    /// </summary>
+    unsigned long thread_id_;
+  };
+  /// <summary>
+  /// The body of the writer thread. Writes batches of events until the writer is destroyed.
+  /// </summary>
+  void Run(void);
+  /// <summary>
+  /// Formats and writes a batch of events.
+  /// </summary>
+  /// <param name="events">The events to write.</param>
+  void WriteEvents(const std::vector<Event>& events);
+  /// <summary>
+  /// The number of queued events that wakes the writer thread before its periodic flush.
+  /// </summary>
+  static const size_t kBatchSize;
+  /// <summary>
+  /// The trace file.
+  /// </summary>
+  std::ofstream file_;
+  /// <summary>
+  /// The performance counter value when tracing began. Event times are relative to it.
+  /// </summary>
+  const std::uint64_t start_counter_;
+  /// <summary>
+  /// The number of microseconds in a performance counter tick.
+  /// </summary>
+  const double micros_per_tick_;
+  /// <summary>
+  /// Events waiting to be written.
+  /// </summary>
+  std::vector<Event> queued_events_;
+  /// <summary>
+  /// Guards the queued events and the closing flag.
+  /// </summary>
+  std::mutex mutex_;
+  /// <summary>
+  /// Signals the writer thread that a batch of events has been queued or that the writer is closing.
+  /// </summary>
+  std::condition_variable events_queued_;
+  /// <summary>
+  /// Set when the writer thread should stop once the queue is empty.
+  /// </summary>
+  bool closing_;
+  /// <summary>
+  /// The thread that formats and writes events.
+  /// </summary>
+  std::thread thread_;
+};
\ No newline at end of file
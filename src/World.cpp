@@ -4,236 +4,701 @@
 
 #include "World.h"
 
-#include <fstream>
 #include <sstream>
-#include <list>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
 
 #include "ResourceManager.h"
-#include "RedGhost.h"
-#include "Ghost.h"
+#include "Ghosts.h"
 #include "Tile.h"
-#include "Dot.h"
-#include "PowerPellet.h"
 #include "Vector2.h"
 #include "Drawer.h"
-#include "StaticGameEntity.h"
-#include "GameEntity.h"
+#include "PacMan.h"
+#include "Profiler.h"
+#include "LevelArena.h"
+#include "TilePath.h"
+#include "DistanceGrid.h"
+
+namespace {
+	/// <summary>
+	/// The bits of a tile's cell that hold its block type.
+	/// </summary>
+	const unsigned char kBlockTypeBits = 3;
+	/// <summary>
+	/// The block type bits of a cell where the map has no tile.
+	/// </summary>
+	const unsigned char kNoTile = 3;
+	/// <summary>
+	/// The shift of the bits of a cell above the block type bits, which hold the index plus one of the portal
+	/// whose entrance is on the tile, or zero if there is none.
+	/// </summary>
+	const unsigned int kPortalShift = 2;
+	/// <summary>
+	/// The flag of a tile with a Dot lying on it, in its chunk's items.
+	/// </summary>
+	const unsigned char kDotFlag = 1;
+	/// <summary>
+	/// The flag of a tile with a PowerPellet lying on it, in its chunk's items.
+	/// </summary>
+	const unsigned char kPowerPelletFlag = 2;
+	/// <summary>
+	/// The path of the image drawn for each Dot.
+	/// </summary>
+	const std::string kDotImageFilePath = "Misc\\Dot.png";
+	/// <summary>
+	/// The path of the image drawn for each PowerPellet.
+	/// </summary>
+	const std::string kPowerPelletImageFilePath = "Misc\\Power-Pellet.png";
+	/// <summary>
+	/// The colour of the walls drawn for a structure that has no map image.
+	/// </summary>
+	const SDL_Color kWallColour {33, 33, 222, 255};
+	/// <summary>
+	/// The colour of the Ghost doors drawn for a structure that has no map image.
+	/// </summary>
+	const SDL_Color kGhostDoorColour {252, 181, 255, 255};
+	/// <summary>
+	/// The height in pixels of the Ghost doors drawn for a structure that has no map image.
+	/// </summary>
+	const int kGhostDoorHeight = 4;
+	/// <summary>
+	/// The distance in pixels within which the Avatar collects an item.
+	/// </summary>
+	const float kItemCollectionDistance = 5.f;
+	/// <summary>
+	/// The most blocking tile type that the hierarchical pathfinder moves onto, which the paths of GetPath
+	/// are cached under.
+	/// </summary>
+	const enum Tile::block_type kPathBlockType = Tile::block_type::partial_block;
+}
+
+// Spelled out rather than copied from Vector2's direction constants, which may be initialised after this table.
+const std::array<Vector2<char>, 4> World::kStepDirections {
+	Vector2<char>(0, -1), Vector2<char>(0, 1), Vector2<char>(-1, 0), Vector2<char>(1, 0)
+};
 
 World::World()
 	: map_structure_file_path_("Map\\Structure.txt"),
-	  map_image_file_path_("Map\\Map.png") {}
-
-void World::Init() {
+	  map_image_file_path_("Map\\Map.png"),
+	  chunk_columns_(0),
+	  visit_stamp_(0),
+	  open_tile_count_(0),
+	  map_width_(0),
+	  map_height_(0),
+	  dot_count_(0),
+	  power_pellet_count_(0),
+	  power_pellet_blink_timer_(100, true),
+	  power_pellets_visible_(true) {}
+
+void World::Init(LevelArena& arena) {
 	std::string line;
-	std::ifstream map_file(ResourceManager::kAssetPath + map_structure_file_path_);
+	// Reads the map from the asset archive if it is open, else from the "assets" folder.
+	// A structure that was set, such as a generated maze, is read in place of the file.
+	std::istringstream map_file(map_structure_.empty() ? ResourceManager::Instance().ReadFile(map_structure_file_path_)
+		: map_structure_);
+
+	// The chunks of any previous level were released with the arena. The capacity is kept for reloading.
+	open_tile_count_ = 0;
+	dot_count_ = 0;
+	power_pellet_count_ = 0;
+	map_width_ = 0;
+	map_height_ = 0;
+
+	// Destinations are class-level, so those of any previously loaded map are removed.
+	Ghosts::ClearPathDestinations();
+
+	// The portals marked by their numbers and letters, which are paired once every tile has been read.
+	std::array<Portal, kMaxPortalCount> marked_portals;
+	unsigned int marked_entrances = 0;
+	unsigned int marked_exits = 0;
+
+	// Measures the map first, so the chunks can be laid out before any tile is created.
+	while (!map_file.eof()) {
+		std::getline(map_file, line);
+
+		// The map is read as binary, so Windows line endings are removed here.
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+
+		map_width_ = std::max(map_width_, static_cast<unsigned int>(line.length()));
+		map_height_++;
+	}
 
-	// Handle file not accessible error.
-	if (map_file.fail()) {
-		throw std::ios_base::failure("Cannot find/access \"" + ResourceManager::kAssetPath + map_structure_file_path_ + "\"");
-	} else if (map_file.is_open()) {
-		unsigned char line_index = 0;
+	if (map_width_ > kMaxMapDimension || map_height_ > kMaxMapDimension) {
+		throw std::runtime_error("The map is larger than " + std::to_string(kMaxMapDimension) + " tiles along an axis");
+	}
 
-		while (!map_file.eof()) {
-			std::getline(map_file, line);
+	chunk_columns_ = (map_width_ + kChunkSize - 1) / kChunkSize;
+	chunks_.assign(chunk_columns_ * ((map_height_ + kChunkSize - 1) / kChunkSize), nullptr);
 
-			for (unsigned char i = 0; i < line.length(); i++) {
-				// Create tiles - signalling whether a tile acts as a wall.
-				Tile* tile;
+	map_file.clear();
+	map_file.seekg(0);
 
-				switch (line[i]) {
-					case 'x': {
-						tile = new Tile({i, line_index}, Tile::block_type::block);
-						break;
-					}
-					case '-': {
-						tile = new Tile({i, line_index}, Tile::block_type::partial_block);
-						break;
-					}
-					default: {
-						tile = new Tile({i, line_index}, Tile::block_type::no_block);
-					}
+	for (unsigned int line_index = 0; line_index < map_height_; line_index++) {
+		std::getline(map_file, line);
+
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+
+		for (unsigned int i = 0; i < line.length(); i++) {
+			const Vector2<TileCoordinate> position(i, line_index);
+			Chunk*& chunk = chunks_[(line_index / kChunkSize) * chunk_columns_ + i / kChunkSize];
+
+			// Creates the chunk with its first tile, with no tiles where the map has none.
+			if (!chunk) {
+				chunk = arena.Create<Chunk>();
+				std::memset(chunk->cells_, kNoTile, sizeof(chunk->cells_));
+				std::memset(chunk->items_, 0, sizeof(chunk->items_));
+			}
+
+			// Create tiles - signalling whether a tile acts as a wall.
+			unsigned char& cell = chunk->cells_[GetCellIndex(position)];
+			unsigned char& items = chunk->items_[GetCellIndex(position)];
+
+			switch (line[i]) {
+				case 'x': {
+					cell = static_cast<unsigned char>(Tile::block_type::block);
+					break;
+				}
+				case '-': {
+					cell = static_cast<unsigned char>(Tile::block_type::partial_block);
+					break;
 				}
+				default: {
+					cell = static_cast<unsigned char>(Tile::block_type::no_block);
+				}
+			}
 
-				switch (line[i]) {
-					// Initialise Dot.
-					case '.': {
-						auto dot = new Dot(Vector2<float>(i, line_index));
-						dots_.push_back(dot);
-						break;
-					}
-					// Initialise Power Pellet.
-					case 'o': {
-						auto power_pellet = new PowerPellet(Vector2<float>(i, line_index));
-						power_pellets_.push_back(power_pellet);
-						break;
-					}
-					// Initialise Ghost home tile.
-					case 'H': {
-						Ghost::set_home_tile(Vector2<unsigned char>(i, line_index));
-						break;
-					}
-					case 'R': {
-						RedGhost::AddPathDestination(Vector2<unsigned char>(i, line_index));
-					}
-					case 'P': {
-						Ghost::AddPathDestination(Vector2<unsigned char>(i, line_index));
-						break;
-					}
+			switch (line[i]) {
+				// Initialise Dot.
+				case '.': {
+					items |= kDotFlag;
+					dot_count_++;
+					break;
+				}
+				// Initialise Power Pellet.
+				case 'o': {
+					items |= kPowerPelletFlag;
+					power_pellet_count_++;
+					break;
+				}
+				// Initialise Ghost home tile.
+				case 'H': {
+					Ghosts::set_home_tile(position);
+					break;
+				}
+				case 'R': {
+					Ghosts::AddRedPathDestination(position);
+				}
+				case 'P': {
+					Ghosts::AddPathDestination(position);
+					break;
+				}
+			}
+
+			// Portals are numbered from 1, and the exit of each is marked by the letter at the same place in the alphabet.
+			const bool portal_entrance = line[i] >= '1' && line[i] < '1' + static_cast<int>(kMaxPortalCount);
+			const bool portal_exit = line[i] >= 'A' && line[i] < 'A' + static_cast<int>(kMaxPortalCount);
+
+			if (portal_entrance || portal_exit) {
+				const unsigned int portal = line[i] - (portal_entrance ? '1' : 'A');
+				unsigned int& marks = portal_entrance ? marked_entrances : marked_exits;
+
+				if (marks & (1 << portal)) {
+					throw std::runtime_error("Portal " + std::to_string(portal + 1) + " is marked more than once");
 				}
 
-				tiles_.push_back(tile);
+				marks |= 1 << portal;
+				(portal_entrance ? marked_portals[portal].entrance_ : marked_portals[portal].exit_) = position;
 			}
 
-			line_index++;
+			if ((cell & kBlockTypeBits) != static_cast<unsigned char>(Tile::block_type::block)) {
+				open_tile_count_++;
+			}
 		}
-		map_file.close();
 	}
-}
 
-void World::Draw(const Drawer* drawer, unsigned int elapsed_millis) {
-	drawer->Draw(map_image_file_path_, Vector2<float>::zero);
+	// Marks the cell of each portal's entrance with its index, so a step onto it is found in a single lookup.
+	portals_.clear();
+
+	for (unsigned int portal = 0; portal < kMaxPortalCount; portal++) {
+		if (!(marked_entrances & (1 << portal))) {
+			continue;
+		}
+
+		if (!(marked_exits & (1 << portal))) {
+			throw std::runtime_error("Portal " + std::to_string(portal + 1) + " has no exit");
+		}
+
+		const Vector2<TileCoordinate> entrance = marked_portals[portal].entrance_;
 
-	for (auto dot : dots_) {
-		dot->Draw(drawer);
+		portals_.push_back(marked_portals[portal]);
+		GetChunk(entrance)->cells_[GetCellIndex(entrance)] |= static_cast<unsigned char>(portals_.size() << kPortalShift);
 	}
 
-	PowerPellet::Draw(drawer, elapsed_millis, power_pellets_);
+	// A path never visits a tile twice, so the search never grows the buffer beyond this.
+	path_frames_.reserve(open_tile_count_ + 1);
+
+	GenerateExitMasks();
+	pathfinder_.Build(*this);
+	distance_fields_.Build(*this);
+	path_cache_.Reserve(arena);
+}
+
+void World::set_map_structure(const std::string& map_structure) {
+	map_structure_ = map_structure;
 }
 
-bool World::CheckTileValidity(Vector2<unsigned char> potential_tile, enum Tile::block_type max_valid_block_type) const {
-	for (auto tile : tiles_) {
-		if (potential_tile == tile->position() && tile->block_type() <= max_valid_block_type) {
-			return true;
+void World::GenerateExitMasks() {
+	for (unsigned int chunk_index = 0; chunk_index < chunks_.size(); chunk_index++) {
+		Chunk* chunk = chunks_[chunk_index];
+
+		if (!chunk) {
+			continue;
+		}
+
+		const unsigned int first_x = (chunk_index % chunk_columns_) * kChunkSize;
+		const unsigned int first_y = (chunk_index / chunk_columns_) * kChunkSize;
+		const unsigned int last_x = std::min(first_x + kChunkSize, map_width_);
+		const unsigned int last_y = std::min(first_y + kChunkSize, map_height_);
+
+		for (unsigned int y = first_y; y < last_y; y++) {
+			for (unsigned int x = first_x; x < last_x; x++) {
+				UpdateExitMask(Vector2<TileCoordinate>(x, y));
+			}
 		}
 	}
+}
 
-	return false;
+void World::UpdateExitMask(Vector2<TileCoordinate> tile_position) {
+	Chunk* chunk = GetChunk(tile_position);
+
+	if (!chunk) {
+		return;
+	}
+
+	unsigned char& mask = chunk->exit_masks_[GetCellIndex(tile_position)];
+	mask = 0;
+
+	for (auto direction : {Vector2<char>::up, Vector2<char>::down, Vector2<char>::left, Vector2<char>::right}) {
+		// Tiles beyond the edges of the map wrap around to large coordinates, which have no tile.
+		const unsigned char block_type = GetCell(GetStepDestination(tile_position, direction)) & kBlockTypeBits;
+
+		// The low four bits hold exits that Ghost doors block, the high four bits exits that they do not.
+		if (block_type == static_cast<unsigned char>(Tile::block_type::no_block)) {
+			mask |= GetDirectionBit(direction);
+		}
+
+		if (block_type < static_cast<unsigned char>(Tile::block_type::block)) {
+			mask |= GetDirectionBit(direction) << 4;
+		}
+	}
 }
 
-bool World::CheckDotIntersection(Vector2<float> position) {
-	for (auto dot : dots_) {
-		if ((dot->position() - position).GetLength() < 5.f) {
-			dots_.remove(dot);
-			delete dot;
-			return true;
+void World::SetBlockType(Vector2<TileCoordinate> tile_position, enum Tile::block_type block_type) {
+	Chunk* chunk = GetChunk(tile_position);
+
+	if (!chunk) {
+		return;
+	}
+
+	unsigned char& cell = chunk->cells_[GetCellIndex(tile_position)];
+	const unsigned char previous_block_type = cell & kBlockTypeBits;
+
+	if (previous_block_type == kNoTile || previous_block_type == static_cast<unsigned char>(block_type)) {
+		return;
+	}
+
+	// Walls are the only tiles that paths do not count.
+	if (previous_block_type == static_cast<unsigned char>(Tile::block_type::block)) {
+		open_tile_count_++;
+	} else if (block_type == Tile::block_type::block) {
+		open_tile_count_--;
+	}
+
+	cell = static_cast<unsigned char>((cell & ~kBlockTypeBits) | static_cast<unsigned char>(block_type));
+
+	// The tile's own exits are unchanged, but those of its neighbours onto it are not, nor those of the tiles
+	// that step onto it through a portal.
+	for (auto direction : {Vector2<char>::up, Vector2<char>::down, Vector2<char>::left, Vector2<char>::right}) {
+		UpdateExitMask(GetTileInDirection(tile_position, direction));
+
+		for (const Portal& portal : portals_) {
+			if (GetTileInDirection(portal.exit_, direction) == tile_position) {
+				UpdateExitMask(GetTileInDirection(portal.entrance_, Vector2<char>(-direction.x_, -direction.y_)));
+			}
 		}
 	}
 
-	return false;
+	pathfinder_.UpdateTile(tile_position);
+	distance_fields_.UpdateTile(tile_position);
+	path_cache_.Clear();
 }
 
-bool World::CheckPowerPelletIntersection(Vector2<float> position) {
-	for (auto power_pellet : power_pellets_) {
-		if ((power_pellet->position() - position).GetLength() < 5.f) {
-			power_pellets_.remove(power_pellet);
-			delete power_pellet;
-			return true;
+void World::Draw(const Drawer* drawer, unsigned int elapsed_millis) {
+	extern const unsigned char kXOffset;
+	extern const unsigned char kYOffset;
+	extern const unsigned short kWindowWidth;
+	extern const unsigned short kWindowHeight;
+
+	// The map image only matches the structure file, so the walls of any other structure are drawn in view below.
+	const bool draw_walls = !map_structure_.empty();
+
+	if (!draw_walls) {
+		drawer->Draw(map_image_file_path_, Vector2<float>::zero, DrawLayer::map);
+	}
+
+	if (power_pellet_blink_timer_.Update(elapsed_millis)) {
+		power_pellets_visible_ = !power_pellets_visible_;
+	}
+
+	if (map_width_ == 0 || map_height_ == 0) {
+		return;
+	}
+
+	// Only the tiles that begin inside the window are drawn, so the cost does not grow with the size of the map.
+	const unsigned int last_x = std::min(map_width_ - 1, static_cast<unsigned int>(kWindowWidth - kXOffset) / PacMan::kTileSize);
+	const unsigned int last_y = std::min(map_height_ - 1, static_cast<unsigned int>(kWindowHeight - kYOffset) / PacMan::kTileSize);
+
+	for (unsigned int chunk_y = 0; chunk_y <= last_y / kChunkSize; chunk_y++) {
+		for (unsigned int chunk_x = 0; chunk_x <= last_x / kChunkSize; chunk_x++) {
+			const Chunk* chunk = chunks_[chunk_y * chunk_columns_ + chunk_x];
+
+			if (!chunk) {
+				continue;
+			}
+
+			for (unsigned int y = chunk_y * kChunkSize; y <= std::min(last_y, (chunk_y + 1) * kChunkSize - 1); y++) {
+				for (unsigned int x = chunk_x * kChunkSize; x <= std::min(last_x, (chunk_x + 1) * kChunkSize - 1); x++) {
+					const unsigned char cell = chunk->cells_[GetCellIndex(Vector2<TileCoordinate>(x, y))];
+					const unsigned char items = chunk->items_[GetCellIndex(Vector2<TileCoordinate>(x, y))];
+					const Vector2<float> position(static_cast<float>(x * PacMan::kTileSize + kXOffset),
+					                              static_cast<float>(y * PacMan::kTileSize + kYOffset));
+
+					if (draw_walls) {
+						const int pixel_x = static_cast<int>(position.x_);
+						const int pixel_y = static_cast<int>(position.y_);
+
+						if ((cell & kBlockTypeBits) == static_cast<unsigned char>(Tile::block_type::block)) {
+							drawer->DrawRect({pixel_x, pixel_y, PacMan::kTileSize, PacMan::kTileSize}, kWallColour, DrawLayer::map);
+						} else if ((cell & kBlockTypeBits) == static_cast<unsigned char>(Tile::block_type::partial_block)) {
+							drawer->DrawRect({pixel_x, pixel_y + (PacMan::kTileSize - kGhostDoorHeight) / 2, PacMan::kTileSize,
+								kGhostDoorHeight}, kGhostDoorColour, DrawLayer::map);
+						}
+					}
+
+					if (items & kDotFlag) {
+						drawer->Draw(kDotImageFilePath, position, DrawLayer::items);
+					}
+
+					if ((items & kPowerPelletFlag) && power_pellets_visible_) {
+						drawer->Draw(kPowerPelletImageFilePath, position, DrawLayer::items);
+					}
+				}
+			}
 		}
 	}
+}
 
-	return false;
+bool World::CheckTileValidity(Vector2<TileCoordinate> potential_tile, enum Tile::block_type max_valid_block_type) const {
+	const unsigned char block_type = GetCell(potential_tile) & kBlockTypeBits;
+
+	return block_type != kNoTile && block_type <= static_cast<unsigned char>(max_valid_block_type);
+}
+
+bool World::CheckPortalEntrance(Vector2<TileCoordinate> tile_position) const {
+	return (GetCell(tile_position) >> kPortalShift) != 0;
 }
 
-void World::GetPath(Vector2<unsigned char> from_tile_position, Vector2<unsigned char> to_tile_position, std::list<Tile*>& list) {
-	Tile* from_tile = GetTileAtPosition(from_tile_position);
-	Tile* to_tile = GetTileAtPosition(to_tile_position);
+unsigned char World::GetExitMask(Vector2<TileCoordinate> tile_position, enum Tile::block_type max_valid_block_type) const {
+	const Chunk* chunk = GetChunk(tile_position);
 
-	for (auto tile : tiles_) {
-		tile->visited_flag_ = false;
+	if (!chunk) {
+		return 0;
 	}
 
-	GeneratePath(from_tile, to_tile, list);
+	const unsigned char masks = chunk->exit_masks_[GetCellIndex(tile_position)];
+
+	return max_valid_block_type == Tile::block_type::no_block ? masks & 0xF : masks >> 4;
+}
+
+unsigned int World::GetManhattanDistance(Vector2<TileCoordinate> a, Vector2<TileCoordinate> b) {
+	return static_cast<unsigned int>(std::abs(static_cast<int>(a.x_) - b.x_) + std::abs(static_cast<int>(a.y_) - b.y_));
 }
 
-Tile* World::GetTileAtPosition(Vector2<unsigned char> tile_position) {
-	for (auto tile : tiles_) {
-		if (tile_position == tile->position()) {
-			return tile;
+unsigned char World::GetDirectionBit(Vector2<char> direction) {
+	for (unsigned int code = 0; code < kStepDirections.size(); code++) {
+		if (direction == kStepDirections[code]) {
+			return static_cast<unsigned char>(1 << code);
 		}
 	}
 
-	return NULL;
+	return 0;
 }
 
-bool World::GeneratePath(Tile* from_tile, const Tile* to_tile, std::list<Tile*>& path) {
-	from_tile->visited_flag_ = true;
+bool World::CheckDotIntersection(Vector2<float> position) {
+	ScopedTimer timer(ProfileZone::world_check_dot_intersection);
 
-	// The path has been completed.
-	if (from_tile == to_tile) {
+	if (CollectItem(position, kDotFlag)) {
+		dot_count_--;
 		return true;
 	}
 
-	std::list<Tile*> neighbors;
+	return false;
+}
 
-	/*
-	 * Retrieves the tiles to the immediate up, down, left and right of the current tile, that are eligible
-	 * to become the next tile in the path.
-	 */
-	Tile* up = GetTileAtPosition(GetTileInDirection(from_tile->position(), Vector2<char>::up));
-	if (up && !up->visited_flag_ && up->block_type() != Tile::block_type::block) {
-		neighbors.push_back(up);
+bool World::CheckPowerPelletIntersection(Vector2<float> position) {
+	if (CollectItem(position, kPowerPelletFlag)) {
+		power_pellet_count_--;
+		return true;
+	}
+
+	return false;
+}
+
+bool World::CollectItem(Vector2<float> position, unsigned char item_flag) {
+	if (position.x_ < 0.f || position.y_ < 0.f) {
+		return false;
+	}
+
+	// Items lie on the corners of tiles, a tile apart, so only the item on the nearest corner can be close enough.
+	const unsigned int x = static_cast<unsigned int>(position.x_ / PacMan::kTileSize + .5f);
+	const unsigned int y = static_cast<unsigned int>(position.y_ / PacMan::kTileSize + .5f);
+
+	if (x >= map_width_ || y >= map_height_) {
+		return false;
+	}
+
+	const Vector2<TileCoordinate> tile_position(x, y);
+	Chunk* chunk = GetChunk(tile_position);
+
+	if (!chunk) {
+		return false;
 	}
 
-	Tile* down = GetTileAtPosition(GetTileInDirection(from_tile->position(), Vector2<char>::down));
-	if (down && !down->visited_flag_ && down->block_type() != Tile::block_type::block) {
-		neighbors.push_back(down);
+	// Items are kept apart from the cells, so collecting one never writes what a path search on another thread reads.
+	unsigned char& items = chunk->items_[GetCellIndex(tile_position)];
+	const Vector2<float> item_position = Vector2<float>(static_cast<float>(x), static_cast<float>(y)) *
+		static_cast<float>(PacMan::kTileSize);
+
+	if (!(items & item_flag) || (item_position - position).GetLength() >= kItemCollectionDistance) {
+		return false;
 	}
 
-	Tile* right = GetTileAtPosition(GetTileInDirection(from_tile->position(), Vector2<char>::right));
-	if (right && !right->visited_flag_ && right->block_type() != Tile::block_type::block) {
-		neighbors.push_back(right);
+	items &= ~item_flag;
+	return true;
+}
+
+void World::GetPath(Vector2<TileCoordinate> from_tile_position, Vector2<TileCoordinate> to_tile_position, TilePath& path) {
+	ScopedTimer timer(ProfileZone::world_get_path);
+
+	if (path_cache_.Find(from_tile_position, to_tile_position, kPathBlockType, path)) {
+		return;
 	}
 
-	Tile* left = GetTileAtPosition(GetTileInDirection(from_tile->position(), Vector2<char>::left));
-	if (left && !left->visited_flag_ && left->block_type() != Tile::block_type::block) {
-		neighbors.push_back(left);
+	pathfinder_.FindPath(from_tile_position, to_tile_position, path);
+	path_cache_.Store(from_tile_position, to_tile_position, kPathBlockType, path);
+}
+
+void World::GetDistanceFields(const std::vector<Vector2<TileCoordinate>>& source_tiles,
+	enum Tile::block_type max_valid_block_type, std::vector<DistanceGrid>& grids, ThreadPool* thread_pool) {
+	distance_fields_.Find(source_tiles, max_valid_block_type, grids, thread_pool);
+}
+
+void World::GetFlatPath(Vector2<TileCoordinate> from_tile_position, Vector2<TileCoordinate> to_tile_position,
+	TilePath& path) {
+	path.Reset(from_tile_position);
+	path_frames_.clear();
+
+	// A step onto a portal's entrance always passes through it, so no path ends there.
+	if ((GetCell(from_tile_position) & kBlockTypeBits) == kNoTile || CheckPortalEntrance(to_tile_position)) {
+		return;
 	}
 
-	// Sorts the tiles in order of closest to furthest away from the destination tile.
-	neighbors.sort([to_tile](Tile* a, Tile* b) {
-		short a_x = a->position().x_;
-		short a_y = a->position().y_;
-		short b_x = b->position().x_;
-		short b_y = b->position().y_;
-		short dest_x = to_tile->position().x_;
-		short dest_y = to_tile->position().y_;
+	// Tiles visited by earlier searches are stale once the stamp changes, so none need to be cleared.
+	if (++visit_stamp_ == 0) {
+		for (auto chunk : chunks_) {
+			if (chunk) {
+				chunk->visit_stamp_ = 0;
+			}
+		}
+
+		visit_stamp_ = 1;
+	}
 
-		int la = abs(a_x - dest_x) + abs(a_y - dest_y);
-		int lb = abs(b_x - dest_x) + abs(b_y - dest_y);
+	MarkVisited(from_tile_position);
 
-		return la < lb;
-	});
+	// The path has been completed.
+	if (from_tile_position == to_tile_position) {
+		return;
+	}
 
  /*
-	* Paths are generated by adding the eligible tile closest to the destination, then recursively calling this function.
+	* Paths are generated by adding the eligible tile closest to the destination, then searching on from it.
 	* If a potential path fails (no eligible tiles to add to the path) then the last tile added to the path is removed,
 	* and a path is attempted using the second-closest tile to the destination.
 	* 
+	* The branch being searched is held in path_frames_ rather than on the call stack, so paths through the
+	* largest maps cannot overflow it.
+	*
 	* This algorithm is a heuristic, with solutions guaranteeing all tiles are valid and tiles are not repeated in the path.
 	*/
-	for (auto tile : neighbors) {
-		path.push_back(tile);
+	path_frames_.push_back(CreatePathFrame(from_tile_position, to_tile_position));
+
+	while (!path_frames_.empty()) {
+		PathFrame& frame = path_frames_.back();
 
-		// If true, the path has reached the destination. Returns from all recursive calls of the function and exits.
-		if (GeneratePath(tile, to_tile, path)) {
-			return true;
+		// The current tile cannot be part of the path because all neighbours are invalid.
+		if (frame.next_ == frame.count_) {
+			path_frames_.pop_back();
+			continue;
 		}
 
+		const Vector2<TileCoordinate> tile = GetStepDestination(frame.tile_,
+			kStepDirections[(frame.directions_ >> (frame.next_ * 2)) & 3]);
+
+		frame.next_++;
+		MarkVisited(tile);
+
 		/*
-		 * A path could not be generated for the current neighbour, so revert to the current tile and query the
-		 * next-closest tile.
+		 * The path has reached the destination, so it is stored as the direction each frame stepped in. Steps
+		 * through a portal end far from the tile before them, so they are not found from the tiles' positions.
 		 */
-		path.pop_back();
+		if (tile == to_tile_position) {
+			for (const PathFrame& step_frame : path_frames_) {
+				path.PushBack(kStepDirections[(step_frame.directions_ >> ((step_frame.next_ - 1) * 2)) & 3]);
+			}
+
+			return;
+		}
+
+		path_frames_.push_back(CreatePathFrame(tile, to_tile_position));
 	}
+}
 
-	// The current tile cannot be part of the path because all neighbours are invalid.
-	return false;
+unsigned int World::GetMaxPathLength() const {
+	return open_tile_count_;
+}
+
+World::Chunk* World::GetChunk(Vector2<TileCoordinate> tile_position) const {
+	if (tile_position.x_ >= map_width_ || tile_position.y_ >= map_height_) {
+		return nullptr;
+	}
+
+	return chunks_[(tile_position.y_ / kChunkSize) * chunk_columns_ + tile_position.x_ / kChunkSize];
+}
+
+unsigned int World::GetCellIndex(Vector2<TileCoordinate> tile_position) {
+	return (tile_position.y_ % kChunkSize) * kChunkSize + tile_position.x_ % kChunkSize;
+}
+
+unsigned char World::GetCell(Vector2<TileCoordinate> tile_position) const {
+	const Chunk* chunk = GetChunk(tile_position);
+
+	return chunk ? chunk->cells_[GetCellIndex(tile_position)] : kNoTile;
+}
+
+void World::MarkVisited(Vector2<TileCoordinate> tile_position) {
+	Chunk* chunk = GetChunk(tile_position);
+	const unsigned int index = GetCellIndex(tile_position);
+
+	// The chunk was last visited by an earlier search, so its bits are cleared on first use.
+	if (chunk->visit_stamp_ != visit_stamp_) {
+		std::memset(chunk->visited_, 0, sizeof(chunk->visited_));
+		chunk->visit_stamp_ = visit_stamp_;
+	}
+
+	chunk->visited_[index / 64] |= std::uint64_t(1) << (index % 64);
+}
+
+bool World::CheckVisited(Vector2<TileCoordinate> tile_position) const {
+	const Chunk* chunk = GetChunk(tile_position);
+	const unsigned int index = GetCellIndex(tile_position);
+
+	return chunk->visit_stamp_ == visit_stamp_ && ((chunk->visited_[index / 64] >> (index % 64)) & 1);
+}
+
+World::PathFrame World::CreatePathFrame(Vector2<TileCoordinate> tile_position,
+	Vector2<TileCoordinate> to_tile_position) const {
+	// At most four neighbours, held in a fixed array so each step of the search does not allocate.
+	std::array<unsigned char, 4> neighbors;
+	unsigned int neighbor_count = 0;
+
+	for (unsigned char code = 0; code < kStepDirections.size(); code++) {
+		const Vector2<TileCoordinate> neighbor = GetStepDestination(tile_position, kStepDirections[code]);
+		const unsigned char block_type = GetCell(neighbor) & kBlockTypeBits;
+
+		if (block_type < static_cast<unsigned char>(Tile::block_type::block) && !CheckVisited(neighbor)) {
+			neighbors[neighbor_count++] = code;
+		}
+	}
+
+	// The Manhattan distance from a neighbour to the destination tile.
+	auto distance = [&](unsigned char code) {
+		return GetManhattanDistance(GetStepDestination(tile_position, kStepDirections[code]), to_tile_position);
+	};
+
+	/*
+	 * Sorts the tiles in order of closest to furthest away from the destination tile. An insertion sort keeps
+	 * equally distant tiles in the order they were found, without allocating.
+	 */
+	for (unsigned int i = 1; i < neighbor_count; i++) {
+		for (unsigned int j = i; j > 0 && distance(neighbors[j]) < distance(neighbors[j - 1]); j--) {
+			std::swap(neighbors[j], neighbors[j - 1]);
+		}
+	}
+
+	PathFrame frame;
+	frame.tile_ = tile_position;
+	frame.directions_ = 0;
+	frame.count_ = static_cast<unsigned char>(neighbor_count);
+	frame.next_ = 0;
+
+	for (unsigned int i = 0; i < neighbor_count; i++) {
+		frame.directions_ |= neighbors[i] << (i * 2);
+	}
+
+	return frame;
 }
 
 bool World::CheckDotsRemaining() {
-	return !dots_.empty();
+	return dot_count_ > 0;
+}
+
+unsigned int World::GetRemainingItemCount() const {
+	return dot_count_ + power_pellet_count_;
+}
+
+unsigned int World::map_width() const {
+	return map_width_;
+}
+
+unsigned int World::map_height() const {
+	return map_height_;
+}
+
+PathCache::Metrics World::path_cache_metrics() const {
+	return path_cache_.metrics();
+}
+
+Vector2<TileCoordinate> World::GetTileInDirection(Vector2<TileCoordinate> tile, Vector2<char> direction) {
+	return Vector2<TileCoordinate>(tile.x_ + direction.x_, tile.y_ + direction.y_);
+}
+
+Vector2<TileCoordinate> World::GetStepDestination(Vector2<TileCoordinate> tile_position, Vector2<char> direction) const {
+	const Vector2<TileCoordinate> neighbour = GetTileInDirection(tile_position, direction);
+	// Where the map has no tile, the cell holds kNoTile, which marks no portal.
+	const unsigned int portal = GetCell(neighbour) >> kPortalShift;
+
+	return portal ? GetTileInDirection(portals_[portal - 1].exit_, direction) : neighbour;
 }
 
-Vector2<unsigned char> World::GetTileInDirection(Vector2<unsigned char> tile, Vector2<char> direction) {
-	return Vector2<unsigned char>(tile.x_ + direction.x_, tile.y_ + direction.y_);
+const std::vector<World::Portal>& World::portals() const {
+	return portals_;
 }
\ No newline at end of file
@@ -4,34 +4,97 @@
 
 #pragma once
 
-#include <list>
+#include <vector>
 #include <string>
+#include <array>
+#include <cstdint>
 
 #include "Tile.h"
+#include "Timer.h"
+#include "TileCoordinate.h"
+#include "Vector2.h"
+#include "HierarchicalPathfinder.h"
+#include "DistanceFields.h"
+#include "PathCache.h"
 
-template <typename T> struct Vector2;
 class Drawer;
-class PowerPellet;
-class Dot;
+class LevelArena;
+class TilePath;
+class DistanceGrid;
+class ThreadPool;
 
 /// <summary>
 /// Responsible for handling map generation, testing tile validity for GameEntity movement
 /// and generating paths for Ghosts.
+///
+/// The map is stored in square chunks of tiles, which are only created where the map has tiles. Each tile
+/// of a chunk is a byte holding its block type and portal, alongside a byte of the items lying on it and its
+/// exit mask, so maps of up to kMaxMapDimension tiles along each axis fit in memory. Items are found by
+/// the tile they lie on and only the chunks in view are drawn, so the cost of a frame does not grow with
+/// the size of the map.
 /// </summary>
 class World {
  public:
+	/// <summary>
+	/// The greatest number of portals in a map. Portals are numbered from 1, and the exit of each is marked by
+	/// the letter at the same place in the alphabet, up to G, as H marks the Ghosts' home tile.
+	/// </summary>
+	static const unsigned int kMaxPortalCount = 7;
+	/// <summary>
+	/// A pair of tiles that joins distant parts of the map, such as the tunnels on either side of it.
+	/// A step onto the entrance arrives on the tile past the exit in the same direction, as if the step had
+	/// come out of the exit. The entrance itself is never occupied.
+	/// </summary>
+	struct Portal {
+		/// <summary>
+		/// The tile marked with the portal's number in the structure.
+		/// </summary>
+		Vector2<TileCoordinate> entrance_;
+		/// <summary>
+		/// The tile marked with the portal's letter in the structure.
+		/// </summary>
+		Vector2<TileCoordinate> exit_;
+	};
 	/// <summary>
 	/// Constructor for the World class.
 	/// </summary>
-	World::World(void);
+	World(void);
+	/// <summary>
+	/// Initialises the map's walls, items and portals.
+	/// The chunks of tiles and the path cache's steps are created in the level arena, and live until it is released.
+	/// Throws std::runtime_error if the map is larger than kMaxMapDimension tiles along either axis, or a
+	/// portal's number is marked more than once or without its letter.
+	/// May be called again once the arena has been released, to load the level from the start.
+	/// </summary>
+	/// <param name="arena">The arena that the level's objects are created in.</param>
+	void Init(LevelArena& arena);
 	/// <summary>
-	/// Initialises the map's walls and creates static GameEntities.
+	/// Sets the map's structure to load in place of the structure file, such as a maze from MazeGenerator.
+	/// The map image only matches the structure file, so the walls of the structure are drawn instead.
+	/// Takes effect when Init is next called.
 	/// </summary>
-	void Init(void);
-	static Vector2<unsigned char> GetTileInDirection(Vector2<unsigned char> tile, Vector2<char> direction);
+	/// <param name="map_structure">The rows of the map in the format of the structure file, or empty to
+	/// load the structure file.</param>
+	void set_map_structure(const std::string& map_structure);
+	static Vector2<TileCoordinate> GetTileInDirection(Vector2<TileCoordinate> tile, Vector2<char> direction);
+	/// <summary>
+	/// Gets the tile that a step from a tile arrives on, which is the neighbouring tile in the direction of the
+	/// step, unless the step is onto the entrance of a portal. The entrance is found from the tile in a single
+	/// lookup, however many portals the map has.
+	/// </summary>
+	/// <param name="tile_position">The map coordinates of the tile that the step starts from.</param>
+	/// <param name="direction">The direction of the step.</param>
+	/// <returns>The tile past the portal's exit if the step is onto the entrance of a portal, else the
+	/// neighbouring tile.</returns>
+	Vector2<TileCoordinate> GetStepDestination(Vector2<TileCoordinate> tile_position, Vector2<char> direction) const;
+	/// <summary>
+	/// Gets the portals of the map, in the order of their numbers.
+	/// </summary>
+	/// <returns>The portals.</returns>
+	const std::vector<Portal>& portals(void) const;
 	/// <summary>
 	/// Handles the addition of World images to the drawing buffer.
-	/// Includes the map image and StaticEntities.
+	/// Includes the map image, or the walls in view when the structure was set, and the Dots and PowerPellets in view.
 	/// </summary>
 	/// <param name="drawer">Adds the images to the drawing buffer.</param>
 	/// <param name="elapsed_millis">The amount of time in milliseconds since the previous
@@ -43,7 +106,44 @@ class World {
 	/// <param name="tile_position">The position of the tile to inspect in map coordinates.</param>
 	/// <param name="max_valid_block_type">The most blocking tile type that is still considered valid in the given context.</param>
 	/// <returns>True if a tile is not a blocking tile, else false.</returns>
-	bool CheckTileValidity(Vector2<unsigned char> tile_position, enum Tile::block_type max_valid_block_type) const;
+	bool CheckTileValidity(Vector2<TileCoordinate> tile_position, enum Tile::block_type max_valid_block_type) const;
+	/// <summary>
+	/// Determines whether a tile is a portal's entrance, which every step onto passes through, so it is never
+	/// the end of a path.
+	/// </summary>
+	/// <param name="tile_position">The position of the tile to inspect in map coordinates.</param>
+	/// <returns>True if the tile is a portal's entrance, else false.</returns>
+	bool CheckPortalEntrance(Vector2<TileCoordinate> tile_position) const;
+	/// <summary>
+	/// Gets the directions in which a tile can be left, as a mask of direction bits.
+	/// The masks are precomputed for every tile when the map is loaded, so this is a single lookup. An exit onto
+	/// the entrance of a portal is valid if the tile past its exit can be moved onto.
+	/// </summary>
+	/// <param name="tile_position">The position of the tile to inspect in map coordinates.</param>
+	/// <param name="max_valid_block_type">The most blocking tile type that can still be moved onto. partial_block
+	/// includes the exits through Ghost doors, and block is treated the same as partial_block.</param>
+	/// <returns>The direction bits of the valid exits, or zero if the position is outside the map.</returns>
+	unsigned char GetExitMask(Vector2<TileCoordinate> tile_position, enum Tile::block_type max_valid_block_type) const;
+	/// <summary>
+	/// The direction of each 2-bit step code: up, down, left and right. Paths pack their steps as these codes,
+	/// and the exit mask bit of each direction is 1 shifted left by its code.
+	/// </summary>
+	static const std::array<Vector2<char>, 4> kStepDirections;
+	/// <summary>
+	/// Gets the Manhattan distance between two tiles, which estimates the length of a path between them. Only
+	/// paths through portals are shorter.
+	/// </summary>
+	/// <param name="a">The first tile.</param>
+	/// <param name="b">The second tile.</param>
+	/// <returns>The distance in tiles.</returns>
+	static unsigned int GetManhattanDistance(Vector2<TileCoordinate> a, Vector2<TileCoordinate> b);
+	/// <summary>
+	/// Gets the bit that represents a direction in an exit mask: 1 for up, 2 for down, 4 for left and 8 for right,
+	/// which is 1 shifted left by the direction's step code.
+	/// </summary>
+	/// <param name="direction">The direction.</param>
+	/// <returns>The bit of the direction, or zero if it is not up, down, left or right.</returns>
+	static unsigned char GetDirectionBit(Vector2<char> direction);
 	/// <summary>
 	/// Determines whether a Dot is located at the given position.
 	/// Used to determine whether the Avatar has collected a Dot.
@@ -59,54 +159,263 @@ class World {
 	/// <returns>True if a Dot is present at the location, else false.</returns>
 	bool CheckPowerPelletIntersection(Vector2<float> position);
 	/// <summary>
-	/// Wrapper function that generates a path from from_tile to to_tile,
-	/// storing the result in the given list.
+	/// Wrapper function that generates a path from from_tile to to_tile, storing its steps in the given path.
+	/// The path is found by the hierarchical pathfinder, so its cost grows with the distance it covers
+	/// rather than the size of the map. Paths step through portals where that is shorter. The path is left
+	/// empty if the destination cannot be reached. Recently found paths are kept in the path cache, so a path
+	/// asked for again is copied rather than searched for.
 	/// </summary>
 	/// <param name="from_tile_coordinates">The coordinates of the starting tile of the path.</param>
 	/// <param name="to_tile_coordinates">The coordinates of the destination tile of the path.</param>
-	/// <param name="list">The list that the path is inserted into.</param>
-	void GetPath(Vector2<unsigned char> from_tile_coordinates, Vector2<unsigned char> to_tile_coordinates,
-		std::list<Tile*>& list);
+	/// <param name="path">The path that the steps are stored in, replacing any previous steps.</param>
+	void GetPath(Vector2<TileCoordinate> from_tile_coordinates, Vector2<TileCoordinate> to_tile_coordinates,
+		TilePath& path);
+	/// <summary>
+	/// Generates a path by a depth-first search over the tiles, which tries the neighbour closest to the
+	/// destination first. Paths are not the shortest, and the search may visit every tile of the map.
+	/// Kept as the flat search that the hierarchical pathfinder is measured against.
+	/// </summary>
+	/// <param name="from_tile_coordinates">The coordinates of the starting tile of the path.</param>
+	/// <param name="to_tile_coordinates">The coordinates of the destination tile of the path.</param>
+	/// <param name="path">The path that the steps are stored in, replacing any previous steps.</param>
+	void GetFlatPath(Vector2<TileCoordinate> from_tile_coordinates, Vector2<TileCoordinate> to_tile_coordinates,
+		TilePath& path);
+	/// <summary>
+	/// Finds the number of steps from each of a set of tiles to every tile of the map, such as from the Ghosts'
+	/// home tile, the exits of their base and the Avatar. Steps through portals are followed. The searches expand
+	/// the bitsets of many tiles at once, and are shared out between the workers of the thread pool if one is given.
+	/// </summary>
+	/// <param name="source_tiles">The coordinates of the tiles to find the distances from.</param>
+	/// <param name="max_valid_block_type">The most blocking tile type that can still be moved onto, as for GetExitMask.</param>
+	/// <param name="grids">Resized to one grid of distances for each source tile, in the same order. Grids kept
+	/// from an earlier call are refilled without allocating.</param>
+	/// <param name="thread_pool">The workers to share the searches between, or null to search on the calling thread.</param>
+	void GetDistanceFields(const std::vector<Vector2<TileCoordinate>>& source_tiles,
+		enum Tile::block_type max_valid_block_type, std::vector<DistanceGrid>& grids, ThreadPool* thread_pool = nullptr);
+	/// <summary>
+	/// Changes the block type of a tile, such as to open or close a passage. The exit masks of the tile's
+	/// neighbours and of the tiles that step onto it through portals, the clusters of the hierarchical
+	/// pathfinder around it and its bits in the distance fields are updated, and the path cache is cleared.
+	/// Items on the tile are kept. Paths that were generated before the change are not.
+	/// </summary>
+	/// <param name="tile_position">The map coordinates of the tile. Positions where the map has no tile are ignored.</param>
+	/// <param name="block_type">The new block type of the tile.</param>
+	void SetBlockType(Vector2<TileCoordinate> tile_position, enum Tile::block_type block_type);
+	/// <summary>
+	/// Gets the greatest number of steps in any path, which is the number of tiles that are not walls,
+	/// as a path never visits a tile twice.
+	/// </summary>
+	/// <returns>The greatest number of steps in a path.</returns>
+	unsigned int GetMaxPathLength(void) const;
 	/// <summary>
 	/// Determines whether Dots are present in the game.
 	/// </summary>
 	/// <returns>True if at least one Dot exists on the map, else false.</returns>
 	bool CheckDotsRemaining(void);
+	/// <summary>
+	/// Gets the number of Dots and PowerPellets that have not been eaten.
+	/// </summary>
+	/// <returns>The number of remaining Dots and PowerPellets.</returns>
+	unsigned int GetRemainingItemCount(void) const;
+	/// <summary>
+	/// Gets the number of tiles in the longest row of the map.
+	/// </summary>
+	/// <returns>The width of the map in tiles.</returns>
+	unsigned int map_width(void) const;
+	/// <summary>
+	/// Gets the number of rows in the map.
+	/// </summary>
+	/// <returns>The height of the map in tiles.</returns>
+	unsigned int map_height(void) const;
+	/// <summary>
+	/// Gets the counts of how the paths of GetPath have been found in the path cache since the map was loaded.
+	/// </summary>
+	/// <returns>The hit, miss and eviction counts of the path cache.</returns>
+	PathCache::Metrics path_cache_metrics(void) const;
 
  private:
 	/// <summary>
-	/// Gets the tile located at the map coordinate tile_position.
+	/// The number of tiles along each side of a chunk.
+	/// </summary>
+	static const unsigned int kChunkSize = 64;
+	/// <summary>
+	/// The number of tiles in a chunk.
+	/// </summary>
+	static const unsigned int kChunkArea = kChunkSize * kChunkSize;
+	/// <summary>
+	/// A square of tiles of the map.
+	/// </summary>
+	struct Chunk {
+		/// <summary>
+		/// The contents of each tile, row by row: its block type in the low two bits, or kNoTile where the
+		/// map has no tile, and above them the portal whose entrance is on it.
+		/// </summary>
+		unsigned char cells_[kChunkArea];
+		/// <summary>
+		/// The flags of the item lying on each tile, row by row. They are apart from the cells, which paths are
+		/// found through, as items are collected while the Ghosts' paths are planned on another thread.
+		/// </summary>
+		unsigned char items_[kChunkArea];
+		/// <summary>
+		/// The exit masks of each tile, row by row. The low four bits of each hold the exits onto tiles that
+		/// are not blocking, and the high four bits the exits onto tiles that are at most partially blocking.
+		/// </summary>
+		unsigned char exit_masks_[kChunkArea];
+		/// <summary>
+		/// The path search that visited_ was last written by. The bits are stale for any other search.
+		/// </summary>
+		unsigned int visit_stamp_;
+		/// <summary>
+		/// One bit for each tile, set once the tile has been visited by the path search.
+		/// </summary>
+		std::uint64_t visited_[kChunkArea / 64];
+	};
+	/// <summary>
+	/// A tile on the current branch of the path search, with the neighbours that are still to be tried from it.
+	/// </summary>
+	struct PathFrame {
+		/// <summary>
+		/// The position of the tile.
+		/// </summary>
+		Vector2<TileCoordinate> tile_;
+		/// <summary>
+		/// The 2-bit step codes of the directions of the neighbours to try, closest to the destination first.
+		/// </summary>
+		unsigned char directions_;
+		/// <summary>
+		/// The number of neighbours to try.
+		/// </summary>
+		unsigned char count_;
+		/// <summary>
+		/// The index of the next neighbour to try.
+		/// </summary>
+		unsigned char next_;
+	};
+	/// <summary>
+	/// Gets the chunk that holds a tile.
+	/// </summary>
+	/// <param name="tile_position">The map coordinates of the tile.</param>
+	/// <returns>The chunk, or null if the position is outside the map or the chunk has no tiles.</returns>
+	Chunk* GetChunk(Vector2<TileCoordinate> tile_position) const;
+	/// <summary>
+	/// Gets the index of a tile within its chunk.
+	/// </summary>
+	/// <param name="tile_position">The map coordinates of the tile.</param>
+	/// <returns>The index of the tile in the arrays of its chunk.</returns>
+	static unsigned int GetCellIndex(Vector2<TileCoordinate> tile_position);
+	/// <summary>
+	/// Gets the contents of the tile located at the map coordinate tile_position.
 	/// </summary>
 	/// <param name="tile_position">The map coordinates of the desired tile.</param>
-	/// <returns>The tile instance at the specified position.</returns>
-	Tile* GetTileAtPosition(Vector2<unsigned char> tile_position);
+	/// <returns>The block type and item flags of the tile, or kNoTile if the map has no tile there.</returns>
+	unsigned char GetCell(Vector2<TileCoordinate> tile_position) const;
+	/// <summary>
+	/// Removes an item if it lies close enough to a position to be collected.
+	/// </summary>
+	/// <param name="position">The position to search for the item, in pixels.</param>
+	/// <param name="item_flag">The flag of the item to search for.</param>
+	/// <returns>True if an item was removed, else false.</returns>
+	bool CollectItem(Vector2<float> position, unsigned char item_flag);
+	/// <summary>
+	/// Marks a tile as visited by the current path search.
+	/// </summary>
+	/// <param name="tile_position">The map coordinates of the tile, which must be in the map.</param>
+	void MarkVisited(Vector2<TileCoordinate> tile_position);
+	/// <summary>
+	/// Determines whether a tile has been visited by the current path search.
+	/// </summary>
+	/// <param name="tile_position">The map coordinates of the tile, which must be in the map.</param>
+	/// <returns>True if the tile has been visited, else false.</returns>
+	bool CheckVisited(Vector2<TileCoordinate> tile_position) const;
 	/// <summary>
-	/// Recursively generates a path from from_tile to to_tile, storing the result in the supplied list.
-	/// Heuristic depth-first traversal algorithm.
+	/// Creates the frame of the path search for a tile, finding the tiles to the immediate up, down, right and
+	/// left of it that are eligible to become the next tile in the path, closest to the destination first.
 	/// </summary>
-	/// <param name="from_tile">The source tile for the path.</param>
-	/// <param name="to_tile">The destination tile for the path.</param>
-	/// <param name="path">The generated path.</param>
-	/// <returns>True if from_tile is equal to to_tile, else false.</returns>
-	bool GeneratePath(Tile* from_tile, const Tile* to_tile, std::list<Tile*>& path);
+	/// <param name="tile_position">The map coordinates of the tile.</param>
+	/// <param name="to_tile_position">The map coordinates of the destination tile of the path.</param>
+	/// <returns>The frame of the tile.</returns>
+	PathFrame CreatePathFrame(Vector2<TileCoordinate> tile_position, Vector2<TileCoordinate> to_tile_position) const;
+	/// <summary>
+	/// Computes the exit masks of every tile in the map, once the tiles have been created.
+	/// </summary>
+	void GenerateExitMasks(void);
+	/// <summary>
+	/// Computes the exit masks of a tile from the block types of its neighbours.
+	/// </summary>
+	/// <param name="tile_position">The map coordinates of the tile. Positions outside the map's chunks are ignored.</param>
+	void UpdateExitMask(Vector2<TileCoordinate> tile_position);
 	/// <summary>
 	/// The path of the file that stores the map's structure.
 	/// </summary>
 	std::string map_structure_file_path_;
 	/// <summary>
+	/// The map's structure, loaded in place of the structure file. Empty if the structure file is loaded.
+	/// </summary>
+	std::string map_structure_;
+	/// <summary>
 	/// The path of the file that stores the map's image.
 	/// </summary>
 	std::string map_image_file_path_;
 	/// <summary>
-	/// The collection of tiles that compose the map.
+	/// The chunks that compose the map, row by row. The chunks are owned by the level arena, and are null
+	/// where the map has no tiles.
+	/// </summary>
+	std::vector<Chunk*> chunks_;
+	/// <summary>
+	/// The number of chunks in each row of chunks_.
+	/// </summary>
+	unsigned int chunk_columns_;
+	/// <summary>
+	/// The current branch of the path search, from the starting tile. Reserved for the longest path when
+	/// the map is loaded.
+	/// </summary>
+	std::vector<PathFrame> path_frames_;
+	/// <summary>
+	/// Finds the paths of GetPath over clusters of tiles. Built when the map is loaded.
+	/// </summary>
+	HierarchicalPathfinder pathfinder_;
+	/// <summary>
+	/// Finds the distances of GetDistanceFields over bitsets of the open tiles. Built when the map is loaded.
+	/// </summary>
+	DistanceFields distance_fields_;
+	/// <summary>
+	/// Keeps the most recently found paths of GetPath. Reserved when the map is loaded.
+	/// </summary>
+	PathCache path_cache_;
+	/// <summary>
+	/// The stamp of the current path search. Incremented by every search, so visited tiles need not be cleared.
+	/// </summary>
+	unsigned int visit_stamp_;
+	/// <summary>
+	/// The portals of the map, in the order of their numbers. The cell of each entrance holds its index plus one.
+	/// </summary>
+	std::vector<Portal> portals_;
+	/// <summary>
+	/// The number of tiles that are not walls.
+	/// </summary>
+	unsigned int open_tile_count_;
+	/// <summary>
+	/// The number of tiles in the longest row of the map.
+	/// </summary>
+	unsigned int map_width_;
+	/// <summary>
+	/// The number of rows in the map.
+	/// </summary>
+	unsigned int map_height_;
+	/// <summary>
+	/// The number of Dots that have not been eaten.
+	/// </summary>
+	unsigned int dot_count_;
+	/// <summary>
+	/// The number of PowerPellets that have not been eaten.
 	/// </summary>
-	std::list<Tile*> tiles_;
+	unsigned int power_pellet_count_;
 	/// <summary>
-	/// The collection of Dot entities in the world.
+	/// Handles the timing of the PowerPellets' blinking visual effect.
 	/// </summary>
-	std::list<Dot*> dots_;
+	Timer power_pellet_blink_timer_;
 	/// <summary>
-	/// The collection of PowerPellet entities in the world.
+	/// Determines whether PowerPellets will be drawn. They are drawn when it is set to true.
 	/// </summary>
-	std::list<PowerPellet*> power_pellets_;
+	bool power_pellets_visible_;
 };
\ No newline at end of file